@@ -0,0 +1,146 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Logs output benchmark for POSIX platform.
+ * Created on: 2026-10-19
+ */
+
+#define LOG_TAG    "bench"
+
+#include <elog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef ELOG_FILE_ENABLE
+#include <elog_file.h>
+#endif
+
+/* log lines for every thread */
+static size_t bench_lines = 100000;
+/* benchmark thread number */
+static size_t bench_threads = 1;
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n lines] [-t threads] [-f file] [-q]\n"
+            "  -n  log lines for every thread, default is %zu\n"
+            "  -t  benchmark thread number, default is %zu\n"
+            "  -f  file log plugin's using file name\n"
+            "  -q  quiet, drop the terminal output\n", name, bench_lines, bench_threads);
+}
+
+/**
+ * get current monotonic time
+ *
+ * @return time in nanosecond
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void *bench_thread(void *arg) {
+    size_t i;
+
+    for (i = 0; i < bench_lines; i++) {
+        log_i("benchmark line %zu from worker %zu, some payload to make it a typical line", i, (size_t) arg);
+    }
+
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    pthread_t *threads;
+    uint64_t start, produced, drained;
+    size_t i, total;
+    bool quiet = false;
+    const char *file_name = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:f:qh")) != -1) {
+        switch (opt) {
+        case 'n': bench_lines = strtoul(optarg, NULL, 0); break;
+        case 't': bench_threads = strtoul(optarg, NULL, 0); break;
+        case 'f': file_name = optarg; break;
+        case 'q': quiet = true; break;
+        default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (bench_threads == 0) {
+        bench_threads = 1;
+    }
+    if (quiet && freopen("/dev/null", "w", stdout) == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    elog_init();
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_T_INFO);
+#ifdef ELOG_FILE_ENABLE
+    if (file_name) {
+        ElogFileCfg cfg = { (char *) file_name, ELOG_FILE_MAX_SIZE, ELOG_FILE_MAX_ROTATE, ELOG_FILE_ROTATE_PERIOD,
+                ELOG_FILE_ROTATE_SUFFIX, ELOG_FILE_MAX_TOTAL_SIZE, ELOG_FILE_COMPRESS_STREAM };
+        elog_file_config(&cfg);
+    }
+#else
+    (void) file_name;
+#endif
+    elog_start();
+
+    threads = calloc(bench_threads, sizeof(pthread_t));
+    if (threads == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    start = now_ns();
+    for (i = 0; i < bench_threads; i++) {
+        pthread_create(&threads[i], NULL, bench_thread, (void *) i);
+    }
+    for (i = 0; i < bench_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    produced = now_ns();
+    /* deinitialize will drain all asynchronous logs */
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    elog_flush();
+#endif
+    elog_deinit();
+    drained = now_ns();
+
+    total = bench_lines * bench_threads;
+    fprintf(stderr, "lines: %zu, threads: %zu\n", total, bench_threads);
+    fprintf(stderr, "produce: %.3f ms, %.1f ns/line, %.0f lines/s\n", (produced - start) / 1e6,
+            (double) (produced - start) / total, total / ((produced - start) / 1e9));
+    fprintf(stderr, "total  : %.3f ms, %.1f ns/line, %.0f lines/s\n", (drained - start) / 1e6,
+            (double) (drained - start) / total, total / ((drained - start) / 1e9));
+
+    free(threads);
+
+    return EXIT_SUCCESS;
+}
@@ -109,6 +109,15 @@ const char *elog_port_get_t_info(void) {
     return "";
 }
 
+/**
+ * get current millisecond tick interface, it's used by rate limit, duplicate log suppression and log_every_ms_x API
+ *
+ * @return monotonic tick in millisecond
+ */
+uint32_t elog_port_get_tick(void) {
+    return (uint32_t) ((uint64_t) osKernelGetTickCount() * 1000 / osKernelGetTickFreq());
+}
+
 void elog_async_output_notice(void) {
     osSemaphoreRelease(elog_asyncHandle);
 }
@@ -38,4 +38,7 @@
 /* EasyLogger file log plugin's using max rotate file count */
 #define ELOG_FILE_MAX_ROTATE 5
 
+/* EasyLogger file log plugin's cached file size sync interval (second), 0: only sync after the file is opened */
+#define ELOG_FILE_SIZE_SYNC_INTERVAL 1
+
 #endif /* _ELOG_FILE_CFG_H_ */
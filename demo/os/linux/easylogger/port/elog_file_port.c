@@ -27,35 +27,40 @@
  */
 
 #include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/file.h>
 #include <fcntl.h>
-#include <sys/ipc.h>
-#include <sys/sem.h>
 
 #include <unistd.h>
 
 #include <elog_file.h>
 #include <elog_file_cfg.h>
 
-#define ELOG_FILE_SEM_KEY   ((key_t)0x19910612)
-#ifdef _SEM_SEMUN_UNDEFINED
-union semun {
-    int              val;    /* Value for SETVAL */
-    struct semid_ds *buf;    /* Buffer for IPC_STAT, IPC_SET */
-    unsigned short  *array;  /* Array for GETALL, SETALL */
-    struct seminfo  *__buf;  /* Buffer for IPC_INFO
-                                (Linux-specific) */
-};
-#endif
-
-static int semid = -1;
-static struct sembuf const up = {0, 1, SEM_UNDO};
-static struct sembuf const down = {0, -1, SEM_UNDO};
-
-static void lock_init(void);
-static int lock_open(void);
-static void lock_deinit(void);
+/* the lock is shared by the processes which are using the same log file */
+#define ELOG_FILE_LOCK_PATH_FMT   "/dev/shm/elog_file_lock.%08x"
+/* it's set after the mutex is initialized, the segment which has other value is initialized again */
+#define ELOG_FILE_LOCK_MAGIC      (0x454C4B00U + (uint32_t) sizeof(FileLock))
+
+/* file lock in shared memory */
+typedef struct {
+    volatile uint32_t magic;
+    pthread_mutex_t mutex;
+} FileLock;
+
+/* the threads in this process are locked by it, so the shared lock can be changed when it's locked */
+static pthread_mutex_t local_lock = PTHREAD_MUTEX_INITIALIZER;
+static FileLock *file_lock = NULL;
+/* the hash of the locked log file name */
+static uint32_t file_lock_hash;
+
+static uint32_t name_hash(const char *name);
+static FileLock *lock_open(uint32_t hash);
+static void lock_close(FileLock *lock);
 
 /**
  * EasyLogger flile log pulgin port initialize
@@ -65,7 +70,12 @@ static void lock_deinit(void);
 ElogErrCode elog_file_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
 
-    lock_init();
+    /* the default log file's lock, it's changed when the file plugin is configured by other file name */
+    if (file_lock == NULL) {
+        file_lock_hash = name_hash(ELOG_FILE_NAME);
+        if ((file_lock = lock_open(file_lock_hash)) == NULL)
+            result = ELOG_PORT_ERR;
+    }
 
     return result;
 }
@@ -75,7 +85,14 @@ ElogErrCode elog_file_port_init(void) {
  */
 inline void elog_file_port_lock(void)
 {
-    semid == -1 ? -1 : semop(semid, (struct sembuf *)&down, 1);
+    pthread_mutex_lock(&local_lock);
+
+    if (unlikely(file_lock == NULL))
+        return;
+
+    /* the holder process is crashed, every log is written by one write, so the file is still consistent */
+    if (unlikely(pthread_mutex_lock(&file_lock->mutex) == EOWNERDEAD))
+        pthread_mutex_consistent(&file_lock->mutex);
 }
 
 /**
@@ -83,89 +100,125 @@ inline void elog_file_port_lock(void)
  */
 inline void elog_file_port_unlock(void)
 {
-    semid == -1 ? -1 : semop(semid, (struct sembuf *)&up, 1);
+    if (likely(file_lock != NULL))
+        pthread_mutex_unlock(&file_lock->mutex);
+
+    pthread_mutex_unlock(&local_lock);
 }
 
 /**
- * file log deinit
+ * The file plugin is configured by new file name, it's locked.
+ * The shared lock is changed to the new file's lock.
+ *
+ * @param name new log file name
+ *
+ * @return result
  */
-void elog_file_port_deinit(void)
+ElogErrCode elog_file_port_config(const char *name)
 {
-    lock_deinit();
+    uint32_t hash = name_hash(name);
+    FileLock *lock;
+
+    if (file_lock != NULL && hash == file_lock_hash)
+        return ELOG_NO_ERR;
+    if ((lock = lock_open(hash)) == NULL)
+        return ELOG_PORT_ERR;
+
+    if (file_lock != NULL) {
+        pthread_mutex_unlock(&file_lock->mutex);
+        lock_close(file_lock);
+    }
+    if (pthread_mutex_lock(&lock->mutex) == EOWNERDEAD)
+        pthread_mutex_consistent(&lock->mutex);
+    file_lock = lock;
+    file_lock_hash = hash;
+
+    return ELOG_NO_ERR;
 }
 
 /**
- * initialize the lock 
+ * file log deinit
  */
-static void lock_init(void)
+void elog_file_port_deinit(void)
 {
-    int id, rc;
-    union semun arg;
-    struct sembuf sembuf;
-
-    id = semget(ELOG_FILE_SEM_KEY, 1, IPC_CREAT | IPC_EXCL | 0666);
-    if(likely(id == -1)) {
-        id = lock_open();
-        if (id == -1)
-            goto __exit;
-    } else {
-        arg.val = 0;
-        rc = semctl(id, 0, SETVAL, arg);
-        if (rc == -1)
-            goto __exit;
-
-        sembuf.sem_num = 0;
-        sembuf.sem_op = 1;
-        sembuf.sem_flg = 0;
-
-        rc = semop(id, &sembuf, 1);
-        if (rc == -1)
-            goto __exit;
+    if (file_lock != NULL) {
+        lock_close(file_lock);
+        file_lock = NULL;
     }
-
-    semid = id;
-__exit:
-    return ;
 }
 
 /**
- * gets the lock 
+ * FNV-1a hash of log file name
  */
-static int lock_open(void)
+static uint32_t name_hash(const char *name)
 {
-    int id, rc, i;
-    union semun arg;
-    struct semid_ds ds;
+    uint32_t hash = 2166136261U;
 
-    id = semget(ELOG_FILE_SEM_KEY, 1, 0666);
-    if(unlikely(id == -1))
-        goto err;
-
-    arg.buf = &ds;
+    for (; *name; name++) {
+        hash = (hash ^ (uint8_t) *name) * 16777619U;
+    }
 
-    for (i = 0; i < 10; i++) {
-        rc = semctl(id, 0, IPC_STAT, arg);
-        if (unlikely(rc == -1))
-            goto err;
+    return hash;
+}
 
-        if(ds.sem_otime != 0)
-            break;
+/**
+ * Open the lock, the shared memory name is the hash of log file path.
+ * The segment is initialized under flock, so the segment which is left by a crashed creator is
+ * initialized again by next process.
+ *
+ * @param hash log file name hash
+ *
+ * @return the lock, NULL: failed
+ */
+static FileLock *lock_open(uint32_t hash)
+{
+    char path[64];
+    pthread_mutexattr_t attr;
+    FileLock *lock = NULL;
+    struct stat st;
+    int fd;
+
+    snprintf(path, sizeof(path), ELOG_FILE_LOCK_PATH_FMT, hash);
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (fd == -1)
+        return NULL;
+    if (flock(fd, LOCK_EX) == -1 || fstat(fd, &st) == -1)
+        goto __close;
+
+    if ((size_t) st.st_size < sizeof(FileLock)) {
+        /* it's created by this process, or the creator is crashed before it's truncated */
+        fchmod(fd, 0666);
+        if (ftruncate(fd, sizeof(FileLock)) == -1)
+            goto __unlock;
+    }
+    lock = mmap(NULL, sizeof(FileLock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (lock == MAP_FAILED) {
+        lock = NULL;
+        goto __unlock;
+    }
 
-        usleep(10 * 1000);
+    if (lock->magic != ELOG_FILE_LOCK_MAGIC) {
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&lock->mutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+        lock->magic = ELOG_FILE_LOCK_MAGIC;
     }
 
-    if (unlikely(ds.sem_otime == 0))
-        goto err;
+__unlock:
+    flock(fd, LOCK_UN);
+__close:
+    close(fd);
 
-    return id;
-err:
-    return -1;
+    return lock;
 }
 
 /**
- * deinitialize the lock 
+ * close the lock, the shared memory is kept for other processes
  */
-static void lock_deinit(void)
+static void lock_close(FileLock *lock)
 {
-    semid = -1;
+    munmap(lock, sizeof(FileLock));
 }
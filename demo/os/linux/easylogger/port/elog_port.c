@@ -33,11 +33,30 @@
 #include <time.h>
 #include <sys/syscall.h>
 
+#ifdef ELOG_BLACKBOX_ENABLE
+#include <string.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #ifdef ELOG_FILE_ENABLE
 #include <elog_file.h>
 #endif
 static pthread_mutex_t output_lock;
 
+#ifdef ELOG_FILE_ENABLE
+/* file sink, the slow file writing is not blocking the terminal output */
+static ElogSink file_sink;
+/* the sink's ring buffer isn't placed in black box, so the file is written synchronously with black box */
+#if defined(ELOG_ASYNC_OUTPUT_USING_PTHREAD) && !defined(ELOG_BLACKBOX_ENABLE)
+#define ELOG_FILE_SINK_ASYNC
+/* file sink's asynchronous output ring buffer */
+static char file_sink_buf[ELOG_ASYNC_OUTPUT_BUF_SIZE];
+#endif
+#endif
+
 /**
  * EasyLogger port initialize
  *
@@ -49,7 +68,19 @@ ElogErrCode elog_port_init(void) {
     pthread_mutex_init(&output_lock, NULL);
 
 #ifdef ELOG_FILE_ENABLE
-    elog_file_init();
+    result = elog_file_init();
+    if (result != ELOG_NO_ERR)
+        return result;
+    /* the file has no text color */
+    elog_sink_init(&file_sink, "file", elog_file_write);
+#ifdef ELOG_FILE_SINK_ASYNC
+    elog_sink_set_async(&file_sink, file_sink_buf, sizeof(file_sink_buf), NULL);
+#endif
+    result = elog_sink_register(&file_sink);
+#ifdef ELOG_FILE_DURABLE_ENABLE
+    /* the durability ticket covers the log which is queued in file sink */
+    elog_file_set_durable_sink(&file_sink);
+#endif
 #endif
 
     return result;
@@ -61,6 +92,11 @@ ElogErrCode elog_port_init(void) {
  */
 void elog_port_deinit(void) {
 #ifdef ELOG_FILE_ENABLE
+    /* the remaining log in file sink will be written before deinitialize */
+#ifdef ELOG_FILE_DURABLE_ENABLE
+    elog_file_set_durable_sink(NULL);
+#endif
+    elog_sink_unregister(&file_sink);
     elog_file_deinit();
 #endif
 
@@ -75,15 +111,10 @@ void elog_port_deinit(void) {
  * @param size log size
  */
 void elog_port_output(const char *log, size_t size) {
-    /* output to terminal */
+    /* output to terminal, the file is written by file sink */
 #ifdef ELOG_TERMINAL_ENABLE
     printf("%.*s", (int)size, log);
 #endif
-
-#ifdef ELOG_FILE_ENABLE
-    /* write the file */
-    elog_file_write(log, size);
-#endif 
 }
 
 /**
@@ -93,6 +124,17 @@ void elog_port_output_lock(void) {
     pthread_mutex_lock(&output_lock);
 }
 
+#ifdef ELOG_EMERGENCY_ENABLE
+/**
+ * try to lock output, it's used by emergency flush in signal handler
+ *
+ * @return true: locked, false: the output lock is held by others
+ */
+bool elog_port_output_trylock(void) {
+    return pthread_mutex_trylock(&output_lock) == 0;
+}
+#endif
+
 /**
  * output unlock
  */
@@ -141,7 +183,70 @@ const char *elog_port_get_p_info(void) {
 const char *elog_port_get_t_info(void) {
     static char cur_thread_info[10] = { 0 };
 
-    snprintf(cur_thread_info, 10, "tid:%04d", syscall(SYS_gettid));
+    snprintf(cur_thread_info, 10, "tid:%04d", (int) syscall(SYS_gettid));
 
     return cur_thread_info;
 }
+
+/**
+ * get current millisecond tick interface, it's used by rate limit, duplicate log suppression and log_every_ms_x API
+ *
+ * @return monotonic tick in millisecond
+ */
+uint32_t elog_port_get_tick(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t) (ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+#ifdef ELOG_BLACKBOX_ENABLE
+/**
+ * Map the black box memory. It's the shared memory file which is kept after the process is crashed,
+ * and its content which is left by last process must be kept. The file is named by program name,
+ * and it's locked until the process is exited, so it's never shared by the running processes.
+ *
+ * @param size black box size
+ *
+ * @return black box memory, NULL: map failed or the file is used by other process
+ */
+void *elog_port_blackbox_map(size_t size) {
+    char path[128], name[32] = "unknown";
+    void *addr;
+    struct stat st;
+    FILE *comm;
+    int fd;
+
+    comm = fopen("/proc/self/comm", "r");
+    if (comm) {
+        if (fgets(name, sizeof(name), comm)) {
+            name[strcspn(name, "\n")] = '\0';
+        }
+        fclose(comm);
+    }
+    snprintf(path, sizeof(path), "%s.%s", ELOG_BLACKBOX_PATH, name);
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return NULL;
+    }
+    /* the lock is held by the opened file until exit, it's released by kernel when the process is crashed */
+    if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
+        close(fd);
+        return NULL;
+    }
+    /* the file is only extended, the last process's log is kept when its size is changed */
+    if (fstat(fd, &st) < 0 || ((size_t) st.st_size < size && ftruncate(fd, size) < 0)) {
+        close(fd);
+        return NULL;
+    }
+    addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    return addr;
+}
+#endif /* ELOG_BLACKBOX_ENABLE */
@@ -39,6 +39,11 @@
 
 static pthread_mutex_t output_lock;
 
+#ifdef ELOG_FILE_ENABLE
+/* file sink, the file has no text color */
+static ElogSink file_sink;
+#endif
+
 /**
  * EasyLogger port initialize
  *
@@ -52,6 +57,8 @@ ElogErrCode elog_port_init(void) {
 
 #ifdef ELOG_FILE_ENABLE
     elog_file_init();
+    elog_sink_init(&file_sink, "file", elog_file_write);
+    result = elog_sink_register(&file_sink);
 #endif
     
     return result;
@@ -66,6 +73,7 @@ void elog_port_deinit(void) {
     /* add your code here */
 
 #ifdef ELOG_FILE_ENABLE
+    elog_sink_unregister(&file_sink);
     elog_file_deinit();
 #endif
 
@@ -82,15 +90,10 @@ void elog_port_output(const char *log, size_t size) {
     
     /* add your code here */
     
-    /* output to terminal */
+    /* output to terminal, the file is written by file sink */
 #ifdef ELOG_TERMINAL_ENABLE
     printf("%.*s", (int)size, log);
 #endif
-
-#ifdef ELOG_FILE_ENABLE
-    /* write the file */
-    elog_file_write(log, size);
-#endif 
 }
 
 /**
@@ -166,3 +169,19 @@ const char *elog_port_get_t_info(void) {
 
     return cur_thread_info;
 }
+
+/**
+ * get current millisecond tick interface, it's used by rate limit, duplicate log suppression and log_every_ms_x API
+ *
+ * @return monotonic tick in millisecond
+ */
+uint32_t elog_port_get_tick(void) {
+    
+    /* add your code here */
+    
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t) (ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
@@ -119,6 +119,15 @@ const char *elog_port_get_t_info(void) {
     return rt_thread_self()->name;
 }
 
+/**
+ * get current millisecond tick interface, it's used by rate limit, duplicate log suppression and log_every_ms_x API
+ *
+ * @return monotonic tick in millisecond
+ */
+uint32_t elog_port_get_tick(void) {
+    return (uint32_t) ((uint64_t) rt_tick_get() * 1000 / RT_TICK_PER_SECOND);
+}
+
 #ifdef ELOG_ASYNC_OUTPUT_ENABLE
 void elog_async_output_notice(void) {
     rt_sem_release(&output_notice);
@@ -56,6 +56,15 @@ void elog_file_port_unlock(void)
 {
     /* do noting, using elog_port.c's locker only */
 }
+/**
+ * file log config
+ */
+ElogErrCode elog_file_port_config(const char *name)
+{
+    /* do noting, using elog_port.c's locker only */
+    return ELOG_NO_ERR;
+}
+
 /**
  * file log deinit
  */
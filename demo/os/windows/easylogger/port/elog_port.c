@@ -36,6 +36,11 @@
 
 static HANDLE output_lock = NULL;
 
+#ifdef ELOG_FILE_ENABLE
+/* file sink, the file has no text color */
+static ElogSink file_sink;
+#endif
+
 /**
  * EasyLogger port initialize
  *
@@ -48,6 +53,8 @@ ElogErrCode elog_port_init(void) {
 
 #ifdef ELOG_FILE_ENABLE
     elog_file_init();
+    elog_sink_init(&file_sink, "file", elog_file_write);
+    result = elog_sink_register(&file_sink);
 #endif
     
     return result;
@@ -59,6 +66,7 @@ ElogErrCode elog_port_init(void) {
  */
 void elog_port_deinit(void) {
 #ifdef ELOG_FILE_ENABLE
+	elog_sink_unregister(&file_sink);
 	elog_file_deinit();
 #endif
 
@@ -72,12 +80,8 @@ void elog_port_deinit(void) {
  * @param size log size
  */
 void elog_port_output(const char *log, size_t size) {
-    /* output to terminal */
+    /* output to terminal, the file is written by file sink */
     printf("%.*s", size, log);
-#ifdef ELOG_FILE_ENABLE
-    /* write the file */
-    elog_file_write(log, size);
-#endif 
 }
 
 /**
@@ -136,3 +140,12 @@ const char *elog_port_get_t_info(void) {
 
     return cur_thread_info;
 }
+
+/**
+ * get current millisecond tick interface, it's used by rate limit, duplicate log suppression and log_every_ms_x API
+ *
+ * @return monotonic tick in millisecond
+ */
+uint32_t elog_port_get_tick(void) {
+    return (uint32_t) GetTickCount();
+}
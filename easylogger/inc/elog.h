@@ -33,6 +33,11 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdarg.h>
+
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+#include <pthread.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,11 +63,23 @@ extern "C" {
 
 /* EasyLogger assert for developer. */
 #ifdef ELOG_ASSERT_ENABLE
+#ifdef ELOG_EMERGENCY_ENABLE
+    /* the assert log is output by emergency path, it won't deadlock when the output lock is held */
+    #define ELOG_ASSERT_OUTPUT(EXPR)                                          \
+    do {                                                                      \
+        elog_emergency_flush();                                               \
+        elog_emergency_output(ELOG_LVL_ASSERT, "elog", "(%s) has assert failed at %s:%d.", #EXPR, \
+                __FUNCTION__, __LINE__);                                      \
+    } while (0)
+#else
+    #define ELOG_ASSERT_OUTPUT(EXPR)                                          \
+            elog_a("elog", "(%s) has assert failed at %s:%ld.", #EXPR, __FUNCTION__, __LINE__)
+#endif
     #define ELOG_ASSERT(EXPR)                                                 \
     if (!(EXPR))                                                              \
     {                                                                         \
         if (elog_assert_hook == NULL) {                                       \
-            elog_a("elog", "(%s) has assert failed at %s:%ld.", #EXPR, __FUNCTION__, __LINE__); \
+            ELOG_ASSERT_OUTPUT(EXPR);                                         \
             while (1);                                                        \
         } else {                                                              \
             elog_assert_hook(#EXPR, __FUNCTION__, __LINE__);                  \
@@ -175,10 +192,296 @@ typedef struct {
     ElogTagLvlFilter tag_lvl[ELOG_FILTER_TAG_LVL_MAX_NUM];
 } ElogFilter, *ElogFilter_t;
 
-/* easy logger */
+/* filter snapshot number, the retired snapshot is reused after the other snapshots are published */
+#ifndef ELOG_FILTER_SNAPSHOT_NUM
+#define ELOG_FILTER_SNAPSHOT_NUM             2
+#endif
+
+/**
+ * Published filter snapshot. It's immutable until it's retired and reused by the later setting.
+ * The sequence is odd when it's being rebuilt, so the reader will retry when the sequence is changed.
+ */
 typedef struct {
+    volatile uint32_t seq;
     ElogFilter filter;
+} ElogFilterSnapshot;
+
+/* easy logger */
+typedef struct _EasyLogger EasyLogger, *EasyLogger_t;
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+/* token bucket by generic cell rate algorithm, the theoretical arrival time is updated by CAS without lock */
+typedef struct {
+    uint32_t tat;                                /**< theoretical arrival time in 1/256 millisecond */
+    uint32_t suppressed;                         /**< suppressed log number since last report */
+    uint32_t report_tick;                        /**< last suppressed report tick in millisecond */
+    uint8_t level;                               /**< the first suppressed log's level and tag for the report */
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
+} ElogTokenBucket;
+
+/* rate limit rule for the tag and level */
+typedef struct {
+    bool use_flag;
+    bool per_callsite;                           /**< true: every callsite has its own token bucket */
+    uint8_t level;
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];       /**< empty: all tags */
+    uint32_t rate;                               /**< log number per second */
+    uint32_t burst;                              /**< max log number in one burst */
+    uint32_t id;                                 /**< it's changed when the rule is set, the callsite buckets are reset */
+    uint32_t interval;                           /**< emission interval of one log in 1/256 millisecond */
+    uint32_t tolerance;                          /**< burst tolerance in 1/256 millisecond */
+    ElogTokenBucket bucket;                      /**< it's used when per_callsite is false */
+} ElogRateLimitRule;
+
+/* token bucket for one callsite, the callsite is identified by the hash of file, function, line and rule */
+typedef struct {
+    uint32_t key;                                /**< callsite hash, 0: unused */
+    ElogTokenBucket bucket;
+} ElogRateLimitCallsite;
+
+/* rate limit and sampling */
+typedef struct {
+    uint8_t rule_num;                            /**< used rule number, 0: rate limit is disabled */
+    uint32_t rule_seq;                           /**< it's odd when the rules are changing */
+    ElogRateLimitRule rule[ELOG_RATE_LIMIT_RULE_MAX_NUM];
+    ElogRateLimitCallsite callsite[ELOG_RATE_LIMIT_CALLSITE_MAX_NUM];
+    uint32_t sample_n[ELOG_LVL_TOTAL_NUM];       /**< 1 in N log will output, 0 or 1: sampling is disabled */
+    bool sample_random[ELOG_LVL_TOTAL_NUM];      /**< true: the log is output with 1/N probability */
+    uint32_t sample_count[ELOG_LVL_TOTAL_NUM];
+    uint32_t sample_seed;
+} ElogRateLimit;
+#endif /* ELOG_RATE_LIMIT_ENABLE */
+
+#ifdef ELOG_DEDUP_ENABLE
+/* duplicate log suppression mode */
+typedef enum {
+    ELOG_DEDUP_NONE,                             /**< disable the duplicate log suppression */
+    ELOG_DEDUP_MSG,                              /**< the log which has same level, tag and message is duplicate */
+    ELOG_DEDUP_CALLSITE,                         /**< the log which is output by same callsite is duplicate */
+} ElogDedupMode;
+
+/* duplicate log suppression, the repeated log is collapsed to "last message repeated N times" */
+typedef struct {
+    ElogDedupMode mode;
+    uint32_t window;                             /**< the repeated log is collapsed in the window (ms), 0: no limit */
+    uint64_t hash;                               /**< last log's hash */
+    uint32_t tick;                               /**< last output log's tick in millisecond */
+    uint32_t repeat;                             /**< last log's repeated number */
+    uint8_t level;                               /**< last log's level */
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];       /**< last log's tag */
+} ElogDedup;
+#endif /* ELOG_DEDUP_ENABLE */
+
+#ifdef ELOG_BLACKBOX_ENABLE
+/* black box header magic number, it's "ELBB" in memory */
+#define ELOG_BLACKBOX_MAGIC                      0x42424C45UL
+#define ELOG_BLACKBOX_VERSION                    1
+/**
+ * Black box header. It's placed at the beginning of the memory which survives the process crash,
+ * such as the shared memory file on POSIX or the no init RAM on MCU, the buffers are following it.
+ * The unflushed log is the last `async_unflushed` bytes before `async_write` in ring buffer,
+ * and the first `buf_used` bytes in buffered output mode buffer.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t async_offset;                       /**< asynchronous output ring buffer offset from the header */
+    uint32_t async_size;                         /**< asynchronous output ring buffer size */
+    volatile uint32_t async_write;               /**< ring buffer write index */
+    volatile uint32_t async_unflushed;           /**< the log size which is put but not output yet */
+    uint32_t buf_offset;                         /**< buffered output mode buffer offset from the header */
+    uint32_t buf_size;                           /**< buffered output mode buffer size */
+    volatile uint32_t buf_used;                  /**< buffered output mode buffer used size */
+    uint32_t reserved;
+} ElogBlackbox;
+#endif /* ELOG_BLACKBOX_ENABLE */
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+#ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
+#include <pthread.h>
+#include <semaphore.h>
+#endif
+/* asynchronous output mode */
+typedef struct {
+    bool init_ok;
+    EasyLogger_t elog;                           /**< owner object, its output lock is protecting the ring buffer */
+    void (*output)(const char *log, size_t size); /**< output interface for the log which is got from ring buffer */
+    bool is_enabled;
+    char *buf;                                   /**< ring buffer, NULL: asynchronous output is unused */
+    size_t buf_size;                             /**< ring buffer size */
+    size_t write_index;                          /**< ring buffer write index */
+    size_t read_index;                           /**< ring buffer read index */
+    bool buf_is_full;
+    bool buf_is_empty;
+    void (*notice)(void);                        /**< output notice, it will be called when the new log is put */
+#ifdef ELOG_BLACKBOX_ENABLE
+    ElogBlackbox *blackbox;                      /**< black box which is recording the indices, NULL: unused */
+#endif
+#ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
+    bool thread_running;
+    sem_t output_notice;
+    pthread_t output_thread;
+    size_t put_total;                            /**< total put log size, it's protected by output lock and may wrap */
+    size_t output_total;                         /**< total output log size, it's protected by output_total_lock */
+    pthread_mutex_t output_total_lock;
+    pthread_cond_t output_done;                  /**< the log which is got from ring buffer is output */
+#endif
+} ElogAsync;
+#endif /* ELOG_ASYNC_OUTPUT_ENABLE */
+
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+#include <pthread.h>
+/* the buffered output mode buffer is split into the number of buffers, 2: double buffering, 3: triple buffering */
+#ifndef ELOG_BUF_OUTPUT_BUF_NUM
+#define ELOG_BUF_OUTPUT_BUF_NUM              2
+#endif
+#endif
+/* buffered output mode */
+typedef struct {
+    bool is_enabled;
+    char *buf;                                   /**< buffer which is filling, NULL: buffered output is unused */
+    size_t buf_size;                             /**< buffer size */
+    size_t write_size;                           /**< buffer current write size */
+#ifdef ELOG_BLACKBOX_ENABLE
+    ElogBlackbox *blackbox;                      /**< black box which is recording the write size, NULL: unused */
+#endif
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    EasyLogger_t elog;                           /**< owner object, its output interface is called by flusher */
+    char *bufs[ELOG_BUF_OUTPUT_BUF_NUM];         /**< the configured buffer is split into these buffers */
+    size_t full_size[ELOG_BUF_OUTPUT_BUF_NUM];   /**< log size of the full buffer which is waiting for flusher */
+    uint8_t fill_index;                          /**< the buffer which is filling */
+    uint8_t full_num;                            /**< full buffer number, they are in order before the filling buffer */
+    uint8_t flushing_num;                        /**< 1: the buffer before the full buffers is taken by flusher */
+    uint32_t fill_tick;                          /**< the tick when the first log is put to the filling buffer */
+    bool flusher_idle;                           /**< the flusher is waiting without timeout */
+    bool thread_running;
+    pthread_mutex_t lock;                        /**< it's protecting the buffers, the flusher isn't using output lock */
+    pthread_cond_t notice;                       /**< flusher notice, a buffer is full or the first log is put */
+    pthread_cond_t done;                         /**< a full buffer is output by flusher */
+    pthread_t flush_thread;
+#endif
+} ElogBuf;
+#endif /* ELOG_BUF_OUTPUT_ENABLE */
+
+/* EasyLogger instance configuration */
+typedef struct {
+    void (*output)(const char *log, size_t size); /**< log output interface */
+    void (*output_lock)(void *arg);              /**< output lock, NULL: the instance is unlocked */
+    void (*output_unlock)(void *arg);            /**< output unlock */
+    void *lock_arg;                              /**< argument of output lock and unlock, such as the mutex */
+    char *async_buf;                             /**< asynchronous output ring buffer */
+    size_t async_buf_size;                       /**< asynchronous output ring buffer size, 0: sync output */
+    void (*async_notice)(void);                  /**< asynchronous output notice, it's unused when using pthread */
+    char *buf;                                   /**< buffered output mode buffer */
+    size_t buf_size;                             /**< buffered output mode buffer size, 0: output directly */
+#ifdef ELOG_BLACKBOX_ENABLE
+    ElogBlackbox *blackbox;                      /**< black box, the above buffers must be placed in it, NULL: unused */
+#endif
+} ElogCfg;
+
+/* log extra key/value's value type */
+typedef enum {
+    ELOG_KV_STR,
+    ELOG_KV_I64,
+    ELOG_KV_U64,
+    ELOG_KV_F64,
+    ELOG_KV_BOOL,
+} ElogKvType;
+
+/* log extra key/value pair, the value is kept in its type until it's rendered by sink */
+typedef struct {
+    const char *key;
+    ElogKvType type;
+    union {
+        const char *str;
+        int64_t i64;
+        uint64_t u64;
+        double f64;
+        bool b;
+    } value;
+} ElogKv;
+
+/* typed key/value pair definition */
+#define ELOG_STR(k, v)       ((ElogKv) { .key = (k), .type = ELOG_KV_STR, .value.str = (v) })
+#define ELOG_I64(k, v)       ((ElogKv) { .key = (k), .type = ELOG_KV_I64, .value.i64 = (v) })
+#define ELOG_U64(k, v)       ((ElogKv) { .key = (k), .type = ELOG_KV_U64, .value.u64 = (v) })
+#define ELOG_F64(k, v)       ((ElogKv) { .key = (k), .type = ELOG_KV_F64, .value.f64 = (v) })
+#define ELOG_BOOL(k, v)      ((ElogKv) { .key = (k), .type = ELOG_KV_BOOL, .value.b = (v) })
+
+/* log record, it's carried as structured fields and rendered by each sink */
+typedef struct {
+    uint8_t level;
+    const char *tag;
+    const char *file;                            /**< file directory and name, NULL: unused */
+    const char *func;                            /**< function name, NULL: unused */
+    long line;                                   /**< line number, 0: unused */
+    const char *time;                            /**< current time, it's got from port when it's used */
+    const char *p_info;                          /**< process info, it's got from port when it's used */
+    const char *t_info;                          /**< thread info, it's got from port when it's used */
+    const char *msg;                             /**< formatted message, it's not end with newline sign */
+    size_t msg_len;                              /**< formatted message length */
+    const ElogKv *kv;                            /**< extra key/value pairs, NULL: unused */
+    size_t kv_num;                               /**< extra key/value pairs number */
+} ElogRecord;
+
+/* log output sink, every sink has its own level, format and asynchronous output queue */
+typedef struct _ElogSink ElogSink, *ElogSink_t;
+struct _ElogSink {
+    const char *name;                            /**< sink name */
+    void (*output)(const char *log, size_t size); /**< sink output interface */
+    /**
+     * Render the record to line log, NULL: using the default text format.
+     * The time, process and thread info in record has been got before it's called.
+     * @return line log length, it's not more than the size
+     */
+    size_t (*render)(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size);
+    uint8_t level;                               /**< the log which level is less than it will stop output */
+    size_t fmt_set[ELOG_LVL_TOTAL_NUM];          /**< sink output format, it's valid when the fmt_set_flag bit is set */
+    uint8_t fmt_set_flag;                        /**< bit n: the level n is using sink format, otherwise object format */
+#ifdef ELOG_COLOR_ENABLE
+    bool text_color_enabled;
+#endif
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    char *async_buf;                             /**< asynchronous output ring buffer, NULL: sync output */
+    size_t async_buf_size;                       /**< asynchronous output ring buffer size */
+    void (*async_notice)(void);                  /**< asynchronous output notice, it's unused when using pthread */
+    ElogAsync async;
+#endif
+    EasyLogger_t elog;                           /**< registered object */
+    ElogSink_t next;
+};
+
+/* log statistics, the counters are increased since the object is initialized and they may wrap around */
+typedef struct {
+    uint32_t output[ELOG_LVL_TOTAL_NUM];         /**< output log number of each level */
+    uint32_t filtered;                           /**< the log number which is dropped by keyword filter */
+    uint32_t limited;                            /**< the log number which is dropped by rate limit and sampling */
+    uint32_t deduped;                            /**< the duplicate log number which is collapsed */
+    uint32_t dropped;                            /**< the log number which is truncated by full asynchronous ring buffer */
+    size_t async_used;                           /**< output interface's asynchronous ring buffer used size */
+    size_t async_size;                           /**< output interface's asynchronous ring buffer size */
+    size_t buf_used;                             /**< buffered output mode buffer used size */
+    size_t buf_size;                             /**< buffered output mode buffer size */
+} ElogStats;
+
+struct _EasyLogger {
+    /* the filter is published by atomic pointer swap, the reader is lock free */
+    ElogFilterSnapshot * volatile filter;
+    ElogFilterSnapshot filter_snapshot[ELOG_FILTER_SNAPSHOT_NUM];
+    uint8_t filter_snapshot_index;
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+    pthread_mutex_t filter_lock;                 /**< it's serializing the filter setting, the reader is lock free */
+#endif
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    ElogRateLimit limit;
+#endif
+#ifdef ELOG_DEDUP_ENABLE
+    ElogDedup dedup;
+#endif
     size_t enabled_fmt_set[ELOG_LVL_TOTAL_NUM];
+    /* the counters are increased with output lock except the limited counter */
+    ElogStats stats;
     bool init_ok;
     bool output_enabled;
     bool output_lock_enabled;
@@ -189,11 +492,34 @@ typedef struct {
     bool text_color_enabled;
 #endif
 
-}EasyLogger, *EasyLogger_t;
+    /* every line log's buffer */
+    char log_buf[ELOG_LINE_BUF_SIZE];
+    /* every log's message buffer, it will be rendered to log_buf by each distinct sink format */
+    char msg_buf[ELOG_LINE_BUF_SIZE];
+    /* port interface for this instance */
+    void (*output)(const char *log, size_t size);
+    void (*output_lock)(void *arg);
+    void (*output_unlock)(void *arg);
+    void *lock_arg;
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    ElogAsync async;
+#endif
+
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    ElogBuf buf;
+#endif
+
+    /* the output interface's sink, it's using the object's asynchronous or buffered output mode */
+    ElogSink output_sink;
+    /* registered sinks, the output interface's sink is the first one when it's not NULL */
+    ElogSink_t sinks;
+};
 
 /* EasyLogger error code */
 typedef enum {
     ELOG_NO_ERR,
+    ELOG_PORT_ERR,
 } ElogErrCode;
 
 /* elog.c */
@@ -212,9 +538,15 @@ void elog_set_filter_tag(const char *tag);
 void elog_set_filter_kw(const char *keyword);
 void elog_set_filter_tag_lvl(const char *tag, uint8_t level);
 uint8_t elog_get_filter_tag_lvl(const char *tag);
+void elog_get_filter(ElogFilter *filter);
+void elog_get_stats(ElogStats *stats);
 void elog_raw_output(const char *format, ...);
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...);
+void elog_output_kv(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const ElogKv *kv, size_t kv_num, const char *format, ...);
+void elog_output_fields(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *msg, const ElogKv *kv, size_t kv_num);
 void elog_output_lock_enabled(bool enabled);
 extern void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
 void elog_assert_set_hook(void (*hook)(const char* expr, const char* func, size_t line));
@@ -222,6 +554,42 @@ int8_t elog_find_lvl(const char *log);
 const char *elog_find_tag(const char *log, uint8_t lvl, size_t *tag_len);
 void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t size);
 
+/* elog.c instance API, the above API is using the default instance */
+EasyLogger_t elog_get_default(void);
+EasyLogger_t elog_create(const ElogCfg *cfg);
+void elog_destroy(EasyLogger_t elog);
+ElogErrCode elog_inst_init(EasyLogger_t elog, const ElogCfg *cfg);
+void elog_inst_deinit(EasyLogger_t elog);
+void elog_inst_start(EasyLogger_t elog);
+void elog_inst_stop(EasyLogger_t elog);
+void elog_inst_set_output_enabled(EasyLogger_t elog, bool enabled);
+bool elog_inst_get_output_enabled(EasyLogger_t elog);
+void elog_inst_set_text_color_enabled(EasyLogger_t elog, bool enabled);
+bool elog_inst_get_text_color_enabled(EasyLogger_t elog);
+void elog_inst_set_fmt(EasyLogger_t elog, uint8_t level, size_t set);
+void elog_inst_set_filter(EasyLogger_t elog, uint8_t level, const char *tag, const char *keyword);
+void elog_inst_set_filter_lvl(EasyLogger_t elog, uint8_t level);
+void elog_inst_set_filter_tag(EasyLogger_t elog, const char *tag);
+void elog_inst_set_filter_kw(EasyLogger_t elog, const char *keyword);
+void elog_inst_set_filter_tag_lvl(EasyLogger_t elog, const char *tag, uint8_t level);
+uint8_t elog_inst_get_filter_tag_lvl(EasyLogger_t elog, const char *tag);
+void elog_inst_get_filter(EasyLogger_t elog, ElogFilter *filter);
+void elog_inst_get_stats(EasyLogger_t elog, ElogStats *stats);
+void elog_inst_raw_output(EasyLogger_t elog, const char *format, ...);
+void elog_inst_vraw_output(EasyLogger_t elog, const char *format, va_list args);
+void elog_inst_output(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...);
+void elog_inst_voutput(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, va_list args);
+void elog_inst_output_kv(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const ElogKv *kv, size_t kv_num, const char *format, ...);
+void elog_inst_voutput_kv(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const ElogKv *kv, size_t kv_num, const char *format, va_list args);
+void elog_inst_output_fields(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *msg, const ElogKv *kv, size_t kv_num);
+void elog_inst_output_lock_enabled(EasyLogger_t elog, bool enabled);
+void elog_inst_hexdump(EasyLogger_t elog, const char *name, uint8_t width, const void *buf, uint16_t size);
+
 #define elog_a(tag, ...)     elog_assert(tag, __VA_ARGS__)
 #define elog_e(tag, ...)     elog_error(tag, __VA_ARGS__)
 #define elog_w(tag, ...)     elog_warn(tag, __VA_ARGS__)
@@ -229,6 +597,89 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
 #define elog_d(tag, ...)     elog_debug(tag, __VA_ARGS__)
 #define elog_v(tag, ...)     elog_verbose(tag, __VA_ARGS__)
 
+/**
+ * log API with extra key/value pairs, the static output level is same as elog_x API
+ *
+ * example:
+ *     ElogKv kv[] = { ELOG_STR("user", name), ELOG_STR("ip", ip) };
+ *     elog_kvf(ELOG_LVL_INFO, "audit", kv, 2, "user login, %d times", count);
+ *
+ * Structured log API, the message is not formatted and the typed fields are rendered by sink.
+ * It needs one field at least.
+ *
+ * example:
+ *     elog_kv(ELOG_LVL_INFO, "http", "request done", ELOG_U64("req_id", id), ELOG_STR("path", path));
+ */
+#ifndef ELOG_OUTPUT_ENABLE
+    #define elog_kvf(level, tag, kv, kv_num, ...)
+    #define elog_kv(level, tag, msg, ...)
+    #define elog_inst_kv(elog, level, tag, msg, ...)
+#else
+    #define elog_kv(level, tag, msg, ...)        elog_inst_kv(elog_get_default(), level, tag, msg, __VA_ARGS__)
+    #define elog_inst_kv(elog, level, tag, msg, ...)                                                              \
+    do {                                                                                                          \
+        if ((level) <= ELOG_OUTPUT_LVL) {                                                                         \
+            const ElogKv elog_kv_fields[] = { __VA_ARGS__ };                                                      \
+            elog_inst_output_fields(elog, level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, msg,   \
+                    elog_kv_fields, sizeof(elog_kv_fields) / sizeof(ElogKv));                                     \
+        }                                                                                                         \
+    } while (0)
+    #define elog_kvf(level, tag, kv, kv_num, ...)                                                                 \
+    do {                                                                                                          \
+        if ((level) <= ELOG_OUTPUT_LVL) {                                                                         \
+            elog_output_kv(level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, kv, kv_num, __VA_ARGS__); \
+        }                                                                                                         \
+    } while (0)
+#endif /* ELOG_OUTPUT_ENABLE */
+
+/**
+ * instance log API definition, the static output level is same as elog_x API
+ *
+ * example:
+ *     elog_inst_i(audit_elog, "audit", "user %s login", name);
+ */
+#ifndef ELOG_OUTPUT_ENABLE
+    #define elog_inst_a(elog, tag, ...)
+    #define elog_inst_e(elog, tag, ...)
+    #define elog_inst_w(elog, tag, ...)
+    #define elog_inst_i(elog, tag, ...)
+    #define elog_inst_d(elog, tag, ...)
+    #define elog_inst_v(elog, tag, ...)
+#else
+    #define ELOG_INST_OUTPUT(elog, level, tag, ...) \
+            elog_inst_output(elog, level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT
+        #define elog_inst_a(elog, tag, ...) ELOG_INST_OUTPUT(elog, ELOG_LVL_ASSERT, tag, __VA_ARGS__)
+    #else
+        #define elog_inst_a(elog, tag, ...)
+    #endif
+    #if ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR
+        #define elog_inst_e(elog, tag, ...) ELOG_INST_OUTPUT(elog, ELOG_LVL_ERROR, tag, __VA_ARGS__)
+    #else
+        #define elog_inst_e(elog, tag, ...)
+    #endif
+    #if ELOG_OUTPUT_LVL >= ELOG_LVL_WARN
+        #define elog_inst_w(elog, tag, ...) ELOG_INST_OUTPUT(elog, ELOG_LVL_WARN, tag, __VA_ARGS__)
+    #else
+        #define elog_inst_w(elog, tag, ...)
+    #endif
+    #if ELOG_OUTPUT_LVL >= ELOG_LVL_INFO
+        #define elog_inst_i(elog, tag, ...) ELOG_INST_OUTPUT(elog, ELOG_LVL_INFO, tag, __VA_ARGS__)
+    #else
+        #define elog_inst_i(elog, tag, ...)
+    #endif
+    #if ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG
+        #define elog_inst_d(elog, tag, ...) ELOG_INST_OUTPUT(elog, ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+    #else
+        #define elog_inst_d(elog, tag, ...)
+    #endif
+    #if ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE
+        #define elog_inst_v(elog, tag, ...) ELOG_INST_OUTPUT(elog, ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+    #else
+        #define elog_inst_v(elog, tag, ...)
+    #endif
+#endif /* ELOG_OUTPUT_ENABLE */
+
 /**
  * log API short definition
  * NOTE: The `LOG_TAG` and `LOG_LVL` must defined before including the <elog.h> when you want to use log_x API.
@@ -270,24 +721,215 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
     #define log_v(...)       ((void)0);
 #endif
 
+/**
+ * log API with callsite local state, the state is kept in the static variable of every callsite,
+ * so the skip decision is only one relaxed atomic operation without lock.
+ *
+ * example:
+ *     // only output once
+ *     log_once_w("the config is not found, using default");
+ *     // output the 1st, (n + 1)th, (2n + 1)th ... log, it's always output when n <= 1
+ *     log_every_n_i(100, "received %d packets", count);
+ *     // output one log in the period (ms) at most, it needs elog_port_get_tick
+ *     log_every_ms_e(1000, "connect failed, errno: %d", err);
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define ELOG_ONCE(STMT)                                                   \
+    do {                                                                      \
+        static uint8_t elog_once_flag_;                                       \
+        if (__atomic_exchange_n(&elog_once_flag_, 1, __ATOMIC_RELAXED) == 0) { \
+            STMT;                                                             \
+        }                                                                     \
+    } while (0)
+    #define ELOG_EVERY_N(N, STMT)                                             \
+    do {                                                                      \
+        static uint32_t elog_every_n_count_;                                  \
+        if ((N) <= 1 || __atomic_fetch_add(&elog_every_n_count_, 1, __ATOMIC_RELAXED) % (uint32_t) (N) == 0) { \
+            STMT;                                                             \
+        }                                                                     \
+    } while (0)
+    /* the tick is always odd, so the 0 means the log has never been output */
+    #define ELOG_EVERY_MS(MS, STMT)                                           \
+    do {                                                                      \
+        extern uint32_t elog_port_get_tick(void);                             \
+        static uint32_t elog_every_ms_last_;                                  \
+        uint32_t elog_every_ms_now_ = elog_port_get_tick() | 1;               \
+        uint32_t elog_every_ms_prev_ = __atomic_load_n(&elog_every_ms_last_, __ATOMIC_RELAXED); \
+        if ((elog_every_ms_prev_ == 0 || elog_every_ms_now_ - elog_every_ms_prev_ >= (uint32_t) (MS)) \
+                && __atomic_compare_exchange_n(&elog_every_ms_last_, &elog_every_ms_prev_, \
+                        elog_every_ms_now_, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { \
+            STMT;                                                             \
+        }                                                                     \
+    } while (0)
+#else
+    /* the state is not atomic on other compilers, the log may be output more than expected by concurrent callers */
+    #define ELOG_ONCE(STMT)                                                   \
+    do {                                                                      \
+        static volatile uint8_t elog_once_flag_;                              \
+        if (elog_once_flag_ == 0) {                                           \
+            elog_once_flag_ = 1;                                              \
+            STMT;                                                             \
+        }                                                                     \
+    } while (0)
+    #define ELOG_EVERY_N(N, STMT)                                             \
+    do {                                                                      \
+        static volatile uint32_t elog_every_n_count_;                         \
+        if ((N) <= 1 || elog_every_n_count_++ % (uint32_t) (N) == 0) {       \
+            STMT;                                                             \
+        }                                                                     \
+    } while (0)
+    #define ELOG_EVERY_MS(MS, STMT)                                           \
+    do {                                                                      \
+        extern uint32_t elog_port_get_tick(void);                             \
+        static volatile uint32_t elog_every_ms_last_;                         \
+        uint32_t elog_every_ms_now_ = elog_port_get_tick() | 1;               \
+        if (elog_every_ms_last_ == 0 || elog_every_ms_now_ - elog_every_ms_last_ >= (uint32_t) (MS)) { \
+            elog_every_ms_last_ = elog_every_ms_now_;                         \
+            STMT;                                                             \
+        }                                                                     \
+    } while (0)
+#endif
+#if LOG_LVL >= ELOG_LVL_ASSERT
+    #define log_once_a(...)             ELOG_ONCE(log_a(__VA_ARGS__))
+    #define log_every_n_a(n, ...)       ELOG_EVERY_N(n, log_a(__VA_ARGS__))
+    #define log_every_ms_a(ms, ...)     ELOG_EVERY_MS(ms, log_a(__VA_ARGS__))
+#else
+    #define log_once_a(...)             ((void)0);
+    #define log_every_n_a(n, ...)       ((void)0);
+    #define log_every_ms_a(ms, ...)     ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_ERROR
+    #define log_once_e(...)             ELOG_ONCE(log_e(__VA_ARGS__))
+    #define log_every_n_e(n, ...)       ELOG_EVERY_N(n, log_e(__VA_ARGS__))
+    #define log_every_ms_e(ms, ...)     ELOG_EVERY_MS(ms, log_e(__VA_ARGS__))
+#else
+    #define log_once_e(...)             ((void)0);
+    #define log_every_n_e(n, ...)       ((void)0);
+    #define log_every_ms_e(ms, ...)     ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_WARN
+    #define log_once_w(...)             ELOG_ONCE(log_w(__VA_ARGS__))
+    #define log_every_n_w(n, ...)       ELOG_EVERY_N(n, log_w(__VA_ARGS__))
+    #define log_every_ms_w(ms, ...)     ELOG_EVERY_MS(ms, log_w(__VA_ARGS__))
+#else
+    #define log_once_w(...)             ((void)0);
+    #define log_every_n_w(n, ...)       ((void)0);
+    #define log_every_ms_w(ms, ...)     ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_INFO
+    #define log_once_i(...)             ELOG_ONCE(log_i(__VA_ARGS__))
+    #define log_every_n_i(n, ...)       ELOG_EVERY_N(n, log_i(__VA_ARGS__))
+    #define log_every_ms_i(ms, ...)     ELOG_EVERY_MS(ms, log_i(__VA_ARGS__))
+#else
+    #define log_once_i(...)             ((void)0);
+    #define log_every_n_i(n, ...)       ((void)0);
+    #define log_every_ms_i(ms, ...)     ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_DEBUG
+    #define log_once_d(...)             ELOG_ONCE(log_d(__VA_ARGS__))
+    #define log_every_n_d(n, ...)       ELOG_EVERY_N(n, log_d(__VA_ARGS__))
+    #define log_every_ms_d(ms, ...)     ELOG_EVERY_MS(ms, log_d(__VA_ARGS__))
+#else
+    #define log_once_d(...)             ((void)0);
+    #define log_every_n_d(n, ...)       ((void)0);
+    #define log_every_ms_d(ms, ...)     ((void)0);
+#endif
+#if LOG_LVL >= ELOG_LVL_VERBOSE
+    #define log_once_v(...)             ELOG_ONCE(log_v(__VA_ARGS__))
+    #define log_every_n_v(n, ...)       ELOG_EVERY_N(n, log_v(__VA_ARGS__))
+    #define log_every_ms_v(ms, ...)     ELOG_EVERY_MS(ms, log_v(__VA_ARGS__))
+#else
+    #define log_once_v(...)             ((void)0);
+    #define log_every_n_v(n, ...)       ((void)0);
+    #define log_every_ms_v(ms, ...)     ((void)0);
+#endif
+
 /* assert API short definition */
 #if !defined(assert)
     #define assert           ELOG_ASSERT
 #endif
 
+/* elog_sink.c */
+void elog_sink_init(ElogSink_t sink, const char *name, void (*output)(const char *log, size_t size));
+void elog_sink_set_lvl(ElogSink_t sink, uint8_t level);
+void elog_sink_set_fmt(ElogSink_t sink, uint8_t level, size_t set);
+void elog_sink_set_text_color_enabled(ElogSink_t sink, bool enabled);
+void elog_sink_set_render(ElogSink_t sink, size_t (*render)(ElogSink_t sink, const ElogRecord *rec, char *log,
+        size_t size));
+size_t elog_sink_get_fmt(ElogSink_t sink, uint8_t level);
+void elog_sink_set_async(ElogSink_t sink, char *buf, size_t size, void (*notice)(void));
+ElogErrCode elog_sink_register(ElogSink_t sink);
+void elog_sink_unregister(ElogSink_t sink);
+ElogErrCode elog_inst_sink_register(EasyLogger_t elog, ElogSink_t sink);
+void elog_inst_sink_unregister(EasyLogger_t elog, ElogSink_t sink);
+
+/* elog_encoder.c */
+size_t elog_json_render(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size);
+size_t elog_logfmt_render(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size);
+size_t elog_binary_render(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size);
+size_t elog_binary_decode(const char *log, size_t size, ElogRecord *rec, ElogKv *kv, size_t kv_max);
+
 /* elog_buf.c */
 void elog_buf_enabled(bool enabled);
 void elog_flush(void);
+void elog_inst_buf_enabled(EasyLogger_t elog, bool enabled);
+void elog_inst_flush(EasyLogger_t elog);
 
 /* elog_async.c */
 void elog_async_enabled(bool enabled);
 size_t elog_async_get_log(char *log, size_t size);
 size_t elog_async_get_line_log(char *log, size_t size);
+void elog_inst_async_enabled(EasyLogger_t elog, bool enabled);
+size_t elog_inst_async_get_log(EasyLogger_t elog, char *log, size_t size);
+size_t elog_inst_async_get_line_log(EasyLogger_t elog, char *log, size_t size);
+size_t elog_sink_async_get_log(ElogSink_t sink, char *log, size_t size);
+void elog_sink_async_flush(ElogSink_t sink);
+
+/* elog_limit.c */
+void elog_set_rate_limit(const char *tag, uint8_t level, uint32_t rate, uint32_t burst, bool per_callsite);
+void elog_set_sampling(uint8_t level, uint32_t n, bool random);
+void elog_inst_set_rate_limit(EasyLogger_t elog, const char *tag, uint8_t level, uint32_t rate, uint32_t burst,
+        bool per_callsite);
+void elog_inst_set_sampling(EasyLogger_t elog, uint8_t level, uint32_t n, bool random);
+void elog_rate_limit_poll(void);
+void elog_inst_rate_limit_poll(EasyLogger_t elog);
+
+/* elog_dedup.c */
+void elog_set_dedup(uint8_t mode, uint32_t window);
+void elog_inst_set_dedup(EasyLogger_t elog, uint8_t mode, uint32_t window);
+void elog_dedup_poll(void);
+void elog_inst_dedup_poll(EasyLogger_t elog);
+
+/* elog_config.c */
+bool elog_config_load(const char *path);
+bool elog_config_watch(const char *path);
+void elog_config_unwatch(void);
+bool elog_inst_config_load(EasyLogger_t elog, const char *path);
+bool elog_inst_config_watch(EasyLogger_t elog, const char *path);
+
+/* elog_ctl.c */
+typedef bool (*ElogCtlHandler)(EasyLogger_t elog, char *arg);
+bool elog_ctl_start(const char *path);
+void elog_ctl_stop(void);
+bool elog_inst_ctl_start(EasyLogger_t elog, const char *path);
+bool elog_ctl_cmd_register(const char *name, const char *help, ElogCtlHandler handler);
+void elog_ctl_reply(const char *format, ...);
+void elog_ctl_reply_raw(const char *data, size_t size);
+
+/* elog_emergency.c */
+void elog_emergency_set_fds(const int *fds, size_t num);
+void elog_emergency_output(uint8_t level, const char *tag, const char *format, ...);
+void elog_emergency_flush(void);
+
+/* elog_blackbox.c */
+size_t elog_blackbox_extract(const void *image, size_t size, void (*output)(const char *log, size_t size));
 
 /* elog_utils.c */
 size_t elog_strcpy(size_t cur_len, char *dst, const char *src);
 size_t elog_cpyln(char *line, const char *log, size_t len);
 void *elog_memcpy(void *dst, const void *src, size_t count);
+size_t elog_kv_value_to_str(const ElogKv *kv, char *buf, size_t size);
+int8_t elog_lvl_from_str(const char *str);
 
 #ifdef __cplusplus
 }
@@ -45,6 +45,10 @@
 #define ELOG_FILTER_KW_MAX_LEN                   16
 /* output filter's tag level max num */
 #define ELOG_FILTER_TAG_LVL_MAX_NUM              5
+/* output filter's snapshot number */
+#define ELOG_FILTER_SNAPSHOT_NUM                 2
+/* filter setting is serialized by the object's own pthread mutex, otherwise by the output lock */
+#define ELOG_FILTER_LOCK_USING_PTHREAD
 /* output newline sign */
 #define ELOG_NEWLINE_SIGN                        "\n"
 /*---------------------------------------------------------------------------*/
@@ -79,5 +83,46 @@
 #define ELOG_BUF_OUTPUT_ENABLE
 /* buffer size for buffered output mode */
 #define ELOG_BUF_OUTPUT_BUF_SIZE                 (ELOG_LINE_BUF_SIZE * 10)
+/* the buffer is split into multiple buffers, the full buffer is output by flusher thread */
+//#define ELOG_BUF_OUTPUT_USING_PTHREAD
+/* buffer number for flusher thread, 2: double buffering, 3: triple buffering */
+#define ELOG_BUF_OUTPUT_BUF_NUM                  2
+/* the buffered log will be output by flusher after the interval (ms) since the first log is put, 0: disable */
+#define ELOG_BUF_OUTPUT_FLUSH_INTERVAL           1000
+/*---------------------------------------------------------------------------*/
+/* enable async-signal-safe emergency output for POSIX, the log is written to the fds by write(2) */
+//#define ELOG_EMERGENCY_ENABLE
+/* max number of the emergency output fds */
+#define ELOG_EMERGENCY_FD_MAX_NUM                4
+/*---------------------------------------------------------------------------*/
+/* enable black box, the asynchronous and buffered output mode buffers are placed in the memory
+ * which survives the crash, it's mapped by elog_port_blackbox_map */
+//#define ELOG_BLACKBOX_ENABLE
+/* black box shared memory file path prefix for POSIX port, the program name is appended to it */
+#define ELOG_BLACKBOX_PATH                       "/dev/shm/elog_blackbox"
+/*---------------------------------------------------------------------------*/
+/* enable rate limit and sampling, the millisecond tick is got by elog_port_get_tick */
+//#define ELOG_RATE_LIMIT_ENABLE
+/* max number of the rate limit rules */
+#define ELOG_RATE_LIMIT_RULE_MAX_NUM             8
+/* max number of the callsite token buckets, the callsites are sharing them by hash */
+#define ELOG_RATE_LIMIT_CALLSITE_MAX_NUM         64
+/* the suppressed log number report interval (ms) */
+#define ELOG_RATE_LIMIT_REPORT_INTERVAL          5000
+/*---------------------------------------------------------------------------*/
+/* enable duplicate log suppression, the millisecond tick is got by elog_port_get_tick */
+//#define ELOG_DEDUP_ENABLE
+/* the repeated log is collapsed in the window (ms), 0: no limit */
+#define ELOG_DEDUP_WINDOW                        30000
+/*---------------------------------------------------------------------------*/
+/* enable hot reloadable configuration file, it's watched by inotify, so it's only for Linux */
+//#define ELOG_CONFIG_RELOAD_ENABLE
+/*---------------------------------------------------------------------------*/
+/* enable local control server on Unix domain socket, it's only for POSIX */
+//#define ELOG_CTL_ENABLE
+/* control server's default socket path */
+#define ELOG_CTL_PATH                            "/tmp/elog_ctl.sock"
+/* max number of the control commands which are registered by plugins and user */
+#define ELOG_CTL_CMD_MAX_NUM                     8
 
 #endif /* _ELOG_CFG_H_ */
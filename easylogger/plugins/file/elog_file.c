@@ -32,15 +32,281 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
 
 #include "elog_file.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <dirent.h>
+#include <ctype.h>
+#define ELOG_FILE_USING_FSTAT
+#endif
+
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+#ifndef ELOG_FILE_USING_FSTAT
+#error "The file descriptor backend is only supported on POSIX platform."
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+#ifndef ELOG_FILE_USING_FSTAT
+#error "The memory mapped file backend is only supported on POSIX platform."
+#endif
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+#error "The memory mapped file backend can't be used with the file descriptor backend."
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#ifdef ELOG_FILE_SHARED_RING_ENABLE
+/* the file is opened by the process which is writing it continuously, such as the ring writer */
+#define ELOG_FILE_MMAP_LAZY_OPEN
+#endif
+#endif
+
+#if defined(ELOG_FILE_FD_BACKEND_ENABLE) || defined(ELOG_FILE_MMAP_BACKEND_ENABLE)
+#define ELOG_FILE_USING_FD
+#endif
+
+#if defined(ELOG_FILE_FD_BACKEND_ENABLE) && !defined(ELOG_FILE_FLUSH_CACHE_ENABLE)
+/* the batching buffer is written on timeout by rotate worker, or by flush timer thread without the worker */
+#define ELOG_FILE_FD_TIMED_FLUSH
+#include <pthread.h>
+#endif
+
+#if defined(ELOG_FILE_SHARED_RING_ENABLE) && !defined(ELOG_FILE_USING_FSTAT)
+#error "The shared memory ring is only supported on POSIX platform."
+#endif
+
+#ifdef ELOG_FILE_DURABLE_ENABLE
+#ifndef ELOG_FILE_USING_FSTAT
+#error "The durability mode is only supported on POSIX platform."
+#endif
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+#ifndef ELOG_FILE_USING_FSTAT
+#error "The asynchronous rotation is only supported on POSIX platform."
+#endif
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+#ifndef ELOG_FILE_ROTATE_ASYNC_ENABLE
+#error "The rotated file compression needs the asynchronous rotation."
+#endif
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#endif
+
 #ifdef ELOG_FILE_ENABLE
 
+/* time based rotation period, ElogFilePeriod */
+#ifndef ELOG_FILE_ROTATE_PERIOD
+#define ELOG_FILE_ROTATE_PERIOD        ELOG_FILE_PERIOD_NONE
+#endif
+/* rotated file name suffix, ElogFileSuffix */
+#ifndef ELOG_FILE_ROTATE_SUFFIX
+#define ELOG_FILE_ROTATE_SUFFIX        ELOG_FILE_SUFFIX_INDEX
+#endif
+/* total size of all log files, 0: no limit */
+#ifndef ELOG_FILE_MAX_TOTAL_SIZE
+#define ELOG_FILE_MAX_TOTAL_SIZE       0
+#endif
+
+/* the cached file size will be synced from the file system after the interval (second), 0: only after open */
+#ifndef ELOG_FILE_SIZE_SYNC_INTERVAL
+#define ELOG_FILE_SIZE_SYNC_INTERVAL   1
+#endif
+
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+/* batching buffer size for file descriptor backend */
+#ifndef ELOG_FILE_FD_BUF_SIZE
+#define ELOG_FILE_FD_BUF_SIZE          (16 * 1024)
+#endif
+/* the batching buffer will be written after the interval (ms) since the first log is buffered */
+#ifndef ELOG_FILE_FD_FLUSH_INTERVAL
+#define ELOG_FILE_FD_FLUSH_INTERVAL    100
+#endif
+#endif /* ELOG_FILE_FD_BACKEND_ENABLE */
+
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+/* the file is allocated in chunk, the log is copied to mapping without lock when it's in the allocated size */
+#ifndef ELOG_FILE_MMAP_CHUNK_SIZE
+#define ELOG_FILE_MMAP_CHUNK_SIZE      (1024 * 1024)
+#endif
+/* the initial mapped size, it's doubled when the file is larger than it */
+#ifndef ELOG_FILE_MMAP_MAP_SIZE
+#define ELOG_FILE_MMAP_MAP_SIZE        (64 * 1024 * 1024)
+#endif
+#endif /* ELOG_FILE_MMAP_BACKEND_ENABLE */
+
+/* the default setting of writing the log as LZ4 frame stream */
+#ifndef ELOG_FILE_COMPRESS_STREAM
+#define ELOG_FILE_COMPRESS_STREAM      false
+#endif
+/* the compressed stream block will be written after the interval (ms) since the first log is buffered */
+#ifndef ELOG_FILE_COMPRESS_STREAM_INTERVAL
+#define ELOG_FILE_COMPRESS_STREAM_INTERVAL 1000
+#endif
+
+#ifdef ELOG_FILE_DURABLE_ENABLE
+/* the written log will be synced to disk after the interval (ms) */
+#ifndef ELOG_FILE_DURABLE_INTERVAL
+#define ELOG_FILE_DURABLE_INTERVAL     10
+#endif
+/* the written log will be synced to disk immediately when the unsynced size is more than it */
+#ifndef ELOG_FILE_DURABLE_BYTES
+#define ELOG_FILE_DURABLE_BYTES        (1024 * 1024)
+#endif
+#ifdef __APPLE__
+#define fdatasync                      fsync
+#endif
+#endif /* ELOG_FILE_DURABLE_ENABLE */
+
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+/* CPU usage percent limit for the rotated file compression */
+#ifndef ELOG_FILE_COMPRESS_CPU_PERCENT
+#define ELOG_FILE_COMPRESS_CPU_PERCENT 20
+#endif
+/* the rotated file is compressed after it's not modified for the time (second), other processes may still write it */
+#define ELOG_FILE_COMPRESS_SETTLE_TIME (ELOG_FILE_SIZE_SYNC_INTERVAL + 1)
+#endif /* ELOG_FILE_COMPRESS_ENABLE */
+
 /* initialize OK flag */
 static bool init_ok = false;
+#ifdef ELOG_FILE_USING_FD
+static int fd = -1;
+#else
 static FILE *fp = NULL;
+#endif
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+/* the buffer only contains the whole log, so each write always appends the whole log */
+static char fd_buf[ELOG_FILE_FD_BUF_SIZE] __attribute__((aligned(64)));
+static size_t fd_buf_len = 0;
+/* the time (ms) of first log in batching buffer */
+static long long fd_buf_time = 0;
+#endif
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+/* the flush timer is running, it's protected by file port lock */
+static bool fd_flush_timer = false;
+/* the batching buffer has log which is waiting for timed flush, it's protected by flush lock */
+static bool fd_flush_pending = false;
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+/* the rotate worker is the flush timer */
+#define fd_flush_lock                  rotate_lock
+#define fd_flush_notice                rotate_notice
+#else
+static bool flush_running = false;
+static pthread_t flush_thread;
+static pthread_mutex_t fd_flush_lock;
+static pthread_cond_t fd_flush_notice;
+
+static void flush_timer_start(void);
+static void flush_timer_stop(void);
+#endif /* ELOG_FILE_ROTATE_ASYNC_ENABLE */
+
+static void fd_flush_notify(void);
+#endif /* ELOG_FILE_FD_TIMED_FLUSH */
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+/* "ELOGMMAP" in little endian */
+#define MMAP_TRAILER_MAGIC             0x50414D4D474F4C45ULL
+/* it's at the end of allocated file, so the written offset is found when the process is crashed */
+typedef struct {
+    size_t offset;                     /* the next log offset in file */
+    uint64_t magic;
+} MmapTrailer;
+/* the whole file is mapped, the log is appended by bumping the offset atomically */
+static char *map_base = NULL;
+static size_t map_size = 0;
+/* the allocated file size without trailer for the writers without lock, it's 0 when the mapping is changing */
+static size_t map_cap = 0;
+/* the allocated file size, it's protected by file port lock */
+static size_t map_alloc = 0;
+/* the trailer in mapping, NULL: the file isn't allocated, the offset is the file size */
+static MmapTrailer *map_trailer = NULL;
+/* the time when the file will be rotated by period, the writers without lock check it */
+static time_t map_rotate_time = 0;
+/* the number of writers which are copying to mapping without lock */
+static int map_users = 0;
+#endif
 static ElogFileCfg local_cfg;
+/* the opened file path, it's the configured name with time or sequence suffix */
+static char file_path[256] = { 0 };
+/* the next sequence for sequence suffix */
+static unsigned long file_seq = 0;
+/* the time when the file will be rotated by period */
+static time_t file_rotate_time = 0;
+/* cached file size, it's increased by written size, so the file position is not checked on every write */
+static size_t file_size = 0;
+/* last sync time of the cached file size */
+static time_t file_size_sync_time = 0;
+/* the compressed stream block buffer, they are allocated when the compressed stream is enabled */
+static uint8_t *stream_buf = NULL;
+static uint8_t *stream_out = NULL;
+static size_t stream_len = 0;
+/* the time (ms) of first log in the compressed stream block buffer */
+static long long stream_time = 0;
+
+static void stream_start(void);
+static void stream_end(void);
+#ifdef ELOG_FILE_DURABLE_ENABLE
+/* the ticket is the total written size, the log is durable when its ticket is not more than synced ticket */
+static uint64_t written_ticket = 0;
+/* the written size which is not synced, it's protected by file port lock */
+static size_t unsynced_size = 0;
+/* the following variables are protected by durable lock */
+static uint64_t synced_ticket = 0;
+static bool durable_running = false;
+static pthread_t durable_thread;
+static pthread_mutex_t durable_lock;
+/* notify the flusher thread */
+static pthread_cond_t flusher_notice;
+/* notify the waiting thread after every sync */
+static pthread_cond_t synced_notice;
+/* the sink which outputs the log by elog_file_write, its queued log is written before the ticket is got */
+static ElogSink_t durable_sink = NULL;
+
+static void durable_start(void);
+static void durable_stop(void);
+static void durable_synced(uint64_t ticket);
+#endif /* ELOG_FILE_DURABLE_ENABLE */
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+/* the rotation sequence, it's the pending file name suffix, they are protected by rotate lock */
+static unsigned int rotate_seq = 0;
+static unsigned int rotate_done_seq = 0;
+static bool rotate_running = false;
+static pthread_t rotate_thread;
+static pthread_mutex_t rotate_lock;
+static pthread_cond_t rotate_notice;
+
+/* the retention will be done by worker */
+static bool retention_pending = false;
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+/* the rotated files will be compressed by worker */
+static bool compress_pending = false;
+#endif
+
+static void rotate_start(void);
+static void rotate_stop(void);
+#endif /* ELOG_FILE_ROTATE_ASYNC_ENABLE */
+
+static bool file_write_log(const char *log, size_t size);
+#ifdef ELOG_CTL_ENABLE
+static bool file_ctl_rotate(EasyLogger_t elog, char *arg);
+#endif
 
 ElogErrCode elog_file_init(void)
 {
@@ -50,132 +316,1823 @@ ElogErrCode elog_file_init(void)
     if (init_ok)
         goto __exit;
 
-    elog_file_port_init();
+    result = elog_file_port_init();
+    if (result != ELOG_NO_ERR)
+        goto __exit;
 
     cfg.name = ELOG_FILE_NAME;
     cfg.max_size = ELOG_FILE_MAX_SIZE;
     cfg.max_rotate = ELOG_FILE_MAX_ROTATE;
+    cfg.period = ELOG_FILE_ROTATE_PERIOD;
+    cfg.suffix = ELOG_FILE_ROTATE_SUFFIX;
+    cfg.max_total_size = ELOG_FILE_MAX_TOTAL_SIZE;
+    cfg.compress_stream = ELOG_FILE_COMPRESS_STREAM;
 
     elog_file_config(&cfg);
 
+#ifdef ELOG_FILE_DURABLE_ENABLE
+    durable_start();
+#endif
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+    rotate_start();
+#elif defined(ELOG_FILE_FD_TIMED_FLUSH)
+    flush_timer_start();
+#endif
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+    elog_file_port_lock();
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+    fd_flush_timer = rotate_running;
+#else
+    fd_flush_timer = flush_running;
+#endif
+    /* the log which is buffered when the file is opened */
+    if (fd_buf_len) {
+        fd_flush_notify();
+    }
+    elog_file_port_unlock();
+#endif /* ELOG_FILE_FD_TIMED_FLUSH */
+#ifdef ELOG_FILE_SHARED_RING_ENABLE
+    /* it falls back to write the file directly when the ring is unavailable */
+    elog_file_ring_init(local_cfg.name, file_write_log);
+#endif
+#ifdef ELOG_CTL_ENABLE
+    elog_ctl_cmd_register("rotate", "rotate the log file now", file_ctl_rotate);
+#endif
+
     init_ok = true;
 __exit:
     return result;
 }
 
-/*
- * rotate the log file xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0
- */
-static bool elog_file_rotate(void)
+static long long get_time_ms(void)
 {
-#define SUFFIX_LEN                     10
-    /* mv xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0 */
-    int n, err = 0;
-    char oldpath[256]= {0}, newpath[256] = {0};
-    size_t base = strlen(local_cfg.name);
-    bool result = true;
-    FILE *tmp_fp;
+#ifdef ELOG_FILE_USING_FSTAT
+    struct timespec ts;
 
-    memcpy(oldpath, local_cfg.name, base);
-    memcpy(newpath, local_cfg.name, base);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
 
-    fclose(fp);
+    return (long long) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#else
+    return (long long) time(NULL) * 1000;
+#endif
+}
 
-    for (n = local_cfg.max_rotate - 1; n >= 0; --n) {
-        snprintf(oldpath + base, SUFFIX_LEN, n ? ".%d" : "", n - 1);
-        snprintf(newpath + base, SUFFIX_LEN, ".%d", n);
-        /* remove the old file */
-        if ((tmp_fp = fopen(newpath , "r")) != NULL) {
-            fclose(tmp_fp);
-            remove(newpath);
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+/*
+ * Write all data by writev. The file is opened with O_APPEND, so the data in one writev is appended
+ * without interleaving with the other process. It's written again when it's partially written.
+ */
+static bool fd_write_all(struct iovec *iov, int iovcnt)
+{
+    ssize_t written;
+
+    while (iovcnt > 0) {
+        written = writev(fd, iov, iovcnt);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        /* skip the written data */
+        while (iovcnt > 0 && (size_t) written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            iovcnt--;
         }
-        /* change the new log file to old file name */
-        if ((tmp_fp = fopen(oldpath , "r")) != NULL) {
-            fclose(tmp_fp);
-            err = rename(oldpath, newpath);
+        if (iovcnt > 0) {
+            iov->iov_base = (char *) iov->iov_base + written;
+            iov->iov_len -= written;
         }
+    }
 
-        if (err < 0) {
-            result = false;
+    return true;
+}
+#endif /* ELOG_FILE_FD_BACKEND_ENABLE */
+
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+/*
+ * Copy the log to mapping without lock. The offset in trailer is bumped by CAS, so the log never
+ * exceeds the allocated size. The mapping is changed only when there is no writer in here.
+ *
+ * @return false: the allocated size isn't enough, or it's time to rotate
+ */
+static bool mmap_write(const char *log, size_t size)
+{
+    size_t cap, offset;
+    time_t rotate_time;
+    MmapTrailer *trailer;
+    char *base;
+    bool result = false;
+
+    __atomic_add_fetch(&map_users, 1, __ATOMIC_SEQ_CST);
+    /* the capacity is loaded before base, it's stored after base when the mapping is changed */
+    cap = __atomic_load_n(&map_cap, __ATOMIC_SEQ_CST);
+    base = __atomic_load_n(&map_base, __ATOMIC_SEQ_CST);
+    trailer = __atomic_load_n(&map_trailer, __ATOMIC_SEQ_CST);
+    rotate_time = __atomic_load_n(&map_rotate_time, __ATOMIC_SEQ_CST);
+    if (cap == 0 || (rotate_time && time(NULL) >= rotate_time)) {
+        goto __exit;
+    }
+    offset = __atomic_load_n(&trailer->offset, __ATOMIC_SEQ_CST);
+    do {
+        if (offset + size > cap) {
             goto __exit;
         }
-    }
+    } while (!__atomic_compare_exchange_n(&trailer->offset, &offset, offset + size, true, __ATOMIC_SEQ_CST,
+            __ATOMIC_SEQ_CST));
+    memcpy(base + offset, log, size);
+    result = true;
 
 __exit:
-    /* reopen the file */
-    fp = fopen(local_cfg.name, "a+");
+    __atomic_sub_fetch(&map_users, 1, __ATOMIC_SEQ_CST);
 
     return result;
 }
 
+/*
+ * stop the writers without lock, then the mapping can be changed
+ */
+static void mmap_quiesce(void)
+{
+    __atomic_store_n(&map_cap, 0, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&map_users, __ATOMIC_SEQ_CST)) {
+        sched_yield();
+    }
+}
 
-void elog_file_write(const char *log, size_t size)
+/*
+ * the next log offset in file, the file port lock must be held
+ */
+static size_t mmap_offset(void)
 {
-    size_t file_size = 0;
+    if (map_trailer == NULL) {
+        return map_alloc;
+    }
+    return __atomic_load_n(&map_trailer->offset, __ATOMIC_SEQ_CST);
+}
 
-    ELOG_ASSERT(init_ok);
-    ELOG_ASSERT(log);
-    if(fp == NULL) {
-    	return;
+/*
+ * Allocate the file chunks for the log, the file is remapped when it's larger than the mapped size.
+ * The trailer is moved to the new file end. The file port lock must be held.
+ */
+static bool mmap_extend(size_t size)
+{
+    size_t cap, new_size, offset;
+    MmapTrailer *trailer;
+    char *base;
+
+    cap = mmap_offset() + size + sizeof(MmapTrailer);
+    cap = (cap + ELOG_FILE_MMAP_CHUNK_SIZE - 1) / ELOG_FILE_MMAP_CHUNK_SIZE * ELOG_FILE_MMAP_CHUNK_SIZE;
+    if (cap < map_alloc) {
+        cap = map_alloc;
+    }
+    if (cap > map_alloc) {
+        /* the disk space is allocated, so the page writing won't get SIGBUS when the disk is full */
+#ifdef __APPLE__
+        if (ftruncate(fd, cap) != 0) {
+#else
+        if (posix_fallocate(fd, map_alloc, cap - map_alloc) != 0) {
+#endif
+            return false;
+        }
+    }
+    for (new_size = map_size; new_size < cap; new_size *= 2);
+    if (new_size != map_size || cap != map_alloc || map_trailer == NULL) {
+        mmap_quiesce();
+        offset = mmap_offset();
+        base = map_base;
+        if (new_size != map_size) {
+            base = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED) {
+                return false;
+            }
+            munmap(map_base, map_size);
+            map_size = new_size;
+            __atomic_store_n(&map_base, base, __ATOMIC_SEQ_CST);
+        }
+        /* the new trailer is written before the old one is cleared, so one of them is always valid */
+        trailer = (MmapTrailer *) (base + cap - sizeof(MmapTrailer));
+        trailer->offset = offset;
+        __atomic_store_n(&trailer->magic, MMAP_TRAILER_MAGIC, __ATOMIC_SEQ_CST);
+        if (map_trailer != NULL && cap != map_alloc) {
+            memset(base + map_alloc - sizeof(MmapTrailer), 0, sizeof(MmapTrailer));
+        }
+        map_alloc = cap;
+        __atomic_store_n(&map_trailer, trailer, __ATOMIC_SEQ_CST);
     }
+    __atomic_store_n(&map_cap, cap - sizeof(MmapTrailer), __ATOMIC_SEQ_CST);
 
-    elog_file_port_lock();
+    return true;
+}
 
-    fseek(fp, 0L, SEEK_END);
-    file_size = ftell(fp);
+/*
+ * Map the file, and the file is locked, so it's never mapped by other process at the same time.
+ * The file end is in the trailer when the allocated chunk isn't truncated by the crashed process,
+ * otherwise it's the file size.
+ */
+static bool mmap_open(void)
+{
+    struct stat st;
+    size_t size;
+    MmapTrailer *trailer;
+    char *base;
 
-    if (unlikely(file_size > local_cfg.max_size)) {
-#if ELOG_FILE_MAX_ROTATE > 0
-        if (!elog_file_rotate()) {
-            goto __exit;
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || fstat(fd, &st) != 0) {
+        return false;
+    }
+    for (size = ELOG_FILE_MMAP_MAP_SIZE; size < (size_t) st.st_size; size *= 2);
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    map_size = size;
+    map_alloc = st.st_size;
+    map_trailer = NULL;
+    /* the allocated file is always aligned to chunk */
+    if (map_alloc >= sizeof(MmapTrailer) && map_alloc % ELOG_FILE_MMAP_CHUNK_SIZE == 0) {
+        trailer = (MmapTrailer *) (base + map_alloc - sizeof(MmapTrailer));
+        if (trailer->magic == MMAP_TRAILER_MAGIC && trailer->offset <= map_alloc - sizeof(MmapTrailer)) {
+            map_trailer = trailer;
         }
+    }
+    __atomic_store_n(&map_base, base, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&map_rotate_time, file_rotate_time, __ATOMIC_SEQ_CST);
+    /* the trailer is created with the first chunk */
+    if (!mmap_extend(0)) {
+        munmap(map_base, map_size);
+        __atomic_store_n(&map_base, NULL, __ATOMIC_SEQ_CST);
+        return false;
+    }
+
+    return true;
+}
+
+static void mmap_close(void)
+{
+    size_t offset;
+
+    mmap_quiesce();
+    offset = mmap_offset();
+    munmap(map_base, map_size);
+    __atomic_store_n(&map_base, NULL, __ATOMIC_SEQ_CST);
+    map_trailer = NULL;
+    /* the unused allocated chunk and trailer are truncated, the trailer is kept when it's failed */
+    if (ftruncate(fd, offset) != 0) {
+        return;
+    }
+}
+#endif /* ELOG_FILE_MMAP_BACKEND_ENABLE */
+
+static bool file_is_open(void)
+{
+#ifdef ELOG_FILE_USING_FD
+    return fd >= 0;
 #else
-        goto __exit;
+    return fp != NULL;
+#endif
+}
+
+/*
+ * get the time when the file will be rotated by period
+ */
+static time_t get_rotate_time(time_t now)
+{
+    struct tm tm;
+
+    if (local_cfg.period == ELOG_FILE_PERIOD_NONE) {
+        return 0;
+    }
+#ifdef ELOG_FILE_USING_FSTAT
+    localtime_r(&now, &tm);
+#else
+    tm = *localtime(&now);
 #endif
+    tm.tm_sec = 0;
+    tm.tm_min = 0;
+    if (local_cfg.period == ELOG_FILE_PERIOD_DAILY) {
+        tm.tm_hour = 0;
+        tm.tm_mday++;
+    } else {
+        tm.tm_hour++;
     }
+    tm.tm_isdst = -1;
 
-    fwrite(log, size, 1, fp);
+    return mktime(&tm);
+}
 
-#ifdef ELOG_FILE_FLUSH_CACHE_ENABLE
+/*
+ * make the file path by the suffix, the time and sequence suffix file is a new file every time
+ */
+static void make_file_path(time_t now)
+{
+#ifdef ELOG_FILE_USING_FSTAT
+    static time_t last_time = 0;
+    static unsigned int last_n = 0;
+    struct stat st;
+    struct tm tm;
+    char time_str[20];
+    unsigned int n = 0;
+
+    switch (local_cfg.suffix) {
+    case ELOG_FILE_SUFFIX_TIME:
+        localtime_r(&now, &tm);
+        strftime(time_str, sizeof(time_str), "%Y%m%d-%H%M%S", &tm);
+        /* it's rotated more than once in one second, the number is still increasing when the older file is deleted */
+        if (now == last_time) {
+            n = last_n + 1;
+        }
+        for (;; n++) {
+            if (n == 0) {
+                snprintf(file_path, sizeof(file_path), "%s.%s", local_cfg.name, time_str);
+            } else {
+                snprintf(file_path, sizeof(file_path), "%s.%s-%u", local_cfg.name, time_str, n);
+            }
+            if (stat(file_path, &st) != 0 || n >= 1000) {
+                break;
+            }
+        }
+        last_time = now;
+        last_n = n;
+        return;
+    case ELOG_FILE_SUFFIX_SEQ:
+        snprintf(file_path, sizeof(file_path), "%s.%010lu", local_cfg.name, file_seq++);
+        return;
+    default:
+        break;
+    }
+#else
+    (void) now;
+#endif
+    snprintf(file_path, sizeof(file_path), "%s", local_cfg.name);
+}
+
+static void file_open(void)
+{
+    time_t now = time(NULL);
+
+    make_file_path(now);
+    file_rotate_time = get_rotate_time(now);
+#if defined(ELOG_FILE_FD_BACKEND_ENABLE)
+    fd = open(file_path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#elif defined(ELOG_FILE_MMAP_BACKEND_ENABLE)
+    fd = open(file_path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd >= 0 && !mmap_open()) {
+        close(fd);
+        fd = -1;
+    }
+#else
+    fp = fopen(file_path, "a+");
+#endif
+    if (stream_buf && file_is_open()) {
+        stream_start();
+    }
+}
+
+/*
+ * write the buffered log to file
+ */
+static void file_flush(void)
+{
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+    struct iovec iov;
+
+    if (fd_buf_len && fd >= 0) {
+        iov.iov_base = fd_buf;
+        iov.iov_len = fd_buf_len;
+        fd_write_all(&iov, 1);
+    }
+    fd_buf_len = 0;
+#elif defined(ELOG_FILE_MMAP_BACKEND_ENABLE)
+    /* the mapped pages are written back by kernel */
+#else
     fflush(fp);
 #endif
+}
 
-__exit:
-    elog_file_port_unlock();
+static void file_close(void)
+{
+    if (!file_is_open()) {
+        return;
+    }
+    if (stream_buf) {
+        stream_end();
+    }
+    file_flush();
+#ifdef ELOG_FILE_DURABLE_ENABLE
+    /* the log in the closed file can't be synced by flusher */
+#ifdef ELOG_FILE_USING_FD
+    fdatasync(fd);
+#else
+    fdatasync(fileno(fp));
+#endif
+    unsynced_size = 0;
+    durable_synced(written_ticket);
+#endif
+#ifdef ELOG_FILE_USING_FD
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+    mmap_close();
+#endif
+    close(fd);
+    fd = -1;
+#else
+    fclose(fp);
+    fp = NULL;
+#endif
 }
 
-void elog_file_deinit(void)
+/*
+ * write the log to file
+ *
+ * @return true: the whole log is written or buffered
+ */
+static bool file_write(const char *log, size_t size)
 {
-    ELOG_ASSERT(init_ok);
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+    struct iovec iov[2];
+    bool result = true;
 
-    ElogFileCfg cfg = {NULL, 0, 0};
+    if (likely(fd_buf_len + size <= ELOG_FILE_FD_BUF_SIZE)) {
+        if (fd_buf_len == 0) {
+            fd_buf_time = get_time_ms();
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+            /* the buffer will be written by flush timer when there is no more log */
+            fd_flush_notify();
+#endif
+        }
+        memcpy(fd_buf + fd_buf_len, log, size);
+        fd_buf_len += size;
+    } else {
+        /* write the buffered log and this log together, the log isn't copied */
+        iov[0].iov_base = fd_buf;
+        iov[0].iov_len = fd_buf_len;
+        iov[1].iov_base = (void *) log;
+        iov[1].iov_len = size;
+        result = fd_write_all(fd_buf_len ? iov : iov + 1, fd_buf_len ? 2 : 1);
+        fd_buf_len = 0;
+    }
+#ifdef ELOG_FILE_FLUSH_CACHE_ENABLE
+    file_flush();
+#else
+    if (fd_buf_len && get_time_ms() - fd_buf_time >= ELOG_FILE_FD_FLUSH_INTERVAL) {
+        file_flush();
+    }
+#endif
 
-    elog_file_config(&cfg);
+    return result;
+#elif defined(ELOG_FILE_MMAP_BACKEND_ENABLE)
+    /* the other writers may use the allocated chunk at the same time, so it's tried again */
+    while (!mmap_write(log, size)) {
+        if (!mmap_extend(size)) {
+            return false;
+        }
+    }
 
-    elog_file_port_deinit();
+    return true;
+#else
+    bool result = fwrite(log, size, 1, fp) == 1;
 
-    init_ok = false;
+#ifdef ELOG_FILE_FLUSH_CACHE_ENABLE
+    fflush(fp);
+#endif
+
+    return result;
+#endif /* ELOG_FILE_FD_BACKEND_ENABLE */
 }
 
-void elog_file_config(ElogFileCfg *cfg)
+/*
+ * sync the cached file size from the file system, the other process maybe append the file too
+ */
+static void elog_file_sync_size(void)
 {
-    elog_file_port_lock();
+#ifdef ELOG_FILE_USING_FSTAT
+    struct stat st, path_st;
+#else
+    long pos;
+#endif
 
-    if (fp) {
-        fclose(fp);
-        fp = NULL;
+    file_size = 0;
+    file_size_sync_time = time(NULL);
+    if (!file_is_open()) {
+        return;
+    }
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+    /* the mapped file is locked, it isn't written by other process */
+    file_size = mmap_offset();
+    (void) st;
+    (void) path_st;
+#else
+#ifdef ELOG_FILE_USING_FSTAT
+    /* reopen the file when it's rotated by other process */
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+    if (local_cfg.suffix == ELOG_FILE_SUFFIX_INDEX && fstat(fd, &st) == 0 && (stat(file_path, &path_st) != 0
+#else
+    if (local_cfg.suffix == ELOG_FILE_SUFFIX_INDEX && fstat(fileno(fp), &st) == 0 && (stat(file_path, &path_st) != 0
+#endif
+            || st.st_ino != path_st.st_ino || st.st_dev != path_st.st_dev)) {
+        file_close();
+        file_open();
+        if (!file_is_open()) {
+            return;
+        }
+    }
+#endif /* ELOG_FILE_USING_FSTAT */
+#ifdef ELOG_FILE_FD_BACKEND_ENABLE
+    /* the buffered log is counted in file size */
+    if (fstat(fd, &st) == 0) {
+        file_size = st.st_size + fd_buf_len;
+    }
+#else
+    /* the data in stdio buffer isn't in the file size */
+    fflush(fp);
+#ifdef ELOG_FILE_USING_FSTAT
+    if (fstat(fileno(fp), &st) == 0) {
+        file_size = st.st_size;
+    }
+#else
+    fseek(fp, 0L, SEEK_END);
+    if ((pos = ftell(fp)) > 0) {
+        file_size = pos;
     }
+#endif
+#endif /* ELOG_FILE_FD_BACKEND_ENABLE */
+#endif /* ELOG_FILE_MMAP_BACKEND_ENABLE */
+}
 
-    if (cfg != NULL) {
-        local_cfg.name = cfg->name;
-        local_cfg.max_size = cfg->max_size;
-        local_cfg.max_rotate = cfg->max_rotate;
+/*
+ * compress the buffered log as one LZ4 frame block and write it
+ */
+static void stream_flush(void)
+{
+    size_t size;
 
-        if (local_cfg.name != NULL && strlen(local_cfg.name) > 0)
-            fp = fopen(local_cfg.name, "a+");
+    if (stream_len == 0) {
+        return;
     }
+    size = elog_lz4_frame_block(stream_buf, stream_len, stream_out);
+    stream_len = 0;
+    if (likely(file_write((const char *) stream_out, size))) {
+        file_size += size;
+    }
+}
 
-    elog_file_port_unlock();
+/*
+ * buffer the log in the compressed stream block, the block is written when it's full or timeout
+ */
+static void stream_write(const char *log, size_t size)
+{
+    size_t len;
+
+    while (size) {
+        if (stream_len == 0) {
+            stream_time = get_time_ms();
+        }
+        len = ELOG_LZ4_BLOCK_SIZE - stream_len;
+        if (len > size) {
+            len = size;
+        }
+        memcpy(stream_buf + stream_len, log, len);
+        stream_len += len;
+        log += len;
+        size -= len;
+        if (stream_len == ELOG_LZ4_BLOCK_SIZE) {
+            stream_flush();
+        }
+    }
+    if (stream_len && get_time_ms() - stream_time >= ELOG_FILE_COMPRESS_STREAM_INTERVAL) {
+        stream_flush();
+    }
+}
+
+/*
+ * Start a new LZ4 frame in the opened file. The frame isn't ended when the process is crashed, so the
+ * last frame is ended before the new frame. The frames are concatenated in one file.
+ */
+static void stream_start(void)
+{
+    static const uint8_t end_mark[ELOG_LZ4_FRAME_END_SIZE] = { 0 };
+    uint8_t buf[ELOG_LZ4_FRAME_END_SIZE + ELOG_LZ4_FRAME_HEADER_SIZE], last[ELOG_LZ4_FRAME_END_SIZE];
+    size_t size = 0;
+    FILE *file;
+
+    if ((file = fopen(file_path, "rb")) != NULL) {
+        if (fseek(file, -(long) sizeof(last), SEEK_END) == 0 && fread(last, sizeof(last), 1, file) == 1
+                && memcmp(last, end_mark, sizeof(last))) {
+            size = elog_lz4_frame_end(buf);
+        }
+        fclose(file);
+    }
+    size += elog_lz4_frame_header(buf + size);
+    file_write((const char *) buf, size);
+}
+
+/*
+ * write the buffered log and end the LZ4 frame before the file is closed
+ */
+static void stream_end(void)
+{
+    uint8_t buf[ELOG_LZ4_FRAME_END_SIZE];
+
+    stream_flush();
+    file_write((const char *) buf, elog_lz4_frame_end(buf));
+}
+
+/*
+ * rename the file, the new file will be replaced when it's exist
+ *
+ * @return 0: success or the old file isn't exist
+ */
+static int rename_replace(const char *oldpath, const char *newpath)
+{
+#ifndef ELOG_FILE_USING_FSTAT
+    /* the rename will fail when new file is exist on some platform */
+    remove(newpath);
+#endif
+    if (rename(oldpath, newpath) < 0 && errno != ENOENT) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Shift the rotated files xxx.log.n-1 => xxx.log.n, then move the file to xxx.log.0.
+ * The renaming is replacing the target, so the file isn't probed by opening.
+ */
+static bool rotate_generations(const char *name, int max_rotate, const char *file)
+{
+#define SUFFIX_LEN                     16
+    int n;
+    char oldpath[256]= {0}, newpath[256] = {0};
+    size_t base = strlen(name);
+
+    if (max_rotate <= 0) {
+        return true;
+    }
+    if (base + SUFFIX_LEN > sizeof(oldpath)) {
+        return false;
+    }
+    memcpy(oldpath, name, base);
+    memcpy(newpath, name, base);
+
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+    /* the generation may be compressed or not, so the oldest one is deleted instead of replacing */
+    snprintf(oldpath + base, SUFFIX_LEN, ".%d", max_rotate - 1);
+    remove(oldpath);
+    snprintf(oldpath + base, SUFFIX_LEN, ".%d.lz4", max_rotate - 1);
+    remove(oldpath);
+#endif
+
+    for (n = max_rotate - 1; n > 0; --n) {
+        snprintf(oldpath + base, SUFFIX_LEN, ".%d", n - 1);
+        snprintf(newpath + base, SUFFIX_LEN, ".%d", n);
+        if (rename_replace(oldpath, newpath) < 0) {
+            return false;
+        }
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+        snprintf(oldpath + base, SUFFIX_LEN, ".%d.lz4", n - 1);
+        snprintf(newpath + base, SUFFIX_LEN, ".%d.lz4", n);
+        if (rename_replace(oldpath, newpath) < 0) {
+            return false;
+        }
+#endif
+    }
+    snprintf(newpath + base, SUFFIX_LEN, ".0");
+
+    return rename_replace(file, newpath) == 0;
+}
+
+#ifdef ELOG_FILE_USING_FSTAT
+/* the log file which is found in log directory */
+typedef struct {
+    char *path;
+    size_t size;
+    time_t mtime;
+} LogFileInfo;
+
+/*
+ * Get all log files which name is beginning with "name.", the pending file is excluded.
+ *
+ * @param name configured file name
+ * @param files all log files, it must be freed by free_log_files
+ *
+ * @return log file number
+ */
+static size_t get_log_files(const char *name, LogFileInfo **files)
+{
+    char dir_path[256], path[512];
+    const char *base = strrchr(name, '/');
+    size_t base_len, num = 0, capacity = 0;
+    LogFileInfo *list = NULL, *tmp;
+    struct dirent *ent;
+    struct stat st;
+    DIR *dir;
+
+    *files = NULL;
+    if (base) {
+        snprintf(dir_path, sizeof(dir_path), "%.*s", (int) (base - name), name);
+        if (dir_path[0] == '\0') {
+            strcpy(dir_path, "/");
+        }
+        base++;
+    } else {
+        strcpy(dir_path, ".");
+        base = name;
+    }
+    base_len = strlen(base);
+    if ((dir = opendir(dir_path)) == NULL) {
+        return 0;
+    }
+    while ((ent = readdir(dir)) != NULL) {
+        if (strncmp(ent->d_name, base, base_len) || ent->d_name[base_len] != '.'
+                || strstr(ent->d_name + base_len, ".pending.")) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dir_path, ent->d_name);
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        if (num == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            if ((tmp = realloc(list, capacity * sizeof(LogFileInfo))) == NULL) {
+                break;
+            }
+            list = tmp;
+        }
+        if ((list[num].path = strdup(path)) == NULL) {
+            break;
+        }
+        list[num].size = st.st_size;
+        list[num].mtime = st.st_mtime;
+        num++;
+    }
+    closedir(dir);
+    *files = list;
+
+    return num;
+}
+
+static void free_log_files(LogFileInfo *files, size_t num)
+{
+    while (num--) {
+        free(files[num].path);
+    }
+    free(files);
+}
+
+/*
+ * Compare the log file path, the digits are compared by number value, such as xxx.log.9 < xxx.log.10.
+ * The modification time isn't used, it's same for the files which are rotated in one second.
+ */
+static int log_file_cmp(const void *a, const void *b)
+{
+    const char *x = ((const LogFileInfo *) a)->path, *y = ((const LogFileInfo *) b)->path;
+    size_t x_len, y_len;
+    int result;
+
+    while (*x && *y) {
+        if (isdigit((unsigned char) *x) && isdigit((unsigned char) *y)) {
+            while (*x == '0') x++;
+            while (*y == '0') y++;
+            for (x_len = 0; isdigit((unsigned char) x[x_len]); x_len++);
+            for (y_len = 0; isdigit((unsigned char) y[y_len]); y_len++);
+            if (x_len != y_len) {
+                return x_len < y_len ? -1 : 1;
+            }
+            if ((result = strncmp(x, y, x_len)) != 0) {
+                return result;
+            }
+            x += x_len;
+            y += y_len;
+        } else if (*x != *y) {
+            return (unsigned char) *x - (unsigned char) *y;
+        } else {
+            x++;
+            y++;
+        }
+    }
+    return (unsigned char) *x - (unsigned char) *y;
+}
+
+/* sort the index suffix files from oldest to newest, the bigger index is older */
+static int log_file_index_cmp(const void *a, const void *b)
+{
+    return log_file_cmp(b, a);
+}
+
+/* sort the log files from oldest to newest */
+static void sort_log_files(LogFileInfo *files, size_t num)
+{
+    if (num > 1) {
+        qsort(files, num, sizeof(LogFileInfo),
+                local_cfg.suffix == ELOG_FILE_SUFFIX_INDEX ? log_file_index_cmp : log_file_cmp);
+    }
+}
+
+static const char *get_base_name(const char *path)
+{
+    const char *base = strrchr(path, '/');
+
+    return base ? base + 1 : path;
+}
+
+/*
+ * get the max sequence in the exist sequence suffix files, so the sequence is still increasing after restart
+ */
+static unsigned long get_max_file_seq(void)
+{
+    LogFileInfo *files;
+    size_t num = get_log_files(local_cfg.name, &files), i;
+    size_t name_len = strlen(get_base_name(local_cfg.name));
+    unsigned long seq, max = 0;
+    const char *suffix;
+    char *end;
+
+    for (i = 0; i < num; i++) {
+        /* the suffix is after "name.", it may be compressed */
+        suffix = get_base_name(files[i].path) + name_len + 1;
+        seq = strtoul(suffix, &end, 10);
+        if (isdigit((unsigned char) *suffix) && (*end == '\0' || !strcmp(end, ".lz4")) && seq >= max) {
+            max = seq + 1;
+        }
+    }
+    free_log_files(files, num);
+
+    return max;
+}
+
+/*
+ * Delete the oldest log files when the total size is more than the max total size, or the time and
+ * sequence suffix files number is more than the max rotate. The opening file is never deleted.
+ */
+static void file_retention(const char *opening)
+{
+    LogFileInfo *files;
+    size_t num, i, total = 0, old_num = 0;
+    bool limit_num = local_cfg.suffix != ELOG_FILE_SUFFIX_INDEX && local_cfg.max_rotate > 0;
+    struct stat st;
+
+    if (local_cfg.max_total_size == 0 && !limit_num) {
+        return;
+    }
+
+    num = get_log_files(local_cfg.name, &files);
+    sort_log_files(files, num);
+    for (i = 0; i < num; i++) {
+        total += files[i].size;
+        if (strcmp(get_base_name(files[i].path), get_base_name(opening))) {
+            old_num++;
+        }
+    }
+    /* the index suffix opening file isn't in the list */
+    if (local_cfg.suffix == ELOG_FILE_SUFFIX_INDEX && stat(opening, &st) == 0) {
+        total += st.st_size;
+    }
+    for (i = 0; i < num; i++) {
+        if ((local_cfg.max_total_size == 0 || total <= local_cfg.max_total_size)
+                && (!limit_num || old_num <= (size_t) local_cfg.max_rotate)) {
+            break;
+        }
+        if (!strcmp(get_base_name(files[i].path), get_base_name(opening))) {
+            continue;
+        }
+        if (remove(files[i].path) == 0) {
+            total -= files[i].size;
+            old_num--;
+        }
+    }
+    free_log_files(files, num);
+}
+#endif /* ELOG_FILE_USING_FSTAT */
+
+#if defined(ELOG_FILE_DURABLE_ENABLE) || defined(ELOG_FILE_ROTATE_ASYNC_ENABLE) || defined(ELOG_FILE_FD_TIMED_FLUSH)
+static void get_deadline(struct timespec *ts, long timeout_ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout_ms / 1000;
+    ts->tv_nsec += (timeout_ms % 1000) * 1000000;
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+#endif
+
+#if defined(ELOG_FILE_ROTATE_ASYNC_ENABLE) || defined(ELOG_FILE_FD_TIMED_FLUSH)
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+/*
+ * get the timed flush checking interval (ms) for the compressed stream block and the batching buffer
+ */
+static long get_timed_flush_interval(void)
+{
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+    if (fd_flush_pending && (!local_cfg.compress_stream
+            || ELOG_FILE_FD_FLUSH_INTERVAL < ELOG_FILE_COMPRESS_STREAM_INTERVAL)) {
+        return ELOG_FILE_FD_FLUSH_INTERVAL;
+    }
+#endif
+
+    return ELOG_FILE_COMPRESS_STREAM_INTERVAL;
+}
+#endif /* ELOG_FILE_ROTATE_ASYNC_ENABLE */
+
+/*
+ * write the compressed stream block and the batching buffer which are timeout, the file port lock must be held
+ *
+ * @return true: the batching buffer still has log which is not timeout
+ */
+static bool file_timed_flush(void)
+{
+    long long now = get_time_ms();
+
+    if (!file_is_open()) {
+        return false;
+    }
+    if (stream_len && now - stream_time >= ELOG_FILE_COMPRESS_STREAM_INTERVAL) {
+        stream_flush();
+        file_flush();
+    }
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+    if (fd_buf_len && now - fd_buf_time >= ELOG_FILE_FD_FLUSH_INTERVAL) {
+        file_flush();
+    }
+
+    return fd_buf_len != 0;
+#else
+    return false;
+#endif
+}
+#endif /* defined(ELOG_FILE_ROTATE_ASYNC_ENABLE) || defined(ELOG_FILE_FD_TIMED_FLUSH) */
+
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+/*
+ * notify the flush timer that the batching buffer has log, the file port lock must be held
+ */
+static void fd_flush_notify(void)
+{
+    if (!fd_flush_timer) {
+        return;
+    }
+    pthread_mutex_lock(&fd_flush_lock);
+    if (!fd_flush_pending) {
+        fd_flush_pending = true;
+        pthread_cond_signal(&fd_flush_notice);
+    }
+    pthread_mutex_unlock(&fd_flush_lock);
+}
+#endif /* ELOG_FILE_FD_TIMED_FLUSH */
+
+#if defined(ELOG_FILE_FD_TIMED_FLUSH) && !defined(ELOG_FILE_ROTATE_ASYNC_ENABLE)
+/*
+ * flush timer thread, it writes the batching buffer on timeout when the rotate worker is disabled
+ */
+static void *flush_timer(void *arg)
+{
+    struct timespec ts;
+    bool remaining;
+
+    (void) arg;
+
+    pthread_mutex_lock(&fd_flush_lock);
+    while (flush_running) {
+        if (fd_flush_pending) {
+            get_deadline(&ts, ELOG_FILE_FD_FLUSH_INTERVAL);
+            if (pthread_cond_timedwait(&fd_flush_notice, &fd_flush_lock, &ts) == ETIMEDOUT) {
+                fd_flush_pending = false;
+                pthread_mutex_unlock(&fd_flush_lock);
+
+                elog_file_port_lock();
+                remaining = file_timed_flush();
+                elog_file_port_unlock();
+
+                pthread_mutex_lock(&fd_flush_lock);
+                fd_flush_pending = fd_flush_pending || remaining;
+            }
+        } else {
+            pthread_cond_wait(&fd_flush_notice, &fd_flush_lock);
+        }
+    }
+    pthread_mutex_unlock(&fd_flush_lock);
+
+    return NULL;
+}
+
+static void flush_timer_start(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(&fd_flush_lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&fd_flush_notice, &attr);
+    pthread_condattr_destroy(&attr);
+    flush_running = true;
+    if (pthread_create(&flush_thread, NULL, flush_timer, NULL) != 0) {
+        flush_running = false;
+    }
+}
+
+static void flush_timer_stop(void)
+{
+    pthread_mutex_lock(&fd_flush_lock);
+    if (!flush_running) {
+        pthread_mutex_unlock(&fd_flush_lock);
+        return;
+    }
+    flush_running = false;
+    pthread_cond_signal(&fd_flush_notice);
+    pthread_mutex_unlock(&fd_flush_lock);
+
+    pthread_join(flush_thread, NULL);
+}
+#endif /* defined(ELOG_FILE_FD_TIMED_FLUSH) && !defined(ELOG_FILE_ROTATE_ASYNC_ENABLE) */
+
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+/* the pending file name when the file is waiting for rotating, the process ID is used for sharing file */
+static void get_pending_name(char *path, size_t size, unsigned int seq)
+{
+    snprintf(path, size, "%s.pending.%ld.%u", local_cfg.name, (long) getpid(), seq);
+}
+
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+/* the compression is interrupted when the rotation is pending or the worker is stopping */
+static bool compress_interrupted(void)
+{
+    bool result;
+
+    pthread_mutex_lock(&rotate_lock);
+    result = !rotate_running || rotate_done_seq != rotate_seq;
+    pthread_mutex_unlock(&rotate_lock);
+
+    return result;
+}
+
+static long long get_thread_cpu_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/*
+ * Compress the file to xxx.lz4 then delete it. The CPU usage is limited by sleeping after every block.
+ *
+ * @return false: it's interrupted or failed
+ */
+static bool compress_file(const char *path)
+{
+    char lz4_path[256 + 8], tmp_path[256 + 40];
+    uint8_t *raw, *buf;
+    FILE *src = NULL, *dst = NULL;
+    bool result = false;
+    long long cpu_ns;
+    struct timespec ts;
+    size_t size;
+
+    snprintf(lz4_path, sizeof(lz4_path), "%s.lz4", path);
+    snprintf(tmp_path, sizeof(tmp_path), "%s.lz4.tmp.%ld", path, (long) getpid());
+    raw = malloc(ELOG_LZ4_BLOCK_SIZE);
+    buf = malloc(ELOG_LZ4_BLOCK_BOUND(ELOG_LZ4_BLOCK_SIZE));
+    if (raw == NULL || buf == NULL || (src = fopen(path, "rb")) == NULL || (dst = fopen(tmp_path, "wb")) == NULL) {
+        goto __exit;
+    }
+
+    size = elog_lz4_frame_header(buf);
+    if (fwrite(buf, 1, size, dst) != size) {
+        goto __exit;
+    }
+    for (;;) {
+        cpu_ns = get_thread_cpu_ns();
+        if ((size = fread(raw, 1, ELOG_LZ4_BLOCK_SIZE, src)) == 0) {
+            break;
+        }
+        size = elog_lz4_frame_block(raw, size, buf);
+        if (fwrite(buf, 1, size, dst) != size) {
+            goto __exit;
+        }
+#if ELOG_FILE_COMPRESS_CPU_PERCENT < 100
+        cpu_ns = (get_thread_cpu_ns() - cpu_ns) * (100 - ELOG_FILE_COMPRESS_CPU_PERCENT) / ELOG_FILE_COMPRESS_CPU_PERCENT;
+        ts.tv_sec = cpu_ns / 1000000000LL;
+        ts.tv_nsec = cpu_ns % 1000000000LL;
+        nanosleep(&ts, NULL);
+#else
+        (void) ts;
+#endif
+        if (compress_interrupted()) {
+            goto __exit;
+        }
+    }
+    size = elog_lz4_frame_end(buf);
+    if (ferror(src) || fwrite(buf, 1, size, dst) != size || fflush(dst) != 0 || fsync(fileno(dst)) != 0) {
+        goto __exit;
+    }
+    result = true;
+
+__exit:
+    if (src) {
+        fclose(src);
+    }
+    if (dst && fclose(dst) != 0) {
+        result = false;
+    }
+    /* the original file is deleted after the compressed file is completed */
+    if (result && rename(tmp_path, lz4_path) == 0) {
+        remove(path);
+    } else {
+        remove(tmp_path);
+        result = false;
+    }
+    free(raw);
+    free(buf);
+
+    return result;
+}
+
+/*
+ * Compress the rotated files from oldest to newest, the opening file and compressed files are skipped.
+ *
+ * @return true: some files are still waiting for compression
+ */
+static bool compress_files(void)
+{
+    LogFileInfo *files;
+    char opening[sizeof(file_path)];
+    const char *base;
+    size_t num, i, name_len;
+    bool remaining = false;
+
+    /* the compressed stream file needn't be compressed again */
+    if (local_cfg.name == NULL || local_cfg.compress_stream) {
+        return false;
+    }
+    elog_file_port_lock();
+    strcpy(opening, file_path);
+    elog_file_port_unlock();
+
+    name_len = strlen(get_base_name(local_cfg.name));
+    num = get_log_files(local_cfg.name, &files);
+    sort_log_files(files, num);
+    for (i = 0; i < num; i++) {
+        base = get_base_name(files[i].path);
+        if (strstr(base + name_len, ".lz4") || !strcmp(base, get_base_name(opening))) {
+            continue;
+        }
+        if (time(NULL) - files[i].mtime < ELOG_FILE_COMPRESS_SETTLE_TIME) {
+            remaining = true;
+            continue;
+        }
+        if (!compress_file(files[i].path)) {
+            remaining = true;
+            break;
+        }
+    }
+    free_log_files(files, num);
+
+    return remaining;
+}
+#endif /* ELOG_FILE_COMPRESS_ENABLE */
+
+/*
+ * Rotate worker thread. The writing thread only renames the file to pending name and opens new file,
+ * then the rotated files will be renamed by the worker. The oldest files are deleted by the worker too.
+ * The compressed stream block and the batching buffer are written by the worker when they are timeout.
+ */
+static void *rotate_worker(void *arg)
+{
+    char pending[256], opening[sizeof(file_path)];
+    unsigned int seq;
+    struct timespec ts;
+    bool remaining;
+
+    (void) arg;
+
+#if defined(ELOG_FILE_COMPRESS_ENABLE) && defined(__linux__)
+    /* the compression is running at the lowest priority, the nice value is for every thread on Linux */
+    setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), 19);
+#endif
+
+    pthread_mutex_lock(&rotate_lock);
+    while (rotate_running || rotate_done_seq != rotate_seq || retention_pending) {
+        if (rotate_done_seq != rotate_seq) {
+            seq = rotate_done_seq;
+            pthread_mutex_unlock(&rotate_lock);
+
+            get_pending_name(pending, sizeof(pending), seq);
+            /* the pending file is kept when it's failed */
+            rotate_generations(local_cfg.name, local_cfg.max_rotate, pending);
+
+            pthread_mutex_lock(&rotate_lock);
+            rotate_done_seq++;
+        } else if (retention_pending) {
+            retention_pending = false;
+            pthread_mutex_unlock(&rotate_lock);
+
+            elog_file_port_lock();
+            strcpy(opening, file_path);
+            elog_file_port_unlock();
+            file_retention(opening);
+
+            pthread_mutex_lock(&rotate_lock);
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+        } else if (compress_pending && rotate_running) {
+            compress_pending = false;
+            pthread_mutex_unlock(&rotate_lock);
+
+            remaining = compress_files();
+
+            pthread_mutex_lock(&rotate_lock);
+            if (remaining) {
+                compress_pending = true;
+                /* retry after the recently modified file is settled */
+                if (rotate_running && rotate_done_seq == rotate_seq && !retention_pending) {
+                    get_deadline(&ts, 1000);
+                    pthread_cond_timedwait(&rotate_notice, &rotate_lock, &ts);
+                }
+            }
+#endif
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+        } else if (local_cfg.compress_stream || fd_flush_pending) {
+#else
+        } else if (local_cfg.compress_stream) {
+#endif
+            /* the compressed stream block and the batching buffer are written on timeout when there is no more log */
+            get_deadline(&ts, get_timed_flush_interval());
+            if (pthread_cond_timedwait(&rotate_notice, &rotate_lock, &ts) == ETIMEDOUT) {
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+                fd_flush_pending = false;
+#endif
+                pthread_mutex_unlock(&rotate_lock);
+
+                elog_file_port_lock();
+                remaining = file_timed_flush();
+                elog_file_port_unlock();
+
+                pthread_mutex_lock(&rotate_lock);
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+                fd_flush_pending = fd_flush_pending || remaining;
+#else
+                (void) remaining;
+#endif
+            }
+        } else {
+            pthread_cond_wait(&rotate_notice, &rotate_lock);
+        }
+    }
+    pthread_mutex_unlock(&rotate_lock);
+
+    return NULL;
+}
+
+static void rotate_start(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(&rotate_lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&rotate_notice, &attr);
+    pthread_condattr_destroy(&attr);
+    rotate_seq = rotate_done_seq = 0;
+    rotate_running = true;
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+    /* the files which are rotated before are compressed too */
+    compress_pending = true;
+#endif
+    if (pthread_create(&rotate_thread, NULL, rotate_worker, NULL) != 0) {
+        rotate_running = false;
+    }
+}
+
+static void rotate_stop(void)
+{
+    pthread_mutex_lock(&rotate_lock);
+    if (!rotate_running) {
+        pthread_mutex_unlock(&rotate_lock);
+        return;
+    }
+    /* the pending rotation will be finished before the worker exits */
+    rotate_running = false;
+    pthread_cond_signal(&rotate_notice);
+    pthread_mutex_unlock(&rotate_lock);
+
+    pthread_join(rotate_thread, NULL);
+}
+#endif /* ELOG_FILE_ROTATE_ASYNC_ENABLE */
+
+/*
+ * Delete the oldest log files on rotate worker, it's deleted directly when the worker is not running.
+ * The rotated files are compressed by the worker too.
+ */
+static void elog_file_retention(void)
+{
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+    if (rotate_running) {
+        pthread_mutex_lock(&rotate_lock);
+        retention_pending = true;
+#ifdef ELOG_FILE_COMPRESS_ENABLE
+        compress_pending = true;
+#endif
+        pthread_cond_signal(&rotate_notice);
+        pthread_mutex_unlock(&rotate_lock);
+        return;
+    }
+#endif
+#ifdef ELOG_FILE_USING_FSTAT
+    file_retention(file_path);
+#endif
+}
+
+/*
+ * Rotate the log file xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0.
+ * The time and sequence suffix file is not renamed, a new file is opened.
+ */
+static bool file_rotate(void)
+{
+    bool result = true;
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+    char pending[256];
+#endif
+
+    file_close();
+
+#ifdef ELOG_FILE_USING_FSTAT
+    if (local_cfg.suffix != ELOG_FILE_SUFFIX_INDEX) {
+        goto __exit;
+    }
+#endif
+
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+    if (rotate_running && local_cfg.max_rotate > 0) {
+        /* only rename the file on writing thread, the writer will keep going on the new file */
+        get_pending_name(pending, sizeof(pending), rotate_seq);
+        if (rename(local_cfg.name, pending) == 0) {
+            pthread_mutex_lock(&rotate_lock);
+            rotate_seq++;
+            pthread_cond_signal(&rotate_notice);
+            pthread_mutex_unlock(&rotate_lock);
+        } else if (errno != ENOENT) {
+            result = false;
+        }
+        goto __exit;
+    }
+#endif
+
+    result = rotate_generations(local_cfg.name, local_cfg.max_rotate, local_cfg.name);
+
+#if defined(ELOG_FILE_ROTATE_ASYNC_ENABLE) || defined(ELOG_FILE_USING_FSTAT)
+__exit:
+#endif
+    /* reopen the file */
+    file_open();
+    elog_file_sync_size();
+    elog_file_retention();
+
+    return result;
+}
+
+
+/*
+ * append the log to file, the file port lock must be held
+ */
+static void file_append(const char *log, size_t size)
+{
+    time_t now = time(NULL);
+
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+    /* the log which is written without lock is counted */
+    file_size = mmap_offset();
+#endif
+
+#if ELOG_FILE_SIZE_SYNC_INTERVAL > 0
+    if (unlikely(now - file_size_sync_time >= ELOG_FILE_SIZE_SYNC_INTERVAL)) {
+        elog_file_sync_size();
+    }
+#endif
+
+    if (unlikely((local_cfg.max_size && file_size > local_cfg.max_size)
+            || (file_rotate_time && now >= file_rotate_time))) {
+        /* the index suffix file can't be rotated without rotate file */
+        if (local_cfg.suffix == ELOG_FILE_SUFFIX_INDEX && local_cfg.max_rotate <= 0) {
+            return;
+        }
+        if (!file_rotate()) {
+            return;
+        }
+    }
+
+    if (unlikely(!file_is_open())) {
+        return;
+    }
+
+    if (stream_buf) {
+        /* the compressed size is counted when the block is written */
+        stream_write(log, size);
+    } else if (likely(file_write(log, size))) {
+        file_size += size;
+    } else {
+        /* the written size is unknown */
+        elog_file_sync_size();
+    }
+
+#ifdef ELOG_FILE_DURABLE_ENABLE
+    written_ticket += size;
+    unsynced_size += size;
+    if (unlikely(unsynced_size >= ELOG_FILE_DURABLE_BYTES && unsynced_size - size < ELOG_FILE_DURABLE_BYTES)) {
+        pthread_mutex_lock(&durable_lock);
+        pthread_cond_signal(&flusher_notice);
+        pthread_mutex_unlock(&durable_lock);
+    }
+#endif
+}
+
+void elog_file_write(const char *log, size_t size)
+{
+    ELOG_ASSERT(init_ok);
+    ELOG_ASSERT(log);
+
+#ifdef ELOG_FILE_SHARED_RING_ENABLE
+    /* the log is written to file by the writer process */
+    if (likely(elog_file_ring_put(log, size))) {
+        return;
+    }
+#endif
+
+    file_write_log(log, size);
+}
+
+/**
+ * write the log to file, it's also the shared ring writer's output
+ *
+ * @return false: the file isn't opened, the log in ring is kept for next writing
+ */
+static bool file_write_log(const char *log, size_t size)
+{
+    bool result = true;
+
+#ifndef ELOG_FILE_MMAP_LAZY_OPEN
+    if(!file_is_open()) {
+    	return false;
+    }
+#endif
+
+#ifdef ELOG_FILE_MMAP_BACKEND_ENABLE
+    /* the log is copied to mapping without lock, the file is extended or rotated with lock */
+    if (likely(!local_cfg.compress_stream && mmap_write(log, size))) {
+        return true;
+    }
+#endif
+
+    elog_file_port_lock();
+
+#ifdef ELOG_FILE_MMAP_LAZY_OPEN
+    /* the file is locked by the last writer process until it's closed */
+    if (!file_is_open() && local_cfg.name != NULL && strlen(local_cfg.name) > 0) {
+        file_open();
+        elog_file_sync_size();
+    }
+    result = file_is_open();
+#endif
+
+    if (result) {
+        file_append(log, size);
+    }
+
+#ifdef ELOG_FILE_MMAP_LAZY_OPEN
+    /* the large log of other process is written directly, the file is unlocked for the writer */
+    if (!elog_file_ring_is_writer()) {
+        file_close();
+    }
+#endif
+
+    elog_file_port_unlock();
+
+    return result;
+}
+
+/**
+ * rotate the log file now, it's same as the file is full
+ *
+ * @return true: rotate success, false: the file isn't opened or it can't be rotated
+ */
+bool elog_file_rotate(void)
+{
+    bool result = false;
+
+    elog_file_port_lock();
+
+    /* the index suffix file can't be rotated without rotate file */
+    if (file_is_open() && (local_cfg.suffix != ELOG_FILE_SUFFIX_INDEX || local_cfg.max_rotate > 0)) {
+        result = file_rotate();
+    }
+
+    elog_file_port_unlock();
+
+    return result;
+}
+
+#ifdef ELOG_CTL_ENABLE
+/*
+ * control command to rotate the log file
+ */
+static bool file_ctl_rotate(EasyLogger_t elog, char *arg)
+{
+    (void) elog;
+    (void) arg;
+
+    return elog_file_rotate();
+}
+#endif /* ELOG_CTL_ENABLE */
+
+/**
+ * write the buffered log to file
+ */
+void elog_file_flush(void)
+{
+    elog_file_port_lock();
+
+    if (file_is_open()) {
+        stream_flush();
+        file_flush();
+    }
+
+    elog_file_port_unlock();
+}
+
+#ifdef ELOG_FILE_DURABLE_ENABLE
+/*
+ * update the synced ticket and wake up the waiting threads, the file port lock must be held
+ */
+static void durable_synced(uint64_t ticket)
+{
+    if (!durable_running) {
+        synced_ticket = ticket;
+        return;
+    }
+    pthread_mutex_lock(&durable_lock);
+    if (ticket > synced_ticket) {
+        synced_ticket = ticket;
+        pthread_cond_broadcast(&synced_notice);
+    }
+    pthread_mutex_unlock(&durable_lock);
+}
+
+/*
+ * Flusher thread. All log written in the interval are synced by one fdatasync (group commit), the sync
+ * is running without file port lock, so the writing thread is never blocked by disk.
+ */
+static void *durable_flusher(void *arg)
+{
+    struct timespec deadline;
+    uint64_t ticket = 0;
+    int sync_fd;
+    bool running = true;
+
+    (void) arg;
+
+    while (running) {
+        pthread_mutex_lock(&durable_lock);
+        get_deadline(&deadline, ELOG_FILE_DURABLE_INTERVAL);
+        pthread_cond_timedwait(&flusher_notice, &durable_lock, &deadline);
+        running = durable_running;
+        pthread_mutex_unlock(&durable_lock);
+
+        sync_fd = -1;
+        elog_file_port_lock();
+        if (file_is_open() && unsynced_size) {
+            stream_flush();
+            file_flush();
+            ticket = written_ticket;
+            unsynced_size = 0;
+            /* the file maybe rotated when it's syncing, so sync on a duplicated descriptor */
+#ifdef ELOG_FILE_USING_FD
+            sync_fd = dup(fd);
+#else
+            sync_fd = dup(fileno(fp));
+#endif
+        }
+        elog_file_port_unlock();
+
+        if (sync_fd >= 0) {
+            fdatasync(sync_fd);
+            close(sync_fd);
+            pthread_mutex_lock(&durable_lock);
+            if (ticket > synced_ticket) {
+                synced_ticket = ticket;
+                pthread_cond_broadcast(&synced_notice);
+            }
+            pthread_mutex_unlock(&durable_lock);
+        }
+    }
+
+    return NULL;
+}
+
+static void durable_start(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_mutex_init(&durable_lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&flusher_notice, &attr);
+    pthread_cond_init(&synced_notice, &attr);
+    pthread_condattr_destroy(&attr);
+
+    durable_running = true;
+    if (pthread_create(&durable_thread, NULL, durable_flusher, NULL) != 0) {
+        durable_running = false;
+    }
+}
+
+static void durable_stop(void)
+{
+    pthread_mutex_lock(&durable_lock);
+    if (!durable_running) {
+        pthread_mutex_unlock(&durable_lock);
+        return;
+    }
+    durable_running = false;
+    pthread_cond_signal(&flusher_notice);
+    /* wake up all waiting threads */
+    pthread_cond_broadcast(&synced_notice);
+    pthread_mutex_unlock(&durable_lock);
+
+    pthread_join(durable_thread, NULL);
+}
+
+/**
+ * write the log and get its durability ticket
+ *
+ * @param log log
+ * @param size log size
+ *
+ * @return the ticket, it can be waited by elog_file_wait_durable
+ */
+uint64_t elog_file_write_durable(const char *log, size_t size)
+{
+    uint64_t ticket;
+
+    ELOG_ASSERT(init_ok);
+    ELOG_ASSERT(log);
+
+    elog_file_port_lock();
+
+    file_append(log, size);
+    ticket = written_ticket;
+
+    elog_file_port_unlock();
+
+    return ticket;
+}
+
+/**
+ * Set the sink which outputs the log to file by elog_file_write. The log which is queued in its
+ * asynchronous ring buffer will be written before the ticket is got by elog_file_get_ticket.
+ *
+ * @param sink file sink, NULL: the ticket only covers the log which has been written
+ */
+void elog_file_set_durable_sink(ElogSink_t sink)
+{
+    durable_sink = sink;
+}
+
+/**
+ * Get the durability ticket of all output log, such as: log_i("paid"), then wait the ticket.
+ * The log which is queued in the sink set by elog_file_set_durable_sink is written before the ticket is got,
+ * so the caller must not hold the output lock.
+ *
+ * @return the ticket
+ */
+uint64_t elog_file_get_ticket(void)
+{
+    uint64_t ticket;
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    ElogSink_t sink = durable_sink;
+
+    if (sink) {
+        elog_sink_async_flush(sink);
+    }
+#endif
+
+    elog_file_port_lock();
+    ticket = written_ticket;
+    elog_file_port_unlock();
+
+    return ticket;
+}
+
+/**
+ * wait the log is synced to disk
+ *
+ * @param ticket the ticket which is got when the log is written
+ * @param timeout_ms wait timeout (ms), < 0: wait forever
+ *
+ * @return true: the log is durable
+ */
+bool elog_file_wait_durable(uint64_t ticket, long timeout_ms)
+{
+    struct timespec deadline;
+    bool result;
+
+    if (timeout_ms >= 0) {
+        get_deadline(&deadline, timeout_ms);
+    }
+
+    pthread_mutex_lock(&durable_lock);
+    while (synced_ticket < ticket && durable_running) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&synced_notice, &durable_lock);
+        } else if (pthread_cond_timedwait(&synced_notice, &durable_lock, &deadline) != 0) {
+            break;
+        }
+    }
+    result = synced_ticket >= ticket;
+    pthread_mutex_unlock(&durable_lock);
+
+    return result;
+}
+#endif /* ELOG_FILE_DURABLE_ENABLE */
+
+void elog_file_deinit(void)
+{
+    ELOG_ASSERT(init_ok);
+
+    ElogFileCfg cfg = {NULL, 0, 0, ELOG_FILE_PERIOD_NONE, ELOG_FILE_SUFFIX_INDEX, 0, false};
+
+#ifdef ELOG_FILE_SHARED_RING_ENABLE
+    /* the remaining log in ring will be written by this process when it's the writer */
+    elog_file_ring_deinit();
+#endif
+#ifdef ELOG_FILE_FD_TIMED_FLUSH
+    elog_file_port_lock();
+    fd_flush_timer = false;
+    elog_file_port_unlock();
+#endif
+#ifdef ELOG_FILE_ROTATE_ASYNC_ENABLE
+    rotate_stop();
+#elif defined(ELOG_FILE_FD_TIMED_FLUSH)
+    flush_timer_stop();
+#endif
+#ifdef ELOG_FILE_DURABLE_ENABLE
+    durable_stop();
+#endif
+
+    elog_file_config(&cfg);
+
+    elog_file_port_deinit();
+
+    init_ok = false;
+}
+
+ElogErrCode elog_file_config(ElogFileCfg *cfg)
+{
+    ElogErrCode result = ELOG_NO_ERR;
+
+    elog_file_port_lock();
+
+    file_close();
+
+    /* the processes which are writing the same file are locked by the port */
+    if (cfg != NULL && cfg->name != NULL && strlen(cfg->name) > 0)
+        result = elog_file_port_config(cfg->name);
+
+    if (cfg != NULL) {
+        local_cfg.name = cfg->name;
+        local_cfg.max_size = cfg->max_size;
+        local_cfg.max_rotate = cfg->max_rotate;
+        local_cfg.period = cfg->period;
+        local_cfg.suffix = cfg->suffix;
+        local_cfg.max_total_size = cfg->max_total_size;
+        local_cfg.compress_stream = cfg->compress_stream;
+        if (local_cfg.compress_stream && stream_buf == NULL) {
+            stream_buf = malloc(ELOG_LZ4_BLOCK_SIZE);
+            stream_out = malloc(ELOG_LZ4_BLOCK_BOUND(ELOG_LZ4_BLOCK_SIZE));
+        }
+        if (!local_cfg.compress_stream || stream_buf == NULL || stream_out == NULL) {
+            free(stream_buf);
+            free(stream_out);
+            stream_buf = stream_out = NULL;
+            local_cfg.compress_stream = false;
+        }
+#ifdef ELOG_FILE_USING_FSTAT
+        if (local_cfg.suffix == ELOG_FILE_SUFFIX_SEQ && local_cfg.name != NULL) {
+            file_seq = get_max_file_seq();
+        }
+#endif
+
+#ifndef ELOG_FILE_MMAP_LAZY_OPEN
+        if (local_cfg.name != NULL && strlen(local_cfg.name) > 0)
+            file_open();
+#endif
+        elog_file_sync_size();
+    }
+
+    elog_file_port_unlock();
+
+    return result;
 }
 
 #endif /* ELOG_FILE_ENABLE */
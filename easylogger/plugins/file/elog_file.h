@@ -47,24 +47,69 @@ extern "C" {
 #define unlikely(x) (x)
 #endif
 
+/* time based rotation period */
+typedef enum {
+    ELOG_FILE_PERIOD_NONE,
+    ELOG_FILE_PERIOD_HOURLY,
+    ELOG_FILE_PERIOD_DAILY,
+} ElogFilePeriod;
+
+/* rotated file name suffix */
+typedef enum {
+    ELOG_FILE_SUFFIX_INDEX,  /* xxx.log is renamed to xxx.log.0, the older files are shifted */
+    ELOG_FILE_SUFFIX_TIME,   /* every file is named by its open time, such as xxx.log.20190105-083000 */
+    ELOG_FILE_SUFFIX_SEQ,    /* every file is named by increasing sequence, such as xxx.log.0000000001 */
+} ElogFileSuffix;
+
 typedef struct {
     char *name;              /* file name */
-    size_t max_size;         /* file max size */
+    size_t max_size;         /* file max size, 0: no size limit */
     int max_rotate;          /* max rotate file count */
+    ElogFilePeriod period;   /* time based rotation period, it can be used with the max size */
+    ElogFileSuffix suffix;   /* rotated file name suffix, the time and sequence suffix file is never renamed */
+    size_t max_total_size;   /* total size of all log files, the oldest files will be deleted, 0: no limit */
+    bool compress_stream;    /* write the log as LZ4 frame stream which is framed in independent 64KB blocks */
 } ElogFileCfg;
 
 /* elog_file.c */
 ElogErrCode elog_file_init(void);
 void elog_file_write(const char *log, size_t size);
-void elog_file_config(ElogFileCfg *cfg);
+ElogErrCode elog_file_config(ElogFileCfg *cfg);
+void elog_file_flush(void);
+bool elog_file_rotate(void);
+#ifdef ELOG_FILE_DURABLE_ENABLE
+uint64_t elog_file_write_durable(const char *log, size_t size);
+void elog_file_set_durable_sink(ElogSink_t sink);
+uint64_t elog_file_get_ticket(void);
+bool elog_file_wait_durable(uint64_t ticket, long timeout_ms);
+#endif
 void elog_file_deinit(void);
 
 /* elog_file_port.c */
 ElogErrCode elog_file_port_init(void);
 void elog_file_port_lock(void);
 void elog_file_port_unlock(void);
+ElogErrCode elog_file_port_config(const char *name);
 void elog_file_port_deinit(void);
 
+/* elog_file_ring.c */
+bool elog_file_ring_init(const char *name, bool (*output)(const char *log, size_t size));
+bool elog_file_ring_put(const char *log, size_t size);
+bool elog_file_ring_is_writer(void);
+void elog_file_ring_deinit(void);
+
+/* elog_lz4.c */
+/* LZ4 frame max block size */
+#define ELOG_LZ4_BLOCK_SIZE                 (64 * 1024)
+#define ELOG_LZ4_FRAME_HEADER_SIZE          7
+#define ELOG_LZ4_FRAME_END_SIZE             4
+/* the max written size of one frame block */
+#define ELOG_LZ4_BLOCK_BOUND(size)          ((size) + 4)
+size_t elog_lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size);
+size_t elog_lz4_frame_header(uint8_t *dst);
+size_t elog_lz4_frame_block(const uint8_t *src, size_t size, uint8_t *dst);
+size_t elog_lz4_frame_end(uint8_t *dst);
+
 #ifdef __cplusplus
 }
 #endif
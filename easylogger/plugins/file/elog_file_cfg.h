@@ -38,4 +38,57 @@
 /* EasyLogger file log plugin's using max rotate file count */
 #define ELOG_FILE_MAX_ROTATE           /* @note you must define it for a value */
 
+/* EasyLogger file log plugin's cached file size sync interval (second), 0: only sync after the file is opened */
+#define ELOG_FILE_SIZE_SYNC_INTERVAL   1
+
+/* time based rotation period: ELOG_FILE_PERIOD_NONE, ELOG_FILE_PERIOD_HOURLY or ELOG_FILE_PERIOD_DAILY */
+#define ELOG_FILE_ROTATE_PERIOD        ELOG_FILE_PERIOD_NONE
+/* rotated file name suffix: ELOG_FILE_SUFFIX_INDEX, ELOG_FILE_SUFFIX_TIME or ELOG_FILE_SUFFIX_SEQ */
+#define ELOG_FILE_ROTATE_SUFFIX        ELOG_FILE_SUFFIX_INDEX
+/* total size of all log files, the oldest files will be deleted, 0: no limit */
+#define ELOG_FILE_MAX_TOTAL_SIZE       0
+
+/* write the log as LZ4 frame stream, the file can be decompressed by `lz4 -d` */
+#define ELOG_FILE_COMPRESS_STREAM      false
+/* the compressed stream block will be written after the interval (ms) since the first log is buffered */
+#define ELOG_FILE_COMPRESS_STREAM_INTERVAL 1000
+
+/* using O_APPEND file descriptor with batching buffer instead of stdio, it's only for POSIX platform */
+/* #define ELOG_FILE_FD_BACKEND_ENABLE */
+/* batching buffer size for file descriptor backend */
+#define ELOG_FILE_FD_BUF_SIZE          (16 * 1024)
+/* the batching buffer will be written after the interval (ms) since the first log is buffered, even if no more log */
+#define ELOG_FILE_FD_FLUSH_INTERVAL    100
+
+/* the log is copied to memory mapped file without write syscall, it's only for POSIX platform.
+ * The file is allocated in chunk, the written size is kept in the trailer at the allocated end until the file
+ * is closed. The file is locked when it's mapped, so the other process can't open it. With the shared ring,
+ * the file is opened by the ring writer process only. */
+/* #define ELOG_FILE_MMAP_BACKEND_ENABLE */
+/* the file allocation chunk size for memory mapped file backend */
+#define ELOG_FILE_MMAP_CHUNK_SIZE      (1024 * 1024)
+/* the initial mapped size, it's doubled when the file is larger than it */
+#define ELOG_FILE_MMAP_MAP_SIZE        (64 * 1024 * 1024)
+
+/* the rotated files are renamed on background thread, it's only for POSIX platform */
+/* #define ELOG_FILE_ROTATE_ASYNC_ENABLE */
+
+/* the rotated files are compressed to LZ4 frame (xxx.lz4) on background thread, it needs the asynchronous rotation */
+/* #define ELOG_FILE_COMPRESS_ENABLE */
+/* CPU usage percent limit for the rotated file compression */
+#define ELOG_FILE_COMPRESS_CPU_PERCENT 20
+
+/* every process puts the log to the shared memory ring which is named by file name, and one writer
+ * process writes the ring to file, it's only for POSIX platform */
+/* #define ELOG_FILE_SHARED_RING_ENABLE */
+/* shared memory ring size */
+#define ELOG_FILE_SHARED_RING_SIZE     (4 * 1024 * 1024)
+
+/* durability mode, the written log is synced to disk by background thread, it's only for POSIX platform */
+/* #define ELOG_FILE_DURABLE_ENABLE */
+/* the written log will be synced to disk after the interval (ms) */
+#define ELOG_FILE_DURABLE_INTERVAL     10
+/* the written log will be synced to disk immediately when the unsynced size is more than it */
+#define ELOG_FILE_DURABLE_BYTES        (1024 * 1024)
+
 #endif /* _ELOG_FILE_CFG_H_ */
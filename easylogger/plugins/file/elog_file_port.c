@@ -60,6 +60,21 @@ void elog_file_port_unlock(void) {
 
 }
 
+/**
+ * The file plugin is configured by new file name, it's called when the file log is locked.
+ *
+ * @param name new log file name
+ *
+ * @return result
+ */
+ElogErrCode elog_file_port_config(const char *name) {
+    ElogErrCode result = ELOG_NO_ERR;
+
+    /* add your code here */
+
+    return result;
+}
+
 /**
  * file log deinit
  */
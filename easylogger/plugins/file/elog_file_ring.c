@@ -0,0 +1,556 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Shared memory MPSC ring for file log plugin. Every process puts the log to the ring
+ *           without lock and disk I/O, and the writer process drains the ring to the log file.
+ *           The writer is elected by a robust mutex, another process will take over it when
+ *           the writer is exited or crashed.
+ * Created on: 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include "elog_file.h"
+
+#ifdef ELOG_FILE_SHARED_RING_ENABLE
+#include <pthread.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stddef.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#define RING_MAGIC                     0x324E5252UL
+/* max number of the processes which are putting the log to ring */
+#define RING_PROC_MAX                  64
+#define RING_PATH_FMT                  "/dev/shm/elog_file_ring.%08x"
+/* the record is aligned to its header size, so the header is never wrapped */
+#define RING_ALIGN                     sizeof(RingRecord)
+#define RING_ALIGN_UP(size)            (((size) + RING_ALIGN - 1) / RING_ALIGN * RING_ALIGN)
+/* the padding record is filling the space to the ring end */
+#define RING_PAD_FLAG                  0x80000000UL
+/* the writer's waiting time (ms) for new log, and the interval of checking the writer lock */
+#define RING_WAIT_TIME                 100
+/* the record which is reserved but not committed by the crashed producer will be skipped after it (ms) */
+#define RING_STALL_TIME                1000
+
+/* the ring header's identity fields which are checked before it's mapped */
+#define RING_ID_SIZE                   offsetof(RingHdr, dropped)
+
+/* ring record header, the log is following it */
+typedef struct {
+    volatile uint64_t pos;             /* record position, it's written after the space is reserved */
+    volatile uint64_t commit;          /* it's same as position after the log is copied */
+    uint32_t size;                     /* log size, RING_PAD_FLAG: padding to the ring end */
+    uint32_t pid;                      /* producer pid, it's used to find the crashed producer */
+    uint64_t reserved;
+} RingRecord;
+
+/* producer process slot */
+typedef struct {
+    volatile uint32_t pid;             /* 0: free */
+    volatile uint32_t inflight;        /* the producers which are reserving or copying the log */
+} RingProc;
+
+/* ring header, the head and tail are in different cache lines */
+typedef struct {
+    uint32_t magic;
+    volatile uint32_t ready;           /* it's set after the ring is initialized */
+    uint64_t size;                     /* ring data size */
+    volatile uint64_t dropped;         /* dropped log count when the ring is full */
+    pthread_mutex_t writer;            /* robust mutex which is held by the writer process */
+    char pad0[64];
+    volatile uint64_t head;            /* reserved position */
+    char pad1[64 - sizeof(uint64_t)];
+    volatile uint64_t tail;            /* drained position */
+    volatile uint32_t wake;            /* futex word for waking up the writer */
+    volatile uint32_t sleeping;        /* the writer is waiting for new log */
+    char pad2[64 - 2 * sizeof(uint64_t)];
+    RingProc procs[RING_PROC_MAX];
+} RingHdr;
+
+static RingHdr *ring = NULL;
+static char *ring_data = NULL;
+static size_t ring_map_size = 0;
+static uint32_t ring_pid = 0;
+static RingProc *ring_proc = NULL;
+static bool (*ring_output)(const char *log, size_t size) = NULL;
+static pthread_t ring_thread;
+static volatile bool ring_running = false;
+/* the log is put to ring when it's true, otherwise it's written to file directly */
+static volatile bool ring_ok = false;
+/* this process holds the writer lock */
+static volatile bool ring_writing = false;
+/* the writer is waiting for the producers before the unknown size record is skipped */
+static bool ring_skipping = false;
+static uint64_t ring_skip_head = 0;
+static uint64_t ring_skip_wait = 0;
+
+/**
+ * Map the ring which is named by log file name. It's initialized under flock, so the ring which is
+ * left by a crashed creator is initialized again. The ring which is created with other size is
+ * unlinked and created again, the processes which are using it keep using the old one.
+ *
+ * @param name log file name
+ * @param size ring data size
+ *
+ * @return ring header, NULL: map failed
+ */
+static RingHdr *ring_map(const char *name, size_t size)
+{
+    char path[64];
+    const char *p = name;
+    uint32_t hash = 2166136261U;
+    pthread_mutexattr_t attr;
+    RingHdr *hdr = MAP_FAILED, id;
+    struct stat st, path_st;
+    mode_t mode = 0600;
+    int fd = -1, retry;
+
+    ring_map_size = RING_ALIGN_UP(sizeof(RingHdr)) + size;
+    /* FNV-1a */
+    for (; *p; p++) {
+        hash = (hash ^ (uint8_t) *p) * 16777619U;
+    }
+    snprintf(path, sizeof(path), RING_PATH_FMT, hash);
+    /* the log in ring can be accessed by the users who can access the log file */
+    if (stat(name, &st) == 0) {
+        mode = st.st_mode & 0666;
+    }
+
+    for (retry = 0; retry < 3; retry++) {
+        if ((fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600)) == -1) {
+            return NULL;
+        }
+        if (flock(fd, LOCK_EX) == -1 || fstat(fd, &st) == -1) {
+            goto __close;
+        }
+        /* it's unlinked by other process before it's locked */
+        if (stat(path, &path_st) == -1 || path_st.st_ino != st.st_ino || path_st.st_dev != st.st_dev) {
+            close(fd);
+            fd = -1;
+            continue;
+        }
+        memset(&id, 0, sizeof(id));
+        /* the magic, ready flag and size */
+        if (st.st_size > 0 && pread(fd, &id, RING_ID_SIZE, 0) != (ssize_t) RING_ID_SIZE) {
+            goto __close;
+        }
+        if (id.ready && (id.magic != RING_MAGIC || id.size != size || (size_t) st.st_size != ring_map_size)) {
+            unlink(path);
+            close(fd);
+            fd = -1;
+            continue;
+        }
+        break;
+    }
+    if (fd == -1) {
+        return NULL;
+    }
+
+    if (!id.ready) {
+        /* it's created by this process, or the creator is crashed before it's initialized */
+        if (st.st_size == 0) {
+            fchmod(fd, mode);
+        }
+        if (ftruncate(fd, ring_map_size) == -1) {
+            goto __close;
+        }
+    }
+    hdr = mmap(NULL, ring_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (hdr != MAP_FAILED && !id.ready) {
+        memset(hdr, 0, sizeof(RingHdr));
+        hdr->magic = RING_MAGIC;
+        hdr->size = size;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&hdr->writer, &attr);
+        pthread_mutexattr_destroy(&attr);
+        __atomic_store_n(&hdr->ready, 1, __ATOMIC_RELEASE);
+    }
+
+__close:
+    close(fd);
+
+    return hdr == MAP_FAILED ? NULL : hdr;
+}
+
+/**
+ * claim a producer slot, the slot of exited or crashed process is reused
+ *
+ * @return slot, NULL: all slots are used
+ */
+static RingProc *ring_proc_claim(void)
+{
+    uint32_t pid;
+    int i;
+
+    for (i = 0; i < RING_PROC_MAX; i++) {
+        pid = __atomic_load_n(&ring->procs[i].pid, __ATOMIC_ACQUIRE);
+        if (pid != 0 && (kill(pid, 0) == 0 || errno == EPERM)) {
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&ring->procs[i].pid, &pid, ring_pid, false, __ATOMIC_ACQ_REL,
+                __ATOMIC_RELAXED)) {
+            /* the crashed process's producers are never finished */
+            __atomic_store_n(&ring->procs[i].inflight, 0, __ATOMIC_RELEASE);
+            return &ring->procs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Check the producers which reserved the space before the skipped head have finished. Every live
+ * process has been seen without inflight producer since the head is got, the crashed process is ignored.
+ *
+ * @return true: the space before the skipped head can be reused
+ */
+static bool ring_skip_ready(void)
+{
+    uint32_t pid;
+    int i;
+
+    if (!ring_skipping) {
+        ring_skipping = true;
+        ring_skip_head = __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST);
+        ring_skip_wait = 0;
+        for (i = 0; i < RING_PROC_MAX; i++) {
+            if (__atomic_load_n(&ring->procs[i].pid, __ATOMIC_SEQ_CST)) {
+                ring_skip_wait |= 1ULL << i;
+            }
+        }
+    }
+    for (i = 0; i < RING_PROC_MAX; i++) {
+        if (!(ring_skip_wait & (1ULL << i))) {
+            continue;
+        }
+        pid = __atomic_load_n(&ring->procs[i].pid, __ATOMIC_SEQ_CST);
+        if (pid == 0 || __atomic_load_n(&ring->procs[i].inflight, __ATOMIC_SEQ_CST) == 0
+                || (kill(pid, 0) != 0 && errno != EPERM)) {
+            ring_skip_wait &= ~(1ULL << i);
+        }
+    }
+
+    return ring_skip_wait == 0;
+}
+
+static void ring_wake(void)
+{
+    __atomic_add_fetch(&ring->wake, 1, __ATOMIC_RELEASE);
+#ifdef __linux__
+    syscall(SYS_futex, &ring->wake, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+}
+
+/**
+ * wait for the new log, it will return after RING_WAIT_TIME when there is no log
+ *
+ * @param wake the futex word value before the ring is checked
+ */
+static void ring_wait(uint32_t wake)
+{
+    struct timespec timeout = { RING_WAIT_TIME / 1000, RING_WAIT_TIME % 1000 * 1000000L };
+
+#ifdef __linux__
+    syscall(SYS_futex, &ring->wake, FUTEX_WAIT, wake, &timeout, NULL, 0);
+#else
+    /* polling on the other platform */
+    (void) wake;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 1000000L;
+    nanosleep(&timeout, NULL);
+#endif
+}
+
+/**
+ * Put the log to shared ring without lock, it's dropped when the ring is full.
+ *
+ * @param log log
+ * @param size log size
+ *
+ * @return false: the ring is unavailable, the log should be written to file directly
+ */
+bool elog_file_ring_put(const char *log, size_t size)
+{
+    uint64_t head, tail, off, need, total;
+    RingRecord *rec;
+
+    if (unlikely(!ring_ok)) {
+        return false;
+    }
+
+    need = RING_ALIGN_UP(sizeof(RingRecord) + size);
+    if (unlikely(need > ring->size / 2)) {
+        return false;
+    }
+
+    /* the writer waits for it before the space is reused, it's counted before the space is reserved */
+    __atomic_add_fetch(&ring_proc->inflight, 1, __ATOMIC_SEQ_CST);
+
+    /* reserve the space, the padding to ring end is reserved together when the record is wrapped */
+    head = __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST);
+    do {
+        off = head % ring->size;
+        total = off + need > ring->size ? need + ring->size - off : need;
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head + total - tail > ring->size) {
+            __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+            __atomic_sub_fetch(&ring_proc->inflight, 1, __ATOMIC_RELEASE);
+            return true;
+        }
+    } while (!__atomic_compare_exchange_n(&ring->head, &head, head + total, true, __ATOMIC_SEQ_CST,
+            __ATOMIC_SEQ_CST));
+
+    if (total != need) {
+        rec = (RingRecord *) (ring_data + off);
+        rec->size = RING_PAD_FLAG;
+        rec->pid = ring_pid;
+        __atomic_store_n(&rec->pos, head, __ATOMIC_RELEASE);
+        __atomic_store_n(&rec->commit, head, __ATOMIC_RELEASE);
+        head += ring->size - off;
+        off = 0;
+    }
+    rec = (RingRecord *) (ring_data + off);
+    rec->size = size;
+    rec->pid = ring_pid;
+    __atomic_store_n(&rec->pos, head, __ATOMIC_RELEASE);
+    memcpy(rec + 1, log, size);
+    __atomic_store_n(&rec->commit, head, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&ring_proc->inflight, 1, __ATOMIC_RELEASE);
+
+    /* the writer is checking the ring after it set the sleeping flag, so the log never be missed */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->sleeping, __ATOMIC_RELAXED)) {
+        ring_wake();
+    }
+
+    return true;
+}
+
+/**
+ * drain the committed log to file, it's only called by writer
+ *
+ * @param stall_since the time (ms) when the writer is waiting for the uncommitted record
+ *
+ * @return true: some log is drained
+ */
+static bool ring_drain(long long *stall_since)
+{
+    uint64_t tail = ring->tail, dropped;
+    RingRecord *rec;
+    struct timespec ts;
+    long long now;
+    char notice[64];
+    bool drained = false;
+    int len;
+
+    while (tail != __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        rec = (RingRecord *) (ring_data + tail % ring->size);
+        if (__atomic_load_n(&rec->commit, __ATOMIC_ACQUIRE) != tail) {
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            now = (long long) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+            if (*stall_since == 0) {
+                *stall_since = now;
+            }
+            /* the producer is crashed before commit, the log is unfinished */
+            if (now - *stall_since < RING_STALL_TIME || (__atomic_load_n(&rec->pos, __ATOMIC_ACQUIRE) == tail
+                    && (kill(rec->pid, 0) == 0 || errno == EPERM))) {
+                break;
+            }
+            if (__atomic_load_n(&rec->pos, __ATOMIC_ACQUIRE) != tail) {
+                /* The record size is unknown, all reserved space is dropped. The following records may be
+                 * still copied by other producers, so the space is released after they're finished. */
+                if (ring_skip_ready()) {
+                    tail = ring_skip_head;
+                    __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+                    ring_skipping = false;
+                    *stall_since = 0;
+                }
+                break;
+            }
+        } else if (!(rec->size & RING_PAD_FLAG) && !ring_output((const char *) (rec + 1), rec->size)) {
+            /* the file is unavailable now, such as it's still locked by the last writer */
+            break;
+        }
+        *stall_since = 0;
+        ring_skipping = false;
+        if (rec->size & RING_PAD_FLAG) {
+            tail += ring->size - tail % ring->size;
+        } else {
+            tail += RING_ALIGN_UP(sizeof(RingRecord) + rec->size);
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+        drained = true;
+    }
+
+    dropped = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+    if (dropped) {
+        len = snprintf(notice, sizeof(notice), "%llu logs are dropped by full shared ring" ELOG_NEWLINE_SIGN,
+                (unsigned long long) dropped);
+        if (!ring_output(notice, len)) {
+            __atomic_add_fetch(&ring->dropped, dropped, __ATOMIC_RELAXED);
+        }
+    }
+
+    return drained;
+}
+
+/**
+ * Writer election thread. It's waiting for the writer lock, and drains the ring after it's got.
+ * The remaining log will be drained before the lock is released.
+ */
+static void *ring_writer(void *arg)
+{
+    struct timespec deadline;
+    long long stall_since = 0;
+    uint32_t wake;
+    bool is_writer = false;
+    int rc = -1;
+
+    (void) arg;
+
+    while (ring_running) {
+        if (!is_writer) {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += RING_WAIT_TIME * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            rc = pthread_mutex_timedlock(&ring->writer, &deadline);
+            if (rc == EOWNERDEAD) {
+                /* the last writer is crashed, its undrained log is kept in ring */
+                pthread_mutex_consistent(&ring->writer);
+                rc = 0;
+            }
+            is_writer = rc == 0;
+            ring_writing = is_writer;
+            ring_skipping = false;
+            continue;
+        }
+
+        if (ring_drain(&stall_since)) {
+            continue;
+        }
+        wake = __atomic_load_n(&ring->wake, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&ring->sleeping, 1, __ATOMIC_SEQ_CST);
+        if (!ring_drain(&stall_since)) {
+            ring_wait(wake);
+        }
+        __atomic_store_n(&ring->sleeping, 0, __ATOMIC_RELAXED);
+    }
+
+    /* the log which is put before the writer lock is got is drained when there is no other writer */
+    if (!is_writer && (rc = pthread_mutex_trylock(&ring->writer)) == EOWNERDEAD) {
+        pthread_mutex_consistent(&ring->writer);
+        rc = 0;
+    }
+    if (is_writer || rc == 0) {
+        ring_writing = true;
+        ring_drain(&stall_since);
+        ring_writing = false;
+        pthread_mutex_unlock(&ring->writer);
+    }
+
+    return NULL;
+}
+
+/**
+ * Is this process writing the log file continuously. It's the writer, or the log is written to
+ * file directly because the ring is unavailable.
+ *
+ * @return true: the file can be kept opened
+ */
+bool elog_file_ring_is_writer(void)
+{
+    return !ring_ok || ring_writing;
+}
+
+/**
+ * Initialize the shared ring, the ring is named by the log file name.
+ *
+ * @param name log file name
+ * @param output the log output interface for writer, it returns false when the file is unavailable,
+ *               then the log is kept in ring and it will be written again later
+ *
+ * @return true: the ring is available
+ */
+bool elog_file_ring_init(const char *name, bool (*output)(const char *log, size_t size))
+{
+    if (ring != NULL) {
+        return true;
+    }
+    if (name == NULL || (ring = ring_map(name, ELOG_FILE_SHARED_RING_SIZE)) == NULL) {
+        return false;
+    }
+    ring_data = (char *) ring + RING_ALIGN_UP(sizeof(RingHdr));
+    ring_pid = getpid();
+    ring_output = output;
+    ring_running = true;
+    if ((ring_proc = ring_proc_claim()) == NULL || pthread_create(&ring_thread, NULL, ring_writer, NULL) != 0) {
+        ring_running = false;
+        if (ring_proc) {
+            __atomic_store_n(&ring_proc->pid, 0, __ATOMIC_RELEASE);
+            ring_proc = NULL;
+        }
+        munmap(ring, ring_map_size);
+        ring = NULL;
+        return false;
+    }
+    ring_ok = true;
+
+    return true;
+}
+
+/**
+ * deinitialize the shared ring, the writer will drain the remaining log before return
+ */
+void elog_file_ring_deinit(void)
+{
+    if (ring == NULL) {
+        return;
+    }
+    /* the log will be written to file directly */
+    ring_ok = false;
+    ring_running = false;
+    pthread_join(ring_thread, NULL);
+    __atomic_store_n(&ring_proc->pid, 0, __ATOMIC_RELEASE);
+    ring_proc = NULL;
+    munmap(ring, ring_map_size);
+    ring = NULL;
+}
+
+#endif /* ELOG_FILE_SHARED_RING_ENABLE */
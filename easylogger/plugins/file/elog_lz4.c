@@ -0,0 +1,266 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Built-in LZ4 frame compressor for file log plugin. The output is compatible with
+ *           the LZ4 frame format, so it can be decompressed by `lz4 -d`.
+ * Created on: 2026-10-19
+ */
+
+#include <string.h>
+#include "elog_file.h"
+
+#define LZ4_MIN_MATCH                  4
+/* the last 5 bytes are always literals */
+#define LZ4_LAST_LITERALS              5
+/* the last match must start at least 12 bytes before the end of block */
+#define LZ4_MF_LIMIT                   12
+#define LZ4_HASH_LOG                   12
+#define LZ4_MAX_OFFSET                 65535
+
+#define LZ4_FRAME_MAGIC                0x184D2204UL
+/* version 01 and independent blocks */
+#define LZ4_FRAME_FLG                  0x60
+/* 64KB max block size */
+#define LZ4_FRAME_BD                   0x40
+/* the block is stored uncompressed when the highest bit of block size is set */
+#define LZ4_BLOCK_RAW_FLAG             0x80000000UL
+
+static uint32_t read_u32(const uint8_t *p) {
+    return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
+
+static void write_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t) v;
+    p[1] = (uint8_t) (v >> 8);
+    p[2] = (uint8_t) (v >> 16);
+    p[3] = (uint8_t) (v >> 24);
+}
+
+static uint32_t rotl32(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+/**
+ * xxHash32 for the short input which is less than 16 bytes, it's used for frame header checksum
+ */
+static uint32_t xxh32_short(const uint8_t *p, size_t len) {
+    const uint32_t prime1 = 2654435761U, prime2 = 2246822519U, prime3 = 3266489917U, prime4 = 668265263U,
+            prime5 = 374761393U;
+    uint32_t h = prime5 + (uint32_t) len;
+
+    for (; len >= 4; p += 4, len -= 4) {
+        h = rotl32(h + read_u32(p) * prime3, 17) * prime4;
+    }
+    for (; len > 0; p++, len--) {
+        h = rotl32(h + *p * prime5, 11) * prime1;
+    }
+    h ^= h >> 15;
+    h *= prime2;
+    h ^= h >> 13;
+    h *= prime3;
+    h ^= h >> 16;
+
+    return h;
+}
+
+static uint32_t lz4_hash(uint32_t v) {
+    return (v * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+/**
+ * write the literal or match length which is more than 15
+ *
+ * @return the next output position, NULL: the output buffer is full
+ */
+static uint8_t *write_length(uint8_t *op, const uint8_t *oend, size_t len) {
+    for (; len >= 255; len -= 255) {
+        if (op >= oend) {
+            return NULL;
+        }
+        *op++ = 255;
+    }
+    if (op >= oend) {
+        return NULL;
+    }
+    *op++ = (uint8_t) len;
+
+    return op;
+}
+
+/**
+ * write one sequence, the match length 0 means it's the last literals
+ *
+ * @return the next output position, NULL: the output buffer is full
+ */
+static uint8_t *write_sequence(uint8_t *op, const uint8_t *oend, const uint8_t *literal, size_t literal_len,
+        size_t offset, size_t match_len) {
+    uint8_t *token;
+
+    if (op >= oend) {
+        return NULL;
+    }
+    token = op++;
+    *token = (uint8_t) ((literal_len >= 15 ? 15 : literal_len) << 4);
+    if (literal_len >= 15 && (op = write_length(op, oend, literal_len - 15)) == NULL) {
+        return NULL;
+    }
+    if ((size_t) (oend - op) < literal_len) {
+        return NULL;
+    }
+    memcpy(op, literal, literal_len);
+    op += literal_len;
+    if (match_len == 0) {
+        return op;
+    }
+
+    if (oend - op < 2) {
+        return NULL;
+    }
+    *op++ = (uint8_t) offset;
+    *op++ = (uint8_t) (offset >> 8);
+    match_len -= LZ4_MIN_MATCH;
+    *token |= (uint8_t) (match_len >= 15 ? 15 : match_len);
+    if (match_len >= 15) {
+        op = write_length(op, oend, match_len - 15);
+    }
+
+    return op;
+}
+
+/**
+ * Compress one block to LZ4 block format, the block size must not be more than ELOG_LZ4_BLOCK_SIZE.
+ *
+ * @param src source data
+ * @param size source data size
+ * @param dst output buffer
+ * @param dst_size output buffer size
+ *
+ * @return compressed size, 0: the output buffer is too small
+ */
+size_t elog_lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size) {
+    uint16_t table[1 << LZ4_HASH_LOG];
+    const uint8_t *ip = src, *anchor = src, *ref, *match_limit, *mf_limit;
+    uint8_t *op = dst, *oend = dst + dst_size;
+    uint32_t seq, h;
+    size_t match_len;
+
+    if (size > ELOG_LZ4_BLOCK_SIZE) {
+        return 0;
+    }
+
+    if (size > LZ4_MF_LIMIT) {
+        memset(table, 0, sizeof(table));
+        match_limit = src + size - LZ4_LAST_LITERALS;
+        mf_limit = src + size - LZ4_MF_LIMIT;
+        while (ip <= mf_limit) {
+            seq = read_u32(ip);
+            h = lz4_hash(seq);
+            ref = src + table[h];
+            table[h] = (uint16_t) (ip - src);
+            if (ref >= ip || ip - ref > LZ4_MAX_OFFSET || read_u32(ref) != seq) {
+                ip++;
+                continue;
+            }
+            /* extend the match backward and forward */
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            for (match_len = LZ4_MIN_MATCH; ip + match_len < match_limit && ip[match_len] == ref[match_len];
+                    match_len++);
+
+            op = write_sequence(op, oend, anchor, ip - anchor, ip - ref, match_len);
+            if (op == NULL) {
+                return 0;
+            }
+            ip += match_len;
+            anchor = ip;
+            /* the position before the match end is a good candidate for the next match */
+            if (ip - 2 <= mf_limit) {
+                table[lz4_hash(read_u32(ip - 2))] = (uint16_t) (ip - 2 - src);
+            }
+        }
+    }
+    op = write_sequence(op, oend, anchor, src + size - anchor, 0, 0);
+    if (op == NULL) {
+        return 0;
+    }
+
+    return op - dst;
+}
+
+/**
+ * write the LZ4 frame header, the blocks are independent and the max block size is 64KB
+ *
+ * @param dst output buffer, its size must be ELOG_LZ4_FRAME_HEADER_SIZE at least
+ *
+ * @return header size
+ */
+size_t elog_lz4_frame_header(uint8_t *dst) {
+    write_u32(dst, LZ4_FRAME_MAGIC);
+    dst[4] = LZ4_FRAME_FLG;
+    dst[5] = LZ4_FRAME_BD;
+    dst[6] = (uint8_t) (xxh32_short(dst + 4, 2) >> 8);
+
+    return ELOG_LZ4_FRAME_HEADER_SIZE;
+}
+
+/**
+ * Write one LZ4 frame block, it's stored uncompressed when the compressed data is not smaller.
+ *
+ * @param src source data, its size must not be more than ELOG_LZ4_BLOCK_SIZE
+ * @param size source data size
+ * @param dst output buffer, its size must be ELOG_LZ4_BLOCK_BOUND(size) at least
+ *
+ * @return written size, 0: the source data is empty or too large
+ */
+size_t elog_lz4_frame_block(const uint8_t *src, size_t size, uint8_t *dst) {
+    size_t compressed;
+
+    if (size == 0 || size > ELOG_LZ4_BLOCK_SIZE) {
+        return 0;
+    }
+    compressed = elog_lz4_compress(src, size, dst + 4, size - 1);
+    if (compressed == 0) {
+        memcpy(dst + 4, src, size);
+        write_u32(dst, (uint32_t) size | LZ4_BLOCK_RAW_FLAG);
+        return size + 4;
+    }
+    write_u32(dst, (uint32_t) compressed);
+
+    return compressed + 4;
+}
+
+/**
+ * write the LZ4 frame end mark
+ *
+ * @param dst output buffer, its size must be ELOG_LZ4_FRAME_END_SIZE at least
+ *
+ * @return end mark size
+ */
+size_t elog_lz4_frame_end(uint8_t *dst) {
+    write_u32(dst, 0);
+
+    return ELOG_LZ4_FRAME_END_SIZE;
+}
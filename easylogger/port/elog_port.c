@@ -81,6 +81,19 @@ void elog_port_output_unlock(void) {
     
 }
 
+#ifdef ELOG_EMERGENCY_ENABLE
+/**
+ * try to lock output, it's used by emergency flush in signal handler, it must not block
+ *
+ * @return true: locked, false: the output lock is held by others
+ */
+bool elog_port_output_trylock(void) {
+    
+    /* add your code here */
+    
+}
+#endif
+
 /**
  * get current time interface
  *
@@ -112,4 +125,30 @@ const char *elog_port_get_t_info(void) {
     
     /* add your code here */
     
-}
\ No newline at end of file
+}
+
+/**
+ * get current millisecond tick interface, it's used by rate limit, duplicate log suppression and log_every_ms_x API
+ *
+ * @return current tick in millisecond
+ */
+uint32_t elog_port_get_tick(void) {
+    
+    /* add your code here */
+    
+}
+
+#ifdef ELOG_BLACKBOX_ENABLE
+/**
+ * map the black box memory interface, the memory must survive the crash and keep the last content
+ *
+ * @param size black box size
+ *
+ * @return black box memory, NULL: map failed
+ */
+void *elog_port_blackbox_map(size_t size) {
+    
+    /* add your code here */
+    
+}
+#endif
\ No newline at end of file
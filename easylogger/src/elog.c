@@ -32,6 +32,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #if !defined(ELOG_OUTPUT_LVL)
     #error "Please configure static output log level (in elog_cfg.h)"
@@ -114,10 +115,27 @@
 #endif
 #endif /* ELOG_COLOR_ENABLE */
 
-/* EasyLogger object */
-static EasyLogger elog;
-/* every line log's buffer */
-static char log_buf[ELOG_LINE_BUF_SIZE] = { 0 };
+#if defined(__GNUC__) || defined(__clang__)
+#define FILTER_LOAD_ACQUIRE(ptr)        __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define FILTER_LOAD_RELAXED(ptr)        __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define FILTER_STORE_RELEASE(ptr, val)  __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define FILTER_STORE_RELAXED(ptr, val)  __atomic_store_n(ptr, val, __ATOMIC_RELAXED)
+#define FILTER_FENCE_ACQUIRE()          __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define FILTER_FENCE_RELEASE()          __atomic_thread_fence(__ATOMIC_RELEASE)
+#define STATS_INC_RELAXED(ptr)          __atomic_fetch_add(ptr, 1, __ATOMIC_RELAXED)
+#else
+/* the volatile access is used on other compilers, it's enough for the single core MCU */
+#define FILTER_LOAD_ACQUIRE(ptr)        (*(ptr))
+#define FILTER_LOAD_RELAXED(ptr)        (*(ptr))
+#define FILTER_STORE_RELEASE(ptr, val)  (*(ptr) = (val))
+#define FILTER_STORE_RELAXED(ptr, val)  (*(ptr) = (val))
+#define FILTER_FENCE_ACQUIRE()
+#define FILTER_FENCE_RELEASE()
+#define STATS_INC_RELAXED(ptr)          ((*(ptr))++)
+#endif
+
+/* default EasyLogger object, all the elog_xxx API is using it */
+static EasyLogger default_elog;
 /* level output info */
 static const char *level_output_info[] = {
         [ELOG_LVL_ASSERT]  = "A/",
@@ -140,10 +158,25 @@ static const char *color_output_info[] = {
 };
 #endif /* ELOG_COLOR_ENABLE */
 
-static bool get_fmt_enabled(uint8_t level, size_t set);
-static bool get_fmt_used_and_enabled_u32(uint8_t level, size_t set, uint32_t arg);
-static bool get_fmt_used_and_enabled_ptr(uint8_t level, size_t set, const char* arg);
-static void elog_set_filter_tag_lvl_default(void);
+static bool get_fmt_enabled(size_t fmt, size_t set);
+static bool get_fmt_used_and_enabled_u32(size_t fmt, size_t set, uint32_t arg);
+static bool get_fmt_used_and_enabled_ptr(size_t fmt, size_t set, const char* arg);
+static void filter_lock(EasyLogger_t elog);
+static void filter_unlock(EasyLogger_t elog);
+static ElogFilter *filter_update_begin(EasyLogger_t elog);
+static void filter_update_end(EasyLogger_t elog);
+static const ElogFilterSnapshot *filter_read_begin(EasyLogger_t elog, uint32_t *seq);
+static bool filter_read_retry(const ElogFilterSnapshot *snapshot, uint32_t seq);
+static uint8_t filter_get_tag_lvl(const ElogFilter *filter, const char *tag);
+static void elog_sinks_output(EasyLogger_t elog, uint8_t level, const char *log, size_t size);
+static void elog_sinks_render_output(EasyLogger_t elog, ElogRecord *rec);
+static bool elog_output_check(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        long line);
+static void elog_record_output(EasyLogger_t elog, ElogRecord *rec);
+void elog_summary_output(EasyLogger_t elog, uint8_t level, const char *tag, const char *format, ...);
+void elog_inst_output_lock(EasyLogger_t elog);
+void elog_inst_output_unlock(EasyLogger_t elog);
+void elog_inst_filter_publish(EasyLogger_t elog, const ElogFilter *filter);
 
 /* EasyLogger assert hook */
 void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
@@ -152,6 +185,22 @@ extern void elog_port_output(const char *log, size_t size);
 extern void elog_port_output_lock(void);
 extern void elog_port_output_unlock(void);
 
+/**
+ * default object's output lock, it's using the port lock
+ */
+static void default_output_lock(void *arg) {
+    (void) arg;
+    elog_port_output_lock();
+}
+
+/**
+ * default object's output unlock
+ */
+static void default_output_unlock(void *arg) {
+    (void) arg;
+    elog_port_output_unlock();
+}
+
 /**
  * EasyLogger initialize.
  *
@@ -159,11 +208,14 @@ extern void elog_port_output_unlock(void);
  */
 ElogErrCode elog_init(void) {
     extern ElogErrCode elog_port_init(void);
-    extern ElogErrCode elog_async_init(void);
+    extern void elog_async_default_cfg(ElogCfg *cfg);
+    extern void elog_buf_default_cfg(ElogCfg *cfg);
+    extern void elog_blackbox_default_cfg(ElogCfg *cfg);
 
     ElogErrCode result = ELOG_NO_ERR;
+    ElogCfg cfg = { 0 };
 
-    if (elog.init_ok == true) {
+    if (default_elog.init_ok == true) {
         return result;
     }
 
@@ -173,98 +225,317 @@ ElogErrCode elog_init(void) {
         return result;
     }
 
+    cfg.output = elog_port_output;
+    cfg.output_lock = default_output_lock;
+    cfg.output_unlock = default_output_unlock;
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_default_cfg(&cfg);
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    elog_buf_default_cfg(&cfg);
+#endif
+#ifdef ELOG_BLACKBOX_ENABLE
+    /* the buffers are moved to black box, it must be after the buffers configuration */
+    elog_blackbox_default_cfg(&cfg);
+#endif
+
+    return elog_inst_init(&default_elog, &cfg);
+}
+
+/**
+ * EasyLogger deinitialize.
+ *
+ */
+void elog_deinit(void) {
+    extern ElogErrCode elog_port_deinit(void);
+
+    if (!default_elog.init_ok) {
+        return ;
+    }
+
+    elog_inst_deinit(&default_elog);
+
+    /* port deinitialize */
+    elog_port_deinit();
+}
+
+/**
+ * get the default EasyLogger object, which is using by all elog_xxx API
+ *
+ * @return default object
+ */
+EasyLogger_t elog_get_default(void) {
+    return &default_elog;
+}
+
+/**
+ * Create an independent EasyLogger object. It has its own filter, format, buffers and lock.
+ * The asynchronous output and buffered output buffer will be allocated with the object
+ * when the buffer pointer is NULL and the buffer size is not 0 in configuration.
+ *
+ * @param cfg instance configuration
+ *
+ * @return EasyLogger object, NULL: create failed
+ */
+EasyLogger_t elog_create(const ElogCfg *cfg) {
+    EasyLogger_t elog = NULL;
+    ElogCfg inst_cfg;
+    size_t async_buf_size = 0, buf_size = 0;
+
+    ELOG_ASSERT(cfg);
+
+    inst_cfg = *cfg;
+    if (!cfg->async_buf) {
+        async_buf_size = cfg->async_buf_size;
+    }
+    if (!cfg->buf) {
+        buf_size = cfg->buf_size;
+    }
+    /* the object and its buffers are allocated in one block */
+    elog = calloc(1, sizeof(EasyLogger) + async_buf_size + buf_size);
+    if (!elog) {
+        return NULL;
+    }
+    if (async_buf_size) {
+        inst_cfg.async_buf = (char *) elog + sizeof(EasyLogger);
+    }
+    if (buf_size) {
+        inst_cfg.buf = (char *) elog + sizeof(EasyLogger) + async_buf_size;
+    }
+
+    if (elog_inst_init(elog, &inst_cfg) != ELOG_NO_ERR) {
+        free(elog);
+        return NULL;
+    }
+
+    return elog;
+}
+
+/**
+ * destroy the EasyLogger object which is created by elog_create
+ *
+ * @param elog EasyLogger object
+ */
+void elog_destroy(EasyLogger_t elog) {
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(elog != &default_elog);
+
+    elog_inst_deinit(elog);
+    free(elog);
+}
+
+/**
+ * EasyLogger object initialize.
+ * @note The object must be zero initialized before first initialize, such as static object.
+ *
+ * @param elog EasyLogger object
+ * @param cfg instance configuration
+ *
+ * @return result
+ */
+ElogErrCode elog_inst_init(EasyLogger_t elog, const ElogCfg *cfg) {
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    extern ElogErrCode elog_async_init(ElogAsync *async, EasyLogger_t elog, void (*output)(const char *log, size_t size),
+            char *buf, size_t size, void (*notice)(void));
+#endif
+    extern void elog_buf_init(EasyLogger_t elog, char *buf, size_t size);
+
+    ElogErrCode result = ELOG_NO_ERR;
+    ElogFilter *filter;
+    uint8_t i;
+
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(cfg);
+
+    if (elog->init_ok == true) {
+        return result;
+    }
+
+    elog->output = cfg->output;
+    elog->output_lock = cfg->output_lock;
+    elog->output_unlock = cfg->output_unlock;
+    elog->lock_arg = cfg->lock_arg;
+
 #ifdef ELOG_ASYNC_OUTPUT_ENABLE
-    result = elog_async_init();
+    result = elog_async_init(&elog->async, elog, cfg->output, cfg->async_buf, cfg->async_buf_size, cfg->async_notice);
     if (result != ELOG_NO_ERR) {
         return result;
     }
 #endif
 
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    elog_buf_init(elog, cfg->buf, cfg->buf_size);
+#endif
+
+#ifdef ELOG_BLACKBOX_ENABLE
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog->async.blackbox = cfg->blackbox;
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    elog->buf.blackbox = cfg->blackbox;
+#endif
+#endif /* ELOG_BLACKBOX_ENABLE */
+
+    /* the output interface is the first sink, it's using the object's format and text color setting */
+    if (cfg->output) {
+        elog_sink_init(&elog->output_sink, "output", cfg->output);
+#ifdef ELOG_COLOR_ENABLE
+        elog_sink_set_text_color_enabled(&elog->output_sink, true);
+#endif
+        elog->output_sink.elog = elog;
+        elog->output_sink.next = elog->sinks;
+        elog->sinks = &elog->output_sink;
+    }
+
     /* enable the output lock */
-    elog_output_lock_enabled(true);
+    elog_inst_output_lock_enabled(elog, true);
     /* output locked status initialize */
-    elog.output_is_locked_before_enable = false;
-    elog.output_is_locked_before_disable = false;
+    elog->output_is_locked_before_enable = false;
+    elog->output_is_locked_before_disable = false;
 
 #ifdef ELOG_COLOR_ENABLE
     /* enable text color by default */
-    elog_set_text_color_enabled(true);
+    elog_inst_set_text_color_enabled(elog, true);
 #endif
 
-    /* set level is ELOG_LVL_VERBOSE */
-    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
+    /* publish the default filter, the level is ELOG_LVL_VERBOSE and the tag level filters are unused */
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+    pthread_mutex_init(&elog->filter_lock, NULL);
+#endif
+    filter_lock(elog);
+    filter = filter_update_begin(elog);
+    memset(filter, 0, sizeof(ElogFilter));
+    filter->level = ELOG_LVL_VERBOSE;
+    for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        filter->tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
+    }
+    filter_update_end(elog);
+    filter_unlock(elog);
+
+#ifdef ELOG_DEDUP_ENABLE
+    /* the duplicate log which has same message is suppressed by default */
+    memset(&elog->dedup, 0, sizeof(ElogDedup));
+    elog->dedup.mode = ELOG_DEDUP_MSG;
+    elog->dedup.window = ELOG_DEDUP_WINDOW;
+#endif
 
-    /* set tag_level to default val */
-    elog_set_filter_tag_lvl_default();
+    memset(&elog->stats, 0, sizeof(ElogStats));
 
-    elog.init_ok = true;
+    elog->init_ok = true;
 
     return result;
 }
 
 /**
- * EasyLogger deinitialize.
+ * EasyLogger object deinitialize.
  *
+ * @param elog EasyLogger object
  */
-void elog_deinit(void) {
-    extern ElogErrCode elog_port_deinit(void);
-    extern ElogErrCode elog_async_deinit(void);
+void elog_inst_deinit(EasyLogger_t elog) {
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    extern void elog_async_deinit(ElogAsync *async);
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    extern void elog_buf_deinit(EasyLogger_t elog);
+#endif
+#ifdef ELOG_DEDUP_ENABLE
+    extern void elog_dedup_flush(EasyLogger_t elog);
+#endif
 
-    if (!elog.init_ok) {
+    ELOG_ASSERT(elog);
+
+    if (!elog->init_ok) {
         return ;
     }
-    
+
+#ifdef ELOG_DEDUP_ENABLE
+    /* output the last log's repeated number */
+    elog_inst_output_lock(elog);
+    elog_dedup_flush(elog);
+    elog_inst_output_unlock(elog);
+#endif
+
+    /* unregister all sinks, the remaining log in sink's ring buffer will be output */
+    while (elog->sinks && elog->sinks != &elog->output_sink) {
+        elog_inst_sink_unregister(elog, elog->sinks);
+    }
+    while (elog->sinks && elog->sinks->next) {
+        elog_inst_sink_unregister(elog, elog->sinks->next);
+    }
+
 #ifdef ELOG_ASYNC_OUTPUT_ENABLE
-    elog_async_deinit();
+    elog_async_deinit(&elog->async);
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    elog_buf_deinit(elog);
+#endif
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+    pthread_mutex_destroy(&elog->filter_lock);
 #endif
 
-    /* port deinitialize */
-    elog_port_deinit();
+    elog->sinks = NULL;
 
-    elog.init_ok = false;
+    elog->init_ok = false;
 }
 
-
 /**
  * EasyLogger start after initialize.
  */
 void elog_start(void) {
-    if (!elog.init_ok) {
+    elog_inst_start(&default_elog);
+}
+
+/**
+ * EasyLogger object start after initialize.
+ *
+ * @param elog EasyLogger object
+ */
+void elog_inst_start(EasyLogger_t elog) {
+    if (!elog->init_ok) {
         return ;
     }
-    
+
     /* enable output */
-    elog_set_output_enabled(true);
+    elog_inst_set_output_enabled(elog, true);
 
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    elog_async_enabled(true);
+    elog_inst_async_enabled(elog, true);
 #elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    elog_buf_enabled(true);
+    elog_inst_buf_enabled(elog, true);
 #endif
 
     /* show version */
-    log_i("EasyLogger V%s is initialize success.", ELOG_SW_VERSION);
+    elog_inst_i(elog, LOG_TAG, "EasyLogger V%s is initialize success.", ELOG_SW_VERSION);
 }
 
 /**
  * EasyLogger stop after initialize.
  */
 void elog_stop(void) {
-    if (!elog.init_ok) {
+    elog_inst_stop(&default_elog);
+}
+
+/**
+ * EasyLogger object stop after initialize.
+ *
+ * @param elog EasyLogger object
+ */
+void elog_inst_stop(EasyLogger_t elog) {
+    if (!elog->init_ok) {
         return ;
     }
 
     /* disable output */
-    elog_set_output_enabled(false);
+    elog_inst_set_output_enabled(elog, false);
 
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    elog_async_enabled(false);
+    elog_inst_async_enabled(elog, false);
 #elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    elog_buf_enabled(false);
+    elog_inst_buf_enabled(elog, false);
 #endif
 
     /* show version */
-    log_i("EasyLogger V%s is deinitialize success.", ELOG_SW_VERSION);
+    elog_inst_i(elog, LOG_TAG, "EasyLogger V%s is deinitialize success.", ELOG_SW_VERSION);
 }
 
 
@@ -274,9 +545,13 @@ void elog_stop(void) {
  * @param enabled TRUE: enable FALSE: disable
  */
 void elog_set_output_enabled(bool enabled) {
+    elog_inst_set_output_enabled(&default_elog, enabled);
+}
+
+void elog_inst_set_output_enabled(EasyLogger_t elog, bool enabled) {
     ELOG_ASSERT((enabled == false) || (enabled == true));
 
-    elog.output_enabled = enabled;
+    elog->output_enabled = enabled;
 }
 
 #ifdef ELOG_COLOR_ENABLE
@@ -286,9 +561,13 @@ void elog_set_output_enabled(bool enabled) {
  * @param enabled TRUE: enable FALSE:disable
  */
 void elog_set_text_color_enabled(bool enabled) {
+    elog_inst_set_text_color_enabled(&default_elog, enabled);
+}
+
+void elog_inst_set_text_color_enabled(EasyLogger_t elog, bool enabled) {
     ELOG_ASSERT((enabled == false) || (enabled == true));
 
-    elog.text_color_enabled = enabled;
+    elog->text_color_enabled = enabled;
 }
 
 /**
@@ -297,7 +576,11 @@ void elog_set_text_color_enabled(bool enabled) {
  * @return enable or disable
  */
 bool elog_get_text_color_enabled(void) {
-    return elog.text_color_enabled;
+    return elog_inst_get_text_color_enabled(&default_elog);
+}
+
+bool elog_inst_get_text_color_enabled(EasyLogger_t elog) {
+    return elog->text_color_enabled;
 }
 #endif /* ELOG_COLOR_ENABLE */
 
@@ -307,7 +590,11 @@ bool elog_get_text_color_enabled(void) {
  * @return enable or disable
  */
 bool elog_get_output_enabled(void) {
-    return elog.output_enabled;
+    return elog_inst_get_output_enabled(&default_elog);
+}
+
+bool elog_inst_get_output_enabled(EasyLogger_t elog) {
+    return elog->output_enabled;
 }
 
 /**
@@ -317,9 +604,13 @@ bool elog_get_output_enabled(void) {
  * @param set format set
  */
 void elog_set_fmt(uint8_t level, size_t set) {
+    elog_inst_set_fmt(&default_elog, level, set);
+}
+
+void elog_inst_set_fmt(EasyLogger_t elog, uint8_t level, size_t set) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
-    elog.enabled_fmt_set[level] = set;
+    elog->enabled_fmt_set[level] = set;
 }
 
 /**
@@ -330,11 +621,22 @@ void elog_set_fmt(uint8_t level, size_t set) {
  * @param keyword keyword
  */
 void elog_set_filter(uint8_t level, const char *tag, const char *keyword) {
+    elog_inst_set_filter(&default_elog, level, tag, keyword);
+}
+
+void elog_inst_set_filter(EasyLogger_t elog, uint8_t level, const char *tag, const char *keyword) {
+    ElogFilter *filter;
+
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
-    elog_set_filter_lvl(level);
-    elog_set_filter_tag(tag);
-    elog_set_filter_kw(keyword);
+    /* all parameters are published in one snapshot */
+    filter_lock(elog);
+    filter = filter_update_begin(elog);
+    filter->level = level;
+    strncpy(filter->tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    strncpy(filter->keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
+    filter_update_end(elog);
+    filter_unlock(elog);
 }
 
 /**
@@ -343,9 +645,16 @@ void elog_set_filter(uint8_t level, const char *tag, const char *keyword) {
  * @param level level
  */
 void elog_set_filter_lvl(uint8_t level) {
+    elog_inst_set_filter_lvl(&default_elog, level);
+}
+
+void elog_inst_set_filter_lvl(EasyLogger_t elog, uint8_t level) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
-    elog.filter.level = level;
+    filter_lock(elog);
+    filter_update_begin(elog)->level = level;
+    filter_update_end(elog);
+    filter_unlock(elog);
 }
 
 /**
@@ -354,7 +663,14 @@ void elog_set_filter_lvl(uint8_t level) {
  * @param tag tag
  */
 void elog_set_filter_tag(const char *tag) {
-    strncpy(elog.filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    elog_inst_set_filter_tag(&default_elog, tag);
+}
+
+void elog_inst_set_filter_tag(EasyLogger_t elog, const char *tag) {
+    filter_lock(elog);
+    strncpy(filter_update_begin(elog)->tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    filter_update_end(elog);
+    filter_unlock(elog);
 }
 
 /**
@@ -363,45 +679,185 @@ void elog_set_filter_tag(const char *tag) {
  * @param keyword keyword
  */
 void elog_set_filter_kw(const char *keyword) {
-    strncpy(elog.filter.keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
+    elog_inst_set_filter_kw(&default_elog, keyword);
+}
+
+void elog_inst_set_filter_kw(EasyLogger_t elog, const char *keyword) {
+    filter_lock(elog);
+    strncpy(filter_update_begin(elog)->keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
+    filter_update_end(elog);
+    filter_unlock(elog);
 }
 
 /**
  * lock output 
+ *
+ * @param elog EasyLogger object
  */
-void elog_output_lock(void) {
-    if (elog.output_lock_enabled) {
-        elog_port_output_lock();
-        elog.output_is_locked_before_disable = true;
+void elog_inst_output_lock(EasyLogger_t elog) {
+    if (elog->output_lock_enabled) {
+        if (elog->output_lock) {
+            elog->output_lock(elog->lock_arg);
+        }
+        elog->output_is_locked_before_disable = true;
     } else {
-        elog.output_is_locked_before_enable = true;
+        elog->output_is_locked_before_enable = true;
     }
 }
 
 /**
  * unlock output
+ *
+ * @param elog EasyLogger object
  */
-void elog_output_unlock(void) {
-    if (elog.output_lock_enabled) {
-        elog_port_output_unlock();
-        elog.output_is_locked_before_disable = false;
+void elog_inst_output_unlock(EasyLogger_t elog) {
+    if (elog->output_lock_enabled) {
+        if (elog->output_unlock) {
+            elog->output_unlock(elog->lock_arg);
+        }
+        elog->output_is_locked_before_disable = false;
     } else {
-        elog.output_is_locked_before_enable = false;
+        elog->output_is_locked_before_enable = false;
     }
 }
 
 /**
- * set log filter's tag level val to default
+ * lock default object output
  */
-static void elog_set_filter_tag_lvl_default(void)
-{
-    uint8_t i = 0;
+void elog_output_lock(void) {
+    elog_inst_output_lock(&default_elog);
+}
 
-    for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-        memset(elog.filter.tag_lvl[i].tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1);
-        elog.filter.tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
-        elog.filter.tag_lvl[i].tag_use_flag = false;
+/**
+ * unlock default object output
+ */
+void elog_output_unlock(void) {
+    elog_inst_output_unlock(&default_elog);
+}
+
+/**
+ * lock the filter setting, the logging threads aren't blocked when it's using the object's own mutex
+ *
+ * @param elog EasyLogger object
+ */
+static void filter_lock(EasyLogger_t elog) {
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+    pthread_mutex_lock(&elog->filter_lock);
+#else
+    elog_inst_output_lock(elog);
+#endif
+}
+
+/**
+ * unlock the filter setting
+ *
+ * @param elog EasyLogger object
+ */
+static void filter_unlock(EasyLogger_t elog) {
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+    pthread_mutex_unlock(&elog->filter_lock);
+#else
+    elog_inst_output_unlock(elog);
+#endif
+}
+
+/**
+ * Begin to update the filter, the filter lock must be held. The oldest retired snapshot is rebuilt
+ * from the published filter, and the returned filter can be modified until filter_update_end.
+ *
+ * @param elog EasyLogger object
+ *
+ * @return the filter in new snapshot
+ */
+static ElogFilter *filter_update_begin(EasyLogger_t elog) {
+    ElogFilterSnapshot *cur = elog->filter, *next;
+
+    elog->filter_snapshot_index = (elog->filter_snapshot_index + 1) % ELOG_FILTER_SNAPSHOT_NUM;
+    next = &elog->filter_snapshot[elog->filter_snapshot_index];
+    /* the sequence is odd, the reader which is still using this retired snapshot will retry */
+    FILTER_STORE_RELAXED(&next->seq, next->seq + 1);
+    FILTER_FENCE_RELEASE();
+    if (cur && cur != next) {
+        next->filter = cur->filter;
+    }
+
+    return &next->filter;
+}
+
+/**
+ * publish the new filter snapshot by atomic pointer swap, the filter lock must be held
+ *
+ * @param elog EasyLogger object
+ */
+static void filter_update_end(EasyLogger_t elog) {
+    ElogFilterSnapshot *next = &elog->filter_snapshot[elog->filter_snapshot_index];
+
+    FILTER_STORE_RELEASE(&next->seq, next->seq + 1);
+    FILTER_STORE_RELEASE(&elog->filter, next);
+}
+
+/**
+ * publish the whole filter as one snapshot
+ *
+ * @param elog EasyLogger object
+ * @param filter new filter
+ */
+void elog_inst_filter_publish(EasyLogger_t elog, const ElogFilter *filter) {
+    filter_lock(elog);
+    *filter_update_begin(elog) = *filter;
+    filter_update_end(elog);
+    filter_unlock(elog);
+}
+
+/**
+ * Begin to read the published filter snapshot, it's lock free.
+ *
+ * example:
+ *     do {
+ *         snapshot = filter_read_begin(elog, &seq);
+ *         level = snapshot->filter.level;
+ *     } while (filter_read_retry(snapshot, seq));
+ *
+ * @param elog EasyLogger object
+ * @param seq snapshot sequence which is used by filter_read_retry
+ *
+ * @return published filter snapshot
+ */
+static const ElogFilterSnapshot *filter_read_begin(EasyLogger_t elog, uint32_t *seq) {
+    const ElogFilterSnapshot *snapshot = FILTER_LOAD_ACQUIRE(&elog->filter);
+
+    *seq = FILTER_LOAD_ACQUIRE(&snapshot->seq);
+
+    return snapshot;
+}
+
+/**
+ * check the snapshot was rebuilt while it's being read
+ *
+ * @return true: the read result is invalid, it should read again
+ */
+static bool filter_read_retry(const ElogFilterSnapshot *snapshot, uint32_t seq) {
+    FILTER_FENCE_ACQUIRE();
+
+    return (seq & 1) || seq != FILTER_LOAD_RELAXED(&snapshot->seq);
+}
+
+/**
+ * get the level on tag's level filter in snapshot
+ *
+ * @return It will return the lowest level when tag was not found.
+ */
+static uint8_t filter_get_tag_lvl(const ElogFilter *filter, const char *tag) {
+    uint8_t i;
+
+    for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        if (filter->tag_lvl[i].tag_use_flag == true &&
+            !strncmp(tag, filter->tag_lvl[i].tag, ELOG_FILTER_TAG_MAX_LEN)) {
+            return filter->tag_lvl[i].level;
+        }
     }
+
+    return ELOG_FILTER_LVL_ALL;
 }
 
 /**
@@ -423,20 +879,27 @@ static void elog_set_filter_tag_lvl_default(void)
  *
  */
 void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
+{
+    elog_inst_set_filter_tag_lvl(&default_elog, tag, level);
+}
+
+void elog_inst_set_filter_tag_lvl(EasyLogger_t elog, const char *tag, uint8_t level)
 {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
     ELOG_ASSERT(tag != ((void *)0));
+    ElogFilter *filter;
     uint8_t i = 0;
 
-    if (!elog.init_ok) {
+    if (!elog->init_ok) {
         return;
     }
 
-    elog_output_lock();
+    filter_lock(elog);
+    filter = filter_update_begin(elog);
     /* find the tag in arr */
     for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-        if (elog.filter.tag_lvl[i].tag_use_flag == true &&
-            !strncmp(tag, elog.filter.tag_lvl[i].tag,ELOG_FILTER_TAG_MAX_LEN)){
+        if (filter->tag_lvl[i].tag_use_flag == true &&
+            !strncmp(tag, filter->tag_lvl[i].tag,ELOG_FILTER_TAG_MAX_LEN)){
             break;
         }
     }
@@ -445,26 +908,27 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
         /* find OK */
         if (level == ELOG_FILTER_LVL_ALL){
             /* remove current tag's level filter when input level is the lowest level */
-             elog.filter.tag_lvl[i].tag_use_flag = false;
-             memset(elog.filter.tag_lvl[i].tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1);
-             elog.filter.tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
+             filter->tag_lvl[i].tag_use_flag = false;
+             memset(filter->tag_lvl[i].tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1);
+             filter->tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
         } else{
-            elog.filter.tag_lvl[i].level = level;
+            filter->tag_lvl[i].level = level;
         }
     } else{
         /* only add the new tag's level filer when level is not ELOG_FILTER_LVL_ALL */
         if (level != ELOG_FILTER_LVL_ALL){
             for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-                if (elog.filter.tag_lvl[i].tag_use_flag == false){
-                    strncpy(elog.filter.tag_lvl[i].tag, tag, ELOG_FILTER_TAG_MAX_LEN);
-                    elog.filter.tag_lvl[i].level = level;
-                    elog.filter.tag_lvl[i].tag_use_flag = true;
+                if (filter->tag_lvl[i].tag_use_flag == false){
+                    strncpy(filter->tag_lvl[i].tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+                    filter->tag_lvl[i].level = level;
+                    filter->tag_lvl[i].tag_use_flag = true;
                     break;
                 }
             }
         }
     }
-    elog_output_unlock();
+    filter_update_end(elog);
+    filter_unlock(elog);
 }
 
 /**
@@ -476,81 +940,157 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
  *         Other level will return when tag was found.
  */
 uint8_t elog_get_filter_tag_lvl(const char *tag)
+{
+    return elog_inst_get_filter_tag_lvl(&default_elog, tag);
+}
+
+uint8_t elog_inst_get_filter_tag_lvl(EasyLogger_t elog, const char *tag)
 {
     ELOG_ASSERT(tag != ((void *)0));
-    uint8_t i = 0;
+    const ElogFilterSnapshot *snapshot;
+    uint32_t seq;
     uint8_t level = ELOG_FILTER_LVL_ALL;
 
-    if (!elog.init_ok) {
+    if (!elog->init_ok) {
         return level;
     }
 
-    elog_output_lock();
-    /* find the tag in arr */
-    for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-        if (elog.filter.tag_lvl[i].tag_use_flag == true &&
-            !strncmp(tag, elog.filter.tag_lvl[i].tag,ELOG_FILTER_TAG_MAX_LEN)){
-            level = elog.filter.tag_lvl[i].level;
-            break;
-        }
-    }
-    elog_output_unlock();
+    do {
+        snapshot = filter_read_begin(elog, &seq);
+        level = filter_get_tag_lvl(&snapshot->filter, tag);
+    } while (filter_read_retry(snapshot, seq));
 
     return level;
 }
 
 /**
- * output RAW format log
+ * get the current filter, it's copied from the published snapshot without lock
  *
- * @param format output format
- * @param ... args
+ * @param filter the filter copy
  */
-void elog_raw_output(const char *format, ...) {
-    va_list args;
-    size_t log_len = 0;
-    int fmt_result;
-
-    /* check output enabled */
-    if (!elog.output_enabled) {
-        return;
-    }
-
-    /* args point to the first variable parameter */
-    va_start(args, format);
+void elog_get_filter(ElogFilter *filter)
+{
+    elog_inst_get_filter(&default_elog, filter);
+}
 
-    /* lock output */
-    elog_output_lock();
+void elog_inst_get_filter(EasyLogger_t elog, ElogFilter *filter)
+{
+    const ElogFilterSnapshot *snapshot;
+    uint32_t seq;
 
-    /* package log data to buffer */
-    fmt_result = vsnprintf(log_buf, ELOG_LINE_BUF_SIZE, format, args);
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(filter);
 
-    /* output converted log */
-    if ((fmt_result > -1) && (fmt_result <= ELOG_LINE_BUF_SIZE)) {
-        log_len = fmt_result;
-    } else {
-        log_len = ELOG_LINE_BUF_SIZE;
+    if (!elog->init_ok) {
+        memset(filter, 0, sizeof(ElogFilter));
+        return;
     }
-    /* output log */
-#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    extern void elog_async_output(uint8_t level, const char *log, size_t size);
-    /* raw log will using assert level */
-    elog_async_output(ELOG_LVL_ASSERT, log_buf, log_len);
-#elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
-#else
-    elog_port_output(log_buf, log_len);
-#endif
-    /* unlock output */
-    elog_output_unlock();
 
-    va_end(args);
+    do {
+        snapshot = filter_read_begin(elog, &seq);
+        memcpy(filter, &snapshot->filter, sizeof(ElogFilter));
+    } while (filter_read_retry(snapshot, seq));
 }
 
 /**
- * output the log
+ * get the log statistics
  *
- * @param level level
+ * @param stats the statistics copy
+ */
+void elog_get_stats(ElogStats *stats)
+{
+    elog_inst_get_stats(&default_elog, stats);
+}
+
+void elog_inst_get_stats(EasyLogger_t elog, ElogStats *stats)
+{
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    extern size_t elog_async_get_buf_used(ElogAsync *async);
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    extern size_t elog_buf_get_used(EasyLogger_t elog);
+#endif
+
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(stats);
+
+    elog_inst_output_lock(elog);
+    *stats = elog->stats;
+    stats->limited = FILTER_LOAD_RELAXED(&elog->stats.limited);
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    if (elog->async.buf) {
+        stats->async_used = elog_async_get_buf_used(&elog->async);
+        stats->async_size = elog->async.buf_size;
+    }
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    stats->buf_used = elog_buf_get_used(elog);
+    stats->buf_size = elog->buf.buf_size;
+#endif
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * output RAW format log
+ *
+ * @param format output format
+ * @param ... args
+ */
+void elog_raw_output(const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    elog_inst_vraw_output(&default_elog, format, args);
+    va_end(args);
+}
+
+void elog_inst_raw_output(EasyLogger_t elog, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    elog_inst_vraw_output(elog, format, args);
+    va_end(args);
+}
+
+/**
+ * output RAW format log by va_list
+ *
+ * @param elog EasyLogger object
+ * @param format output format
+ * @param args args
+ */
+void elog_inst_vraw_output(EasyLogger_t elog, const char *format, va_list args) {
+    char *log_buf = elog->log_buf;
+    size_t log_len = 0;
+    int fmt_result;
+
+    /* check output enabled */
+    if (!elog->output_enabled) {
+        return;
+    }
+
+    /* lock output */
+    elog_inst_output_lock(elog);
+
+    /* package log data to buffer */
+    fmt_result = vsnprintf(log_buf, ELOG_LINE_BUF_SIZE, format, args);
+
+    /* output converted log */
+    if ((fmt_result > -1) && (fmt_result <= ELOG_LINE_BUF_SIZE)) {
+        log_len = fmt_result;
+    } else {
+        log_len = ELOG_LINE_BUF_SIZE;
+    }
+    /* output log to all sinks, raw log will using assert level */
+    elog_sinks_output(elog, ELOG_LVL_ASSERT, log_buf, log_len);
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * output the log
+ *
+ * @param level level
  * @param tag tag
  * @param file file name
  * @param func function name
@@ -561,48 +1101,326 @@ void elog_raw_output(const char *format, ...) {
  */
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...) {
-    extern const char *elog_port_get_time(void);
-    extern const char *elog_port_get_p_info(void);
-    extern const char *elog_port_get_t_info(void);
+    va_list args;
 
-    size_t tag_len = strlen(tag), log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
-    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
-    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
+    va_start(args, format);
+    elog_inst_voutput(&default_elog, level, tag, file, func, line, format, args);
+    va_end(args);
+}
+
+void elog_inst_output(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    elog_inst_voutput(elog, level, tag, file, func, line, format, args);
+    va_end(args);
+}
+
+/**
+ * output the log by va_list
+ *
+ * @param elog EasyLogger object
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ *
+ */
+void elog_inst_voutput(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, va_list args) {
+    elog_inst_voutput_kv(elog, level, tag, file, func, line, NULL, 0, format, args);
+}
+
+/**
+ * output the log with extra key/value pairs
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param kv extra key/value pairs
+ * @param kv_num extra key/value pairs number
+ * @param format output format
+ * @param ... args
+ */
+void elog_output_kv(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const ElogKv *kv, size_t kv_num, const char *format, ...) {
     va_list args;
+
+    va_start(args, format);
+    elog_inst_voutput_kv(&default_elog, level, tag, file, func, line, kv, kv_num, format, args);
+    va_end(args);
+}
+
+void elog_inst_output_kv(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const ElogKv *kv, size_t kv_num, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    elog_inst_voutput_kv(elog, level, tag, file, func, line, kv, kv_num, format, args);
+    va_end(args);
+}
+
+/**
+ * output the log with extra key/value pairs by va_list
+ *
+ * @param elog EasyLogger object
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param kv extra key/value pairs, they are rendered after the message
+ * @param kv_num extra key/value pairs number
+ * @param format output format
+ * @param args args
+ */
+void elog_inst_voutput_kv(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const ElogKv *kv, size_t kv_num, const char *format, va_list args) {
+    char *msg_buf = elog->msg_buf;
+    ElogRecord rec = { 0 };
     int fmt_result;
 
+    if (!elog_output_check(elog, level, tag, file, func, line)) {
+        return;
+    }
+    /* lock output */
+    elog_inst_output_lock(elog);
+
+    /* package message to buffer. '\0' must be added in the end by vsnprintf. */
+    fmt_result = vsnprintf(msg_buf, ELOG_LINE_BUF_SIZE, format, args);
+    if ((fmt_result > -1) && (fmt_result < ELOG_LINE_BUF_SIZE)) {
+        rec.msg_len = fmt_result;
+    } else {
+        /* using max length */
+        rec.msg_len = ELOG_LINE_BUF_SIZE - 1;
+    }
+
+    rec.level = level;
+    rec.tag = tag;
+    rec.file = file;
+    rec.func = func;
+    rec.line = line;
+    rec.msg = msg_buf;
+    rec.kv = kv;
+    rec.kv_num = kv_num;
+    elog_record_output(elog, &rec);
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * output the structured log, the message isn't formatted and the typed fields are rendered by sink
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param msg constant message
+ * @param kv typed key/value pairs
+ * @param kv_num key/value pairs number
+ */
+void elog_output_fields(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *msg, const ElogKv *kv, size_t kv_num) {
+    elog_inst_output_fields(&default_elog, level, tag, file, func, line, msg, kv, kv_num);
+}
+
+void elog_inst_output_fields(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *msg, const ElogKv *kv, size_t kv_num) {
+    ElogRecord rec = { 0 };
+
+    ELOG_ASSERT(msg);
+
+    if (!elog_output_check(elog, level, tag, file, func, line)) {
+        return;
+    }
+    /* lock output */
+    elog_inst_output_lock(elog);
+
+    rec.level = level;
+    rec.tag = tag;
+    rec.file = file;
+    rec.func = func;
+    rec.line = line;
+    rec.msg = msg;
+    rec.msg_len = strlen(msg);
+    rec.kv = kv;
+    rec.kv_num = kv_num;
+    elog_record_output(elog, &rec);
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * check the log is enabled by output switch, level filter, tag filter, sampling and rate limit
+ *
+ * @param elog EasyLogger object
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ *
+ * @return true: the log will be output
+ */
+static bool elog_output_check(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        long line) {
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    extern bool elog_limit_check(EasyLogger_t elog, uint8_t level, const char *tag, const char *file,
+            const char *func, long line, uint32_t *suppressed);
+    uint32_t suppressed;
+#endif
+    const ElogFilterSnapshot *snapshot;
+    uint32_t seq;
+    bool result;
+
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
     /* check output enabled */
-    if (!elog.output_enabled) {
-        return;
+    if (!elog->output_enabled) {
+        return false;
+    }
+    /* level filter and tag filter, they are got from the published snapshot without lock */
+    do {
+        snapshot = filter_read_begin(elog, &seq);
+        result = level <= snapshot->filter.level && level <= filter_get_tag_lvl(&snapshot->filter, tag)
+                && strstr(tag, snapshot->filter.tag);
+    } while (filter_read_retry(snapshot, seq));
+    if (!result) {
+        return false;
     }
-    /* level filter */
-    if (level > elog.filter.level || level > elog_get_filter_tag_lvl(tag)) {
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    result = elog_limit_check(elog, level, tag, file, func, line, &suppressed);
+    if (!result) {
+        /* the check is lock free, so the counter is increased atomically */
+        STATS_INC_RELAXED(&elog->stats.limited);
+    }
+    if (suppressed) {
+        /* periodic summary for the suppressed log, it's not limited */
+        elog_inst_output_lock(elog);
+        elog_summary_output(elog, level, tag, "suppressed %lu messages", (unsigned long) suppressed);
+        elog_inst_output_unlock(elog);
+    }
+    return result;
+#else
+    (void) file;
+    (void) func;
+    (void) line;
+
+    return true;
+#endif
+}
+
+/**
+ * filter the log record by keyword then output it to all sinks, the output lock must be held
+ *
+ * @param elog EasyLogger object
+ * @param rec log record
+ */
+static void elog_record_output(EasyLogger_t elog, ElogRecord *rec) {
+#ifdef ELOG_DEDUP_ENABLE
+    extern bool elog_dedup_check(EasyLogger_t elog, const ElogRecord *rec);
+#endif
+    const ElogFilterSnapshot *snapshot;
+    uint32_t seq;
+    bool result;
+
+    /* keyword filter */
+    do {
+        snapshot = filter_read_begin(elog, &seq);
+        /* find the keyword */
+        result = snapshot->filter.keyword[0] == '\0' || strstr(rec->msg, snapshot->filter.keyword);
+    } while (filter_read_retry(snapshot, seq));
+    if (!result) {
+        elog->stats.filtered++;
         return;
-    } else if (!strstr(tag, elog.filter.tag)) { /* tag filter */
+    }
+#ifdef ELOG_DEDUP_ENABLE
+    /* the duplicate log is dropped before it's put to ring buffer */
+    if (elog_dedup_check(elog, rec)) {
+        elog->stats.deduped++;
         return;
     }
-    /* args point to the first variable parameter */
+#endif
+    elog->stats.output[rec->level]++;
+    /* render the record for each distinct sink format and output it */
+    elog_sinks_render_output(elog, rec);
+}
+
+/**
+ * Output the summary log which is generated by EasyLogger, such as the suppressed log number.
+ * It's output to all sinks without keyword filter and duplicate log suppression, the output lock must be held.
+ *
+ * @param elog EasyLogger object
+ * @param level level
+ * @param tag tag
+ * @param format output format
+ * @param ... args
+ */
+void elog_summary_output(EasyLogger_t elog, uint8_t level, const char *tag, const char *format, ...) {
+    ElogRecord rec = { 0 };
+    char msg[64];
+    va_list args;
+    int fmt_result;
+
     va_start(args, format);
-    /* lock output */
-    elog_output_lock();
+    fmt_result = vsnprintf(msg, sizeof(msg), format, args);
+    va_end(args);
+    if (fmt_result < 0) {
+        return;
+    }
+
+    rec.level = level;
+    rec.tag = tag;
+    rec.msg = msg;
+    rec.msg_len = (size_t) fmt_result < sizeof(msg) ? (size_t) fmt_result : sizeof(msg) - 1;
+    elog_sinks_render_output(elog, &rec);
+}
+
+/**
+ * render the log record to line log by format
+ *
+ * @param rec log record
+ * @param fmt format set
+ * @param color true: add the text color
+ * @param log_buf line log buffer, its size is ELOG_LINE_BUF_SIZE
+ *
+ * @return line log length
+ */
+static size_t elog_render(ElogRecord *rec, size_t fmt, bool color, char *log_buf) {
+    extern const char *elog_port_get_time(void);
+    extern const char *elog_port_get_p_info(void);
+    extern const char *elog_port_get_t_info(void);
+
+    uint8_t level = rec->level;
+    size_t tag_len = strlen(rec->tag), log_len = 0, msg_len, i, newline_len = strlen(ELOG_NEWLINE_SIGN);
+    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
+    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI start sign and color info */
-    if (elog.text_color_enabled) {
+    if (color) {
         log_len += elog_strcpy(log_len, log_buf + log_len, CSI_START);
         log_len += elog_strcpy(log_len, log_buf + log_len, color_output_info[level]);
     }
+#else
+    (void) color;
 #endif
 
     /* package level info */
-    if (get_fmt_enabled(level, ELOG_FMT_LVL)) {
+    if (get_fmt_enabled(fmt, ELOG_FMT_LVL)) {
         log_len += elog_strcpy(log_len, log_buf + log_len, level_output_info[level]);
     }
     /* package tag info */
-    if (get_fmt_enabled(level, ELOG_FMT_TAG)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, tag);
+    if (get_fmt_enabled(fmt, ELOG_FMT_TAG)) {
+        log_len += elog_strcpy(log_len, log_buf + log_len, rec->tag);
         /* if the tag length is less than 50% ELOG_FILTER_TAG_MAX_LEN, then fill space */
         if (tag_len <= ELOG_FILTER_TAG_MAX_LEN / 2) {
             memset(tag_sapce, ' ', ELOG_FILTER_TAG_MAX_LEN / 2 - tag_len);
@@ -611,67 +1429,82 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         log_len += elog_strcpy(log_len, log_buf + log_len, " ");
     }
     /* package time, process and thread info */
-    if (get_fmt_enabled(level, ELOG_FMT_TIME | ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
+    if (get_fmt_enabled(fmt, ELOG_FMT_TIME | ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
         log_len += elog_strcpy(log_len, log_buf + log_len, "[");
         /* package time info */
-        if (get_fmt_enabled(level, ELOG_FMT_TIME)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_time());
-            if (get_fmt_enabled(level, ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
+        if (get_fmt_enabled(fmt, ELOG_FMT_TIME)) {
+            if (!rec->time) {
+                rec->time = elog_port_get_time();
+            }
+            log_len += elog_strcpy(log_len, log_buf + log_len, rec->time);
+            if (get_fmt_enabled(fmt, ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
                 log_len += elog_strcpy(log_len, log_buf + log_len, " ");
             }
         }
         /* package process info */
-        if (get_fmt_enabled(level, ELOG_FMT_P_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_p_info());
-            if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
+        if (get_fmt_enabled(fmt, ELOG_FMT_P_INFO)) {
+            if (!rec->p_info) {
+                rec->p_info = elog_port_get_p_info();
+            }
+            log_len += elog_strcpy(log_len, log_buf + log_len, rec->p_info);
+            if (get_fmt_enabled(fmt, ELOG_FMT_T_INFO)) {
                 log_len += elog_strcpy(log_len, log_buf + log_len, " ");
             }
         }
         /* package thread info */
-        if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_t_info());
+        if (get_fmt_enabled(fmt, ELOG_FMT_T_INFO)) {
+            if (!rec->t_info) {
+                rec->t_info = elog_port_get_t_info();
+            }
+            log_len += elog_strcpy(log_len, log_buf + log_len, rec->t_info);
         }
         log_len += elog_strcpy(log_len, log_buf + log_len, "] ");
     }
     /* package file directory and name, function name and line number info */
-    if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_DIR, file) ||
-            get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func) ||
-            get_fmt_used_and_enabled_u32(level, ELOG_FMT_LINE, line)) {
+    if (get_fmt_used_and_enabled_ptr(fmt, ELOG_FMT_DIR, rec->file) ||
+            get_fmt_used_and_enabled_ptr(fmt, ELOG_FMT_FUNC, rec->func) ||
+            get_fmt_used_and_enabled_u32(fmt, ELOG_FMT_LINE, rec->line)) {
         log_len += elog_strcpy(log_len, log_buf + log_len, "(");
         /* package file info */
-        if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_DIR, file)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, file);
-            if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func)) {
+        if (get_fmt_used_and_enabled_ptr(fmt, ELOG_FMT_DIR, rec->file)) {
+            log_len += elog_strcpy(log_len, log_buf + log_len, rec->file);
+            if (get_fmt_used_and_enabled_ptr(fmt, ELOG_FMT_FUNC, rec->func)) {
                 log_len += elog_strcpy(log_len, log_buf + log_len, ":");
-            } else if (get_fmt_used_and_enabled_u32(level, ELOG_FMT_LINE, line)) {
+            } else if (get_fmt_used_and_enabled_u32(fmt, ELOG_FMT_LINE, rec->line)) {
                 log_len += elog_strcpy(log_len, log_buf + log_len, " ");
             }
         }
         /* package line info */
-        if (get_fmt_used_and_enabled_u32(level, ELOG_FMT_LINE, line)) {
-            snprintf(line_num, ELOG_LINE_NUM_MAX_LEN, "%ld", line);
+        if (get_fmt_used_and_enabled_u32(fmt, ELOG_FMT_LINE, rec->line)) {
+            snprintf(line_num, ELOG_LINE_NUM_MAX_LEN, "%ld", rec->line);
             log_len += elog_strcpy(log_len, log_buf + log_len, line_num);
-            if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func)) {
+            if (get_fmt_used_and_enabled_ptr(fmt, ELOG_FMT_FUNC, rec->func)) {
                 log_len += elog_strcpy(log_len, log_buf + log_len, " ");
             }
         }
         /* package func info */
-        if (get_fmt_used_and_enabled_ptr(level, ELOG_FMT_FUNC, func)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, func);
-            
+        if (get_fmt_used_and_enabled_ptr(fmt, ELOG_FMT_FUNC, rec->func)) {
+            log_len += elog_strcpy(log_len, log_buf + log_len, rec->func);
         }
         log_len += elog_strcpy(log_len, log_buf + log_len, ")");
     }
-    /* package other log data to buffer. '\0' must be added in the end by vsnprintf. */
-    fmt_result = vsnprintf(log_buf + log_len, ELOG_LINE_BUF_SIZE - log_len, format, args);
-
-    va_end(args);
-    /* calculate log length */
-    if ((log_len + fmt_result <= ELOG_LINE_BUF_SIZE) && (fmt_result > -1)) {
-        log_len += fmt_result;
-    } else {
-        /* using max length */
-        log_len = ELOG_LINE_BUF_SIZE;
+    /* package message */
+    msg_len = rec->msg_len;
+    if (log_len + msg_len > ELOG_LINE_BUF_SIZE) {
+        msg_len = ELOG_LINE_BUF_SIZE - log_len;
+    }
+    memcpy(log_buf + log_len, rec->msg, msg_len);
+    log_len += msg_len;
+    /* package extra key/value pairs */
+    for (i = 0; i < rec->kv_num; i++) {
+        log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+        log_len += elog_strcpy(log_len, log_buf + log_len, rec->kv[i].key);
+        log_len += elog_strcpy(log_len, log_buf + log_len, "=");
+        if (rec->kv[i].type == ELOG_KV_STR) {
+            log_len += elog_strcpy(log_len, log_buf + log_len, rec->kv[i].value.str ? rec->kv[i].value.str : "");
+        } else {
+            log_len += elog_kv_value_to_str(&rec->kv[i], log_buf + log_len, ELOG_LINE_BUF_SIZE - log_len);
+        }
     }
     /* overflow check and reserve some space for CSI end sign and newline sign */
 #ifdef ELOG_COLOR_ENABLE
@@ -688,64 +1521,225 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         /* reserve some space for newline sign */
         log_len -= newline_len;
     }
-    /* keyword filter */
-    if (elog.filter.keyword[0] != '\0') {
-        /* add string end sign */
-        log_buf[log_len] = '\0';
-        /* find the keyword */
-        if (!strstr(log_buf, elog.filter.keyword)) {
-            /* unlock output */
-            elog_output_unlock();
-            return;
-        }
-    }
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI end sign */
-    if (elog.text_color_enabled) {
+    if (color) {
         log_len += elog_strcpy(log_len, log_buf + log_len, CSI_END);
     }
 #endif
 
     /* package newline sign */
     log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
-    /* output log */
+
+    return log_len;
+}
+
+/**
+ * get the sink's format set on this level
+ *
+ * @param elog EasyLogger object
+ * @param sink sink
+ * @param level level
+ *
+ * @return format set
+ */
+static size_t sink_get_fmt(EasyLogger_t elog, ElogSink_t sink, uint8_t level) {
+    if (sink->fmt_set_flag & (1 << level)) {
+        return sink->fmt_set[level];
+    } else {
+        return elog->enabled_fmt_set[level];
+    }
+}
+
+/**
+ * get the registered sink's format set on this level, it's using by sink's render
+ *
+ * @param sink registered sink
+ * @param level level
+ *
+ * @return format set
+ */
+size_t elog_sink_get_fmt(ElogSink_t sink, uint8_t level) {
+    ELOG_ASSERT(sink->elog);
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    return sink_get_fmt(sink->elog, sink, level);
+}
+
+/**
+ * get the sink's text color is enabled
+ *
+ * @param elog EasyLogger object
+ * @param sink sink
+ *
+ * @return enable or disable
+ */
+static bool sink_get_color_enabled(EasyLogger_t elog, ElogSink_t sink) {
+#ifdef ELOG_COLOR_ENABLE
+    return elog->text_color_enabled && sink->text_color_enabled;
+#else
+    return false;
+#endif
+}
+
+/**
+ * the two sinks is rendering the same line log on this level
+ *
+ * @param elog EasyLogger object
+ * @param a sink
+ * @param b other sink
+ * @param level level
+ *
+ * @return true: same format
+ */
+static bool sink_fmt_equal(EasyLogger_t elog, ElogSink_t a, ElogSink_t b, uint8_t level) {
+    if (a->render != b->render) {
+        return false;
+    }
+    return sink_get_fmt(elog, a, level) == sink_get_fmt(elog, b, level)
+            && sink_get_color_enabled(elog, a) == sink_get_color_enabled(elog, b);
+}
+
+/**
+ * render the record by the sink
+ *
+ * @param elog EasyLogger object
+ * @param sink sink
+ * @param rec log record
+ *
+ * @return line log length in log_buf
+ */
+static size_t sink_render(EasyLogger_t elog, ElogSink_t sink, ElogRecord *rec) {
+    extern const char *elog_port_get_time(void);
+    extern const char *elog_port_get_p_info(void);
+    extern const char *elog_port_get_t_info(void);
+
+    if (!sink->render) {
+        return elog_render(rec, sink_get_fmt(elog, sink, rec->level), sink_get_color_enabled(elog, sink),
+                elog->log_buf);
+    }
+    /* the user render can use all record fields */
+    if (!rec->time) {
+        rec->time = elog_port_get_time();
+    }
+    if (!rec->p_info) {
+        rec->p_info = elog_port_get_p_info();
+    }
+    if (!rec->t_info) {
+        rec->t_info = elog_port_get_t_info();
+    }
+    return sink->render(sink, rec, elog->log_buf, ELOG_LINE_BUF_SIZE);
+}
+
+/**
+ * output the line log to the sink by asynchronous, buffered or directly mode
+ *
+ * @param elog EasyLogger object
+ * @param sink sink
+ * @param level level
+ * @param log log
+ * @param size log size
+ */
+static void sink_do_output(EasyLogger_t elog, ElogSink_t sink, uint8_t level, const char *log, size_t size) {
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    extern void elog_async_output(uint8_t level, const char *log, size_t size);
-    elog_async_output(level, log_buf, log_len);
+    extern void elog_async_output(ElogAsync *async, uint8_t level, const char *log, size_t size);
 #elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
+    extern void elog_buf_output(EasyLogger_t elog, const char *log, size_t size);
+#endif
+
+    if (sink == &elog->output_sink) {
+        /* the output interface is using object's asynchronous or buffered output mode */
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+        elog_async_output(&elog->async, level, log, size);
+#elif defined(ELOG_BUF_OUTPUT_ENABLE)
+        elog_buf_output(elog, log, size);
 #else
-    elog_port_output(log_buf, log_len);
+        sink->output(log, size);
 #endif
-    /* unlock output */
-    elog_output_unlock();
+    } else {
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+        elog_async_output(&sink->async, level, log, size);
+#else
+        sink->output(log, size);
+#endif
+    }
 }
 
 /**
- * get format enabled
+ * output the same line log to all sinks which level is matched
  *
+ * @param elog EasyLogger object
  * @param level level
+ * @param log log
+ * @param size log size
+ */
+static void elog_sinks_output(EasyLogger_t elog, uint8_t level, const char *log, size_t size) {
+    ElogSink_t sink;
+
+    for (sink = elog->sinks; sink; sink = sink->next) {
+        if (level <= sink->level) {
+            sink_do_output(elog, sink, level, log, size);
+        }
+    }
+}
+
+/**
+ * Render the log record and output it to all sinks which level is matched.
+ * The record is rendered only once for each distinct format, the sinks which have same format share it.
+ *
+ * @param elog EasyLogger object
+ * @param rec log record
+ */
+static void elog_sinks_render_output(EasyLogger_t elog, ElogRecord *rec) {
+    uint8_t level = rec->level;
+    ElogSink_t sink, other;
+    size_t log_len;
+
+    for (sink = elog->sinks; sink; sink = sink->next) {
+        if (level > sink->level) {
+            continue;
+        }
+        /* it has been rendered and output when the previous sink has same format */
+        for (other = elog->sinks; other != sink; other = other->next) {
+            if (level <= other->level && sink_fmt_equal(elog, sink, other, level)) {
+                break;
+            }
+        }
+        if (other != sink) {
+            continue;
+        }
+        log_len = sink_render(elog, sink, rec);
+        /* output to this sink and the following sinks which have same format */
+        for (other = sink; other; other = other->next) {
+            if (level <= other->level && sink_fmt_equal(elog, sink, other, level)) {
+                sink_do_output(elog, other, level, elog->log_buf, log_len);
+            }
+        }
+    }
+}
+
+/**
+ * get format enabled
+ *
+ * @param fmt enabled format set
  * @param set format set
  *
  * @return enable or disable
  */
-static bool get_fmt_enabled(uint8_t level, size_t set) {
-    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
-
-    if (elog.enabled_fmt_set[level] & set) {
+static bool get_fmt_enabled(size_t fmt, size_t set) {
+    if (fmt & set) {
         return true;
     } else {
         return false;
     }
 }
 
-static bool get_fmt_used_and_enabled_u32(uint8_t level, size_t set, uint32_t arg) {
-    return arg && get_fmt_enabled(level, set);
+static bool get_fmt_used_and_enabled_u32(size_t fmt, size_t set, uint32_t arg) {
+    return arg && get_fmt_enabled(fmt, set);
 }
-static bool get_fmt_used_and_enabled_ptr(uint8_t level, size_t set, const char* arg) {
-    return arg && get_fmt_enabled(level, set);
+static bool get_fmt_used_and_enabled_ptr(size_t fmt, size_t set, const char* arg) {
+    return arg && get_fmt_enabled(fmt, set);
 }
 
 /**
@@ -755,15 +1749,19 @@ static bool get_fmt_used_and_enabled_ptr(uint8_t level, size_t set, const char*
  * @param enabled true: enable  false: disable
  */
 void elog_output_lock_enabled(bool enabled) {
-    elog.output_lock_enabled = enabled;
+    elog_inst_output_lock_enabled(&default_elog, enabled);
+}
+
+void elog_inst_output_lock_enabled(EasyLogger_t elog, bool enabled) {
+    elog->output_lock_enabled = enabled;
     /* it will re-lock or re-unlock before output lock enable */
-    if (elog.output_lock_enabled) {
-        if (!elog.output_is_locked_before_disable && elog.output_is_locked_before_enable) {
+    if (elog->output_lock_enabled && elog->output_lock && elog->output_unlock) {
+        if (!elog->output_is_locked_before_disable && elog->output_is_locked_before_enable) {
             /* the output lock is unlocked before disable, and the lock will unlocking after enable */
-            elog_port_output_lock();
-        } else if (elog.output_is_locked_before_disable && !elog.output_is_locked_before_enable) {
+            elog->output_lock(elog->lock_arg);
+        } else if (elog->output_is_locked_before_disable && !elog->output_is_locked_before_enable) {
             /* the output lock is locked before disable, and the lock will locking after enable */
-            elog_port_output_unlock();
+            elog->output_unlock(elog->lock_arg);
         }
     }
 }
@@ -777,6 +1775,28 @@ void elog_assert_set_hook(void (*hook)(const char* expr, const char* func, size_
     elog_assert_hook = hook;
 }
 
+/**
+ * skip the CSI start sign and color info at the beginning of the log
+ *
+ * @param log log buffer
+ *
+ * @return the log after color info
+ */
+static const char *skip_color_info(const char *log) {
+#ifdef ELOG_COLOR_ENABLE
+    const char *color_end;
+
+    if (!strncmp(log, CSI_START, strlen(CSI_START))) {
+        /* all color info is end with the font style, such as: "22m" */
+        if ((color_end = strchr(log, 'm')) != NULL) {
+            return color_end + 1;
+        }
+    }
+#endif
+
+    return log;
+}
+
 /**
  * find the log level
  * @note make sure the log level is output on each format
@@ -788,24 +1808,16 @@ void elog_assert_set_hook(void (*hook)(const char* expr, const char* func, size_
 int8_t elog_find_lvl(const char *log) {
     ELOG_ASSERT(log);
     /* make sure the log level is output on each format */
-    ELOG_ASSERT(elog.enabled_fmt_set[ELOG_LVL_ASSERT] & ELOG_FMT_LVL);
-    ELOG_ASSERT(elog.enabled_fmt_set[ELOG_LVL_ERROR] & ELOG_FMT_LVL);
-    ELOG_ASSERT(elog.enabled_fmt_set[ELOG_LVL_WARN] & ELOG_FMT_LVL);
-    ELOG_ASSERT(elog.enabled_fmt_set[ELOG_LVL_INFO] & ELOG_FMT_LVL);
-    ELOG_ASSERT(elog.enabled_fmt_set[ELOG_LVL_DEBUG] & ELOG_FMT_LVL);
-    ELOG_ASSERT(elog.enabled_fmt_set[ELOG_LVL_VERBOSE] & ELOG_FMT_LVL);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[ELOG_LVL_ASSERT] & ELOG_FMT_LVL);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[ELOG_LVL_ERROR] & ELOG_FMT_LVL);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[ELOG_LVL_WARN] & ELOG_FMT_LVL);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[ELOG_LVL_INFO] & ELOG_FMT_LVL);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[ELOG_LVL_DEBUG] & ELOG_FMT_LVL);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[ELOG_LVL_VERBOSE] & ELOG_FMT_LVL);
+
+    /* the log which is output to the sink without text color has no CSI sign */
+    log = skip_color_info(log);
 
-#ifdef ELOG_COLOR_ENABLE
-    uint8_t i;
-    size_t csi_start_len = strlen(CSI_START);
-    for(i = 0; i < ELOG_LVL_TOTAL_NUM; i ++) {
-        if (!strncmp(color_output_info[i], log + csi_start_len, strlen(color_output_info[i]))) {
-            return i;
-        }
-    }
-    /* found failed */
-    return -1;
-#else
     switch (log[0]) {
     case 'A': return ELOG_LVL_ASSERT;
     case 'E': return ELOG_LVL_ERROR;
@@ -815,7 +1827,6 @@ int8_t elog_find_lvl(const char *log) {
     case 'V': return ELOG_LVL_VERBOSE;
     default: return -1;
     }
-#endif
 }
 
 /**
@@ -836,13 +1847,9 @@ const char *elog_find_tag(const char *log, uint8_t lvl, size_t *tag_len) {
     ELOG_ASSERT(tag_len);
     ELOG_ASSERT(lvl < ELOG_LVL_TOTAL_NUM);
     /* make sure the log tag is output on each format */
-    ELOG_ASSERT(elog.enabled_fmt_set[lvl] & ELOG_FMT_TAG);
+    ELOG_ASSERT(default_elog.enabled_fmt_set[lvl] & ELOG_FMT_TAG);
 
-#ifdef ELOG_COLOR_ENABLE
-    tag = log + strlen(CSI_START) + strlen(color_output_info[lvl]) + strlen(level_output_info[lvl]);
-#else
-    tag = log + strlen(level_output_info[lvl]);
-#endif
+    tag = skip_color_info(log) + strlen(level_output_info[lvl]);
     /* find the first space after tag */
     if ((tag_end = memchr(tag, ' ', ELOG_FILTER_TAG_MAX_LEN)) != NULL) {
         *tag_len = tag_end - tag;
@@ -862,28 +1869,39 @@ const char *elog_find_tag(const char *log, uint8_t lvl, size_t *tag_len) {
  * @param size buffer size
  */
 void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t size)
+{
+    elog_inst_hexdump(&default_elog, name, width, buf, size);
+}
+
+void elog_inst_hexdump(EasyLogger_t elog, const char *name, uint8_t width, const void *buf, uint16_t size)
 {
 #define __is_print(ch)       ((unsigned int)((ch) - ' ') < 127u - ' ')
 
     uint16_t i, j;
     uint16_t log_len = 0;
     const uint8_t *buf_p = buf;
+    char *log_buf = elog->log_buf;
     char dump_string[8] = {0};
     int fmt_result;
+    const ElogFilterSnapshot *snapshot;
+    uint32_t seq;
+    bool result;
 
-    if (!elog.output_enabled) {
+    if (!elog->output_enabled) {
         return;
     }
 
-    /* level filter */
-    if (ELOG_LVL_DEBUG > elog.filter.level) {
-        return;
-    } else if (!strstr(name, elog.filter.tag)) { /* tag filter */
+    /* level filter and tag filter */
+    do {
+        snapshot = filter_read_begin(elog, &seq);
+        result = ELOG_LVL_DEBUG <= snapshot->filter.level && strstr(name, snapshot->filter.tag);
+    } while (filter_read_retry(snapshot, seq));
+    if (!result) {
         return;
     }
 
     /* lock output */
-    elog_output_lock();
+    elog_inst_output_lock(elog);
 
     for (i = 0; i < size; i += width) {
         /* package header */
@@ -921,16 +1939,8 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
         /* package newline sign */
         log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
         /* do log output */
-#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-        extern void elog_async_output(uint8_t level, const char *log, size_t size);
-        elog_async_output(ELOG_LVL_DEBUG, log_buf, log_len);
-#elif defined(ELOG_BUF_OUTPUT_ENABLE)
-        extern void elog_buf_output(const char *log, size_t size);
-        elog_buf_output(log_buf, log_len);
-#else
-        elog_port_output(log_buf, log_len);
-#endif
+        elog_sinks_output(elog, ELOG_LVL_DEBUG, log_buf, log_len);
     }
     /* unlock output */
-    elog_output_unlock();
+    elog_inst_output_unlock(elog);
 }
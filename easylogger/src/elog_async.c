@@ -28,6 +28,7 @@
 
 #include <elog.h>
 #include <string.h>
+#include <stdlib.h>
 
 #ifdef ELOG_ASYNC_OUTPUT_ENABLE
 
@@ -35,6 +36,7 @@
 #include <pthread.h>
 #include <sched.h>
 #include <semaphore.h>
+#include <time.h>
 /* thread default stack size */
 #ifndef ELOG_ASYNC_OUTPUT_PTHREAD_STACK_SIZE
 #if PTHREAD_STACK_MIN > 4*1024
@@ -58,10 +60,6 @@
 #endif
 #endif /* ELOG_ASYNC_OUTPUT_PTHREAD_STACK_SIZE */
 
-/* asynchronous output log notice */
-static sem_t output_notice;
-/* asynchronous output pthread thread */
-static pthread_t async_output_thread;
 #endif /* ELOG_ASYNC_OUTPUT_USING_PTHREAD */
 
 /* the highest output level for async mode, other level will sync output */
@@ -78,42 +76,33 @@ static pthread_t async_output_thread;
 #define OUTPUT_BUF_SIZE                          (ELOG_LINE_BUF_SIZE * 10)
 #endif /* ELOG_ASYNC_OUTPUT_BUF_SIZE */
 
-/* Initialize OK flag */
-static bool init_ok = false;
-#ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
-/* thread running flag */
-static bool thread_running = false;
-#endif
-/* asynchronous output mode enabled flag */
-static bool is_enabled = false;
-/* asynchronous output mode's ring buffer */
+/* default object's asynchronous output mode ring buffer */
 static char log_buf[OUTPUT_BUF_SIZE] = { 0 };
-/* log ring buffer write index */
-static size_t write_index = 0;
-/* log ring buffer read index */
-static size_t read_index = 0;
-/* log ring buffer full flag */
-static bool buf_is_full = false;
-/* log ring buffer empty flag */
-static bool buf_is_empty = true;
-
-extern void elog_port_output(const char *log, size_t size);
-extern void elog_output_lock(void);
-extern void elog_output_unlock(void);
+
+extern void elog_inst_output_lock(EasyLogger_t elog);
+extern void elog_inst_output_unlock(EasyLogger_t elog);
+
+#ifdef ELOG_ASYNC_LINE_OUTPUT
+static size_t async_get_line_log(ElogAsync *async, char *log, size_t size);
+#else
+static size_t async_get_log(ElogAsync *async, char *log, size_t size);
+#endif
 
 /**
  * asynchronous output ring buffer used size
  *
+ * @param async asynchronous output object
+ *
  * @return used size
  */
-static size_t elog_async_get_buf_used(void) {
-    if (write_index > read_index) {
-        return write_index - read_index;
+size_t elog_async_get_buf_used(ElogAsync *async) {
+    if (async->write_index > async->read_index) {
+        return async->write_index - async->read_index;
     } else {
-        if (!buf_is_full && !buf_is_empty) {
-            return OUTPUT_BUF_SIZE - (read_index - write_index);
-        } else if (buf_is_full) {
-            return OUTPUT_BUF_SIZE;
+        if (!async->buf_is_full && !async->buf_is_empty) {
+            return async->buf_size - (async->read_index - async->write_index);
+        } else if (async->buf_is_full) {
+            return async->buf_size;
         } else {
             return 0;
         }
@@ -123,52 +112,82 @@ static size_t elog_async_get_buf_used(void) {
 /**
  * asynchronous output ring buffer remain space
  *
+ * @param async asynchronous output object
+ *
  * @return remain space
  */
-static size_t async_get_buf_space(void) {
-    return OUTPUT_BUF_SIZE - elog_async_get_buf_used();
+static size_t async_get_buf_space(ElogAsync *async) {
+    return async->buf_size - elog_async_get_buf_used(async);
 }
 
 /**
  * put log to asynchronous output ring buffer
  *
+ * @param async asynchronous output object
  * @param log put log buffer
  * @param size log size
  *
  * @return put log size, the log which beyond ring buffer space will be dropped
  */
-static size_t async_put_log(const char *log, size_t size) {
+static size_t async_put_log(ElogAsync *async, const char *log, size_t size) {
     size_t space = 0;
 
-    space = async_get_buf_space();
+    space = async_get_buf_space(async);
     /* no space */
     if (!space) {
         size = 0;
+        async->elog->stats.dropped++;
         goto __exit;
     }
     /* drop some log */
     if (space <= size) {
         size = space;
-        buf_is_full = true;
+        async->buf_is_full = true;
+        async->elog->stats.dropped++;
     }
 
-    if (write_index + size < OUTPUT_BUF_SIZE) {
-        memcpy(log_buf + write_index, log, size);
-        write_index += size;
+    if (async->write_index + size < async->buf_size) {
+        memcpy(async->buf + async->write_index, log, size);
+        async->write_index += size;
     } else {
-        memcpy(log_buf + write_index, log, OUTPUT_BUF_SIZE - write_index);
-        memcpy(log_buf, log + OUTPUT_BUF_SIZE - write_index,
-                size - (OUTPUT_BUF_SIZE - write_index));
-        write_index += size - OUTPUT_BUF_SIZE;
+        memcpy(async->buf + async->write_index, log, async->buf_size - async->write_index);
+        memcpy(async->buf, log + async->buf_size - async->write_index,
+                size - (async->buf_size - async->write_index));
+        async->write_index += size - async->buf_size;
     }
 
-    buf_is_empty = false;
+    async->buf_is_empty = false;
+#ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
+    async->put_total += size;
+#endif
+
+#ifdef ELOG_BLACKBOX_ENABLE
+    /* the header is updated after the log is copied, so it's always consistent when the process is crashed */
+    if (async->blackbox) {
+        async->blackbox->async_write = async->write_index;
+        async->blackbox->async_unflushed += size;
+    }
+#endif
 
 __exit:
 
     return size;
 }
 
+#ifdef ELOG_BLACKBOX_ENABLE
+/**
+ * mark the log which is got from ring buffer is output, the caller must hold the output lock
+ *
+ * @param async asynchronous output object
+ * @param size output log size
+ */
+static void async_blackbox_flushed(ElogAsync *async, size_t size) {
+    if (async->blackbox) {
+        async->blackbox->async_unflushed -= size;
+    }
+}
+#endif
+
 #ifdef ELOG_ASYNC_LINE_OUTPUT
 /**
  * Get line log from asynchronous output ring buffer.
@@ -180,10 +199,36 @@ __exit:
  * @return get line log size, the log size is less than ring buffer used size
  */
 size_t elog_async_get_line_log(char *log, size_t size) {
-    size_t used = 0, cpy_log_size = 0;
+    return elog_inst_async_get_line_log(elog_get_default(), log, size);
+}
+
+size_t elog_inst_async_get_line_log(EasyLogger_t elog, char *log, size_t size) {
+    size_t cpy_log_size = 0;
     /* lock output */
-    elog_output_lock();
-    used = elog_async_get_buf_used();
+    elog_inst_output_lock(elog);
+    cpy_log_size = async_get_line_log(&elog->async, log, size);
+#ifdef ELOG_BLACKBOX_ENABLE
+    /* the log is handed over to user */
+    async_blackbox_flushed(&elog->async, cpy_log_size);
+#endif
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+    return cpy_log_size;
+}
+
+/**
+ * get line log from the asynchronous output ring buffer, the caller must hold the output lock
+ *
+ * @param async asynchronous output object
+ * @param log get line log buffer
+ * @param size line log size
+ *
+ * @return get line log size
+ */
+static size_t async_get_line_log(ElogAsync *async, char *log, size_t size) {
+    size_t used = 0, cpy_log_size = 0;
+
+    used = elog_async_get_buf_used(async);
 
     /* no log */
     if (!used || !size) {
@@ -194,30 +239,28 @@ size_t elog_async_get_line_log(char *log, size_t size) {
         size = used;
     }
 
-    if (read_index + size < OUTPUT_BUF_SIZE) {
-        cpy_log_size = elog_cpyln(log, log_buf + read_index, size);
-        read_index += cpy_log_size;
+    if (async->read_index + size < async->buf_size) {
+        cpy_log_size = elog_cpyln(log, async->buf + async->read_index, size);
+        async->read_index += cpy_log_size;
     } else {
-        cpy_log_size = elog_cpyln(log, log_buf + read_index, OUTPUT_BUF_SIZE - read_index);
-        if (cpy_log_size == OUTPUT_BUF_SIZE - read_index) {
-            cpy_log_size += elog_cpyln(log + cpy_log_size, log_buf, size - cpy_log_size);
-            read_index += cpy_log_size - OUTPUT_BUF_SIZE;
+        cpy_log_size = elog_cpyln(log, async->buf + async->read_index, async->buf_size - async->read_index);
+        if (cpy_log_size == async->buf_size - async->read_index) {
+            cpy_log_size += elog_cpyln(log + cpy_log_size, async->buf, size - cpy_log_size);
+            async->read_index += cpy_log_size - async->buf_size;
         } else {
-            read_index += cpy_log_size;
+            async->read_index += cpy_log_size;
         }
     }
 
     if (used == cpy_log_size) {
-        buf_is_empty = true;
+        async->buf_is_empty = true;
     }
 
     if (cpy_log_size) {
-        buf_is_full = false;
+        async->buf_is_full = false;
     }
 
 __exit:
-    /* lock output */
-    elog_output_unlock();
     return cpy_log_size;
 }
 #else
@@ -230,10 +273,35 @@ __exit:
  * @return get log size, the log size is less than ring buffer used size
  */
 size_t elog_async_get_log(char *log, size_t size) {
-    size_t used = 0;
+    return elog_inst_async_get_log(elog_get_default(), log, size);
+}
+
+size_t elog_inst_async_get_log(EasyLogger_t elog, char *log, size_t size) {
     /* lock output */
-    elog_output_lock();
-    used = elog_async_get_buf_used();
+    elog_inst_output_lock(elog);
+    size = async_get_log(&elog->async, log, size);
+#ifdef ELOG_BLACKBOX_ENABLE
+    /* the log is handed over to user */
+    async_blackbox_flushed(&elog->async, size);
+#endif
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+    return size;
+}
+
+/**
+ * get log from the asynchronous output ring buffer, the caller must hold the output lock
+ *
+ * @param async asynchronous output object
+ * @param log get log buffer
+ * @param size log size
+ *
+ * @return get log size
+ */
+static size_t async_get_log(ElogAsync *async, char *log, size_t size) {
+    size_t used = 0;
+
+    used = elog_async_get_buf_used(async);
     /* no log */
     if (!used || !size) {
         size = 0;
@@ -242,76 +310,262 @@ size_t elog_async_get_log(char *log, size_t size) {
     /* less log */
     if (used <= size) {
         size = used;
-        buf_is_empty = true;
+        async->buf_is_empty = true;
     }
 
-    if (read_index + size < OUTPUT_BUF_SIZE) {
-        memcpy(log, log_buf + read_index, size);
-        read_index += size;
+    if (async->read_index + size < async->buf_size) {
+        memcpy(log, async->buf + async->read_index, size);
+        async->read_index += size;
     } else {
-        memcpy(log, log_buf + read_index, OUTPUT_BUF_SIZE - read_index);
-        memcpy(log + OUTPUT_BUF_SIZE - read_index, log_buf,
-                size - (OUTPUT_BUF_SIZE - read_index));
-        read_index += size - OUTPUT_BUF_SIZE;
+        memcpy(log, async->buf + async->read_index, async->buf_size - async->read_index);
+        memcpy(log + async->buf_size - async->read_index, async->buf,
+                size - (async->buf_size - async->read_index));
+        async->read_index += size - async->buf_size;
     }
 
-    buf_is_full = false;
+    async->buf_is_full = false;
 
 __exit:
-    /* lock output */
-    elog_output_unlock();
     return size;
 }
 #endif /* ELOG_ASYNC_LINE_OUTPUT */
 
-void elog_async_output(uint8_t level, const char *log, size_t size) {
-    /* this function must be implement by user when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined */
-    extern void elog_async_output_notice(void);
+/**
+ * poll the log from asynchronous output ring buffer, it's line log when ELOG_ASYNC_LINE_OUTPUT is defined
+ *
+ * @param async asynchronous output object
+ * @param log get log buffer
+ * @param size log size
+ *
+ * @return get log size
+ */
+static size_t async_poll_log(ElogAsync *async, char *log, size_t size) {
+    /* lock output */
+    elog_inst_output_lock(async->elog);
+#ifdef ELOG_ASYNC_LINE_OUTPUT
+    size = async_get_line_log(async, log, size);
+#else
+    size = async_get_log(async, log, size);
+#endif
+    /* unlock output */
+    elog_inst_output_unlock(async->elog);
+    return size;
+}
+
+/**
+ * get log from the sink's asynchronous output ring buffer.
+ * It's used to output the sink's log when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined.
+ *
+ * @param sink registered sink
+ * @param log get log buffer
+ * @param size log size
+ *
+ * @return get log size
+ */
+size_t elog_sink_async_get_log(ElogSink_t sink, char *log, size_t size) {
+    ELOG_ASSERT(sink);
+
+    if (!sink->async.init_ok) {
+        return 0;
+    }
+
+    return async_poll_log(&sink->async, log, size);
+}
+
+/**
+ * Wait until the log which is put into the sink's asynchronous ring buffer before is output by its thread.
+ * It returns immediately when the sink outputs directly or ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined.
+ * The caller must not hold the output lock.
+ *
+ * @param sink registered sink
+ */
+void elog_sink_async_flush(ElogSink_t sink) {
+#ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
+    ElogAsync *async;
+    size_t put_total;
+
+    ELOG_ASSERT(sink);
+
+    async = &sink->async;
+    if (!async->init_ok) {
+        return;
+    }
+
+    elog_inst_output_lock(async->elog);
+    put_total = async->put_total;
+    elog_inst_output_unlock(async->elog);
+
+    pthread_mutex_lock(&async->output_total_lock);
+    /* the total size may wrap around */
+    while ((ptrdiff_t) (put_total - async->output_total) > 0 && async->thread_running) {
+        pthread_cond_wait(&async->output_done, &async->output_total_lock);
+    }
+    pthread_mutex_unlock(&async->output_total_lock);
+#else
+    (void) sink;
+#endif
+}
+
+#ifdef ELOG_EMERGENCY_ENABLE
+/**
+ * Drain all log in ring buffer to the output without copying, it's used by emergency flush.
+ * The caller must hold the output lock.
+ *
+ * @param async asynchronous output object
+ * @param output async-signal-safe output interface
+ */
+void elog_async_emergency_drain(ElogAsync *async, void (*output)(const char *log, size_t size)) {
+    size_t used = elog_async_get_buf_used(async);
+
+    if (!async->init_ok || !used) {
+        return;
+    }
+
+    if (async->read_index + used <= async->buf_size) {
+        output(async->buf + async->read_index, used);
+    } else {
+        output(async->buf + async->read_index, async->buf_size - async->read_index);
+        output(async->buf, used - (async->buf_size - async->read_index));
+    }
+    async->read_index = async->write_index;
+    async->buf_is_full = false;
+    async->buf_is_empty = true;
+#ifdef ELOG_BLACKBOX_ENABLE
+    async_blackbox_flushed(async, used);
+#endif
+}
+#endif /* ELOG_EMERGENCY_ENABLE */
+
+void elog_async_output(ElogAsync *async, uint8_t level, const char *log, size_t size) {
     size_t put_size;
 
-    if (is_enabled) {
+    if (async->is_enabled) {
         if (level >= OUTPUT_LVL) {
-            put_size = async_put_log(log, size);
+            put_size = async_put_log(async, log, size);
             /* notify output log thread */
             if (put_size > 0) {
-                elog_async_output_notice();
+#ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
+                sem_post(&async->output_notice);
+#else
+                async->notice();
+#endif
             }
         } else {
-            elog_port_output(log, size);
+            async->output(log, size);
         }
     } else {
-        elog_port_output(log, size);
+        async->output(log, size);
     }
 }
 
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
 void elog_async_output_notice(void) {
-    sem_post(&output_notice);
+    sem_post(&elog_get_default()->async.output_notice);
+}
+
+/**
+ * wake up the object's output thread, it checks the expired summary then waits again
+ *
+ * @param async the object's asynchronous output object
+ */
+void elog_async_wakeup(ElogAsync *async) {
+    if (async->init_ok) {
+        sem_post(&async->output_notice);
+    }
+}
+
+#if defined(ELOG_DEDUP_ENABLE) || defined(ELOG_RATE_LIMIT_ENABLE)
+/**
+ * waiting log until the duplicate log suppression window or the suppressed log report interval is expired
+ *
+ * @param async asynchronous output object
+ * @param timeout_ms timeout (ms), 0: waiting forever
+ */
+static void async_wait(ElogAsync *async, uint32_t timeout_ms) {
+    struct timespec deadline;
+
+    if (!timeout_ms) {
+        sem_wait(&async->output_notice);
+        return;
+    }
+    /* semaphore only supports the realtime clock */
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    sem_timedwait(&async->output_notice, &deadline);
 }
+#endif
 
 static void *async_output(void *arg) {
+    ElogAsync *async = arg;
     size_t get_log_size = 0;
-    static char poll_get_buf[ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE];
+    /* every output thread has its own poll buffer */
+    char *poll_get_buf = malloc(ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+#ifdef ELOG_DEDUP_ENABLE
+    extern uint32_t elog_dedup_expire(EasyLogger_t elog);
+#endif
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    extern uint32_t elog_limit_expire(EasyLogger_t elog);
+    uint32_t limit_timeout;
+#endif
+#if defined(ELOG_DEDUP_ENABLE) || defined(ELOG_RATE_LIMIT_ENABLE)
+    uint32_t timeout = 0;
+#endif
 
-    while(thread_running) {
+    while(async->thread_running) {
         /* waiting log */
-        sem_wait(&output_notice);
-        /* polling gets and outputs the log */
-        while(true) {
-
-#ifdef ELOG_ASYNC_LINE_OUTPUT
-            get_log_size = elog_async_get_line_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+#if defined(ELOG_DEDUP_ENABLE) || defined(ELOG_RATE_LIMIT_ENABLE)
+        async_wait(async, timeout);
+        /* the object's output thread outputs the repeated number and suppressed number when they're expired */
+        if (async == &async->elog->async) {
+            elog_inst_output_lock(async->elog);
+            timeout = 0;
+#ifdef ELOG_DEDUP_ENABLE
+            timeout = elog_dedup_expire(async->elog);
+#endif
+#ifdef ELOG_RATE_LIMIT_ENABLE
+            limit_timeout = elog_limit_expire(async->elog);
+            if (limit_timeout && (timeout == 0 || limit_timeout < timeout)) {
+                timeout = limit_timeout;
+            }
+#endif
+            elog_inst_output_unlock(async->elog);
+        }
 #else
-            get_log_size = elog_async_get_log(poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
+        sem_wait(&async->output_notice);
 #endif
-
+        /* polling gets and outputs the log */
+        while(poll_get_buf) {
+            get_log_size = async_poll_log(async, poll_get_buf, ELOG_ASYNC_POLL_GET_LOG_BUF_SIZE);
             if (get_log_size) {
-                elog_port_output(poll_get_buf, get_log_size);
+                async->output(poll_get_buf, get_log_size);
+#ifdef ELOG_BLACKBOX_ENABLE
+                /* the log is kept in black box until it's output */
+                if (async->blackbox) {
+                    elog_inst_output_lock(async->elog);
+                    async_blackbox_flushed(async, get_log_size);
+                    elog_inst_output_unlock(async->elog);
+                }
+#endif
+                /* wake up the threads which are flushing the sink */
+                pthread_mutex_lock(&async->output_total_lock);
+                async->output_total += get_log_size;
+                pthread_cond_broadcast(&async->output_done);
+                pthread_mutex_unlock(&async->output_total_lock);
             } else {
                 break;
             }
         }
     }
+    /* the flushing threads stop waiting */
+    pthread_mutex_lock(&async->output_total_lock);
+    pthread_cond_broadcast(&async->output_done);
+    pthread_mutex_unlock(&async->output_total_lock);
+    free(poll_get_buf);
     return NULL;
 }
 #endif
@@ -323,28 +577,73 @@ static void *async_output(void *arg) {
  * @param enabled true: enabled, false: disabled
  */
 void elog_async_enabled(bool enabled) {
-    is_enabled = enabled;
+    elog_inst_async_enabled(elog_get_default(), enabled);
+}
+
+void elog_inst_async_enabled(EasyLogger_t elog, bool enabled) {
+    /* the object which has no ring buffer is always output directly */
+    elog->async.is_enabled = enabled && elog->async.init_ok;
+}
+
+/**
+ * get the default object's asynchronous output configuration
+ *
+ * @param cfg configuration
+ */
+void elog_async_default_cfg(ElogCfg *cfg) {
+    extern void elog_async_output_notice(void);
+
+    cfg->async_buf = log_buf;
+    cfg->async_buf_size = OUTPUT_BUF_SIZE;
+    /* this function must be implement by user when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined */
+    cfg->async_notice = elog_async_output_notice;
 }
 
 /**
  * asynchronous output mode initialize
  *
+ * @param async asynchronous output object of the EasyLogger object or sink
+ * @param elog owner EasyLogger object, its output lock will protect the ring buffer
+ * @param output output interface for the log which is got from ring buffer
+ * @param buf ring buffer, NULL: the log will output directly
+ * @param size ring buffer size
+ * @param notice output notice, it's unused when using pthread
+ *
  * @return result
  */
-ElogErrCode elog_async_init(void) {
+ElogErrCode elog_async_init(ElogAsync *async, EasyLogger_t elog, void (*output)(const char *log, size_t size),
+        char *buf, size_t size, void (*notice)(void)) {
     ElogErrCode result = ELOG_NO_ERR;
 
-    if (init_ok) {
+    if (async->init_ok) {
         return result;
     }
 
+    async->elog = elog;
+    async->output = output;
+    if (!buf || !size) {
+        return result;
+    }
+
+    async->buf = buf;
+    async->buf_size = size;
+    async->write_index = 0;
+    async->read_index = 0;
+    async->buf_is_full = false;
+    async->buf_is_empty = true;
+    async->notice = notice;
+
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
     pthread_attr_t thread_attr;
     struct sched_param thread_sched_param;
 
-    sem_init(&output_notice, 0, 0);
+    sem_init(&async->output_notice, 0, 0);
+    async->put_total = 0;
+    async->output_total = 0;
+    pthread_mutex_init(&async->output_total_lock, NULL);
+    pthread_cond_init(&async->output_done, NULL);
 
-    thread_running = true;
+    async->thread_running = true;
 
     pthread_attr_init(&thread_attr);
     //pthread_attr_setdetachstate(&thread_attr, PTHREAD_CREATE_DETACHED);
@@ -352,35 +651,42 @@ ElogErrCode elog_async_init(void) {
     pthread_attr_setschedpolicy(&thread_attr, SCHED_RR);
     thread_sched_param.sched_priority = ELOG_ASYNC_OUTPUT_PTHREAD_PRIORITY;
     pthread_attr_setschedparam(&thread_attr, &thread_sched_param);
-    pthread_create(&async_output_thread, &thread_attr, async_output, NULL);
+    pthread_create(&async->output_thread, &thread_attr, async_output, async);
     pthread_attr_destroy(&thread_attr);
+#else
+    ELOG_ASSERT(notice);
 #endif
 
-    init_ok = true;
+    async->init_ok = true;
 
     return result;
 }
 
 /**
- * asynchronous output mode deinitialize
+ * asynchronous output mode deinitialize, the remaining log will be output before return when using pthread
  *
+ * @param async asynchronous output object
  */
-void elog_async_deinit(void) {
-    if (!init_ok) {
+void elog_async_deinit(ElogAsync *async) {
+
+    if (!async->init_ok) {
         return ;
     }
 
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
-    thread_running = false;
+    async->thread_running = false;
 
-    elog_async_output_notice();
+    sem_post(&async->output_notice);
 
-    pthread_join(async_output_thread, NULL);
+    pthread_join(async->output_thread, NULL);
     
-    sem_destroy(&output_notice);
+    sem_destroy(&async->output_notice);
+    pthread_cond_destroy(&async->output_done);
+    pthread_mutex_destroy(&async->output_total_lock);
 #endif
 
-    init_ok = false;
+    async->is_enabled = false;
+    async->init_ok = false;
 }
 
 
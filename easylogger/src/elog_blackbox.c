@@ -0,0 +1,188 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Black box. The asynchronous output ring buffer and buffered output mode buffer are placed in
+ *           the memory which survives the process crash, the unflushed log can be extracted after crash.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+
+#ifdef ELOG_BLACKBOX_ENABLE
+
+/* the buffers are aligned to cache line in black box */
+#define BLACKBOX_ALIGN(size)                     (((size) + 63) & ~(size_t) 63)
+
+/* default object's black box, it's mapped by port only once */
+static ElogBlackbox *blackbox = NULL;
+static size_t blackbox_size = 0;
+
+/**
+ * check the black box header is valid in the image
+ *
+ * @param bb black box header
+ * @param size image size from the header
+ *
+ * @return true: valid
+ */
+static bool blackbox_is_valid(const ElogBlackbox *bb, size_t size) {
+    if (bb->magic != ELOG_BLACKBOX_MAGIC || bb->version != ELOG_BLACKBOX_VERSION) {
+        return false;
+    }
+    if (bb->async_size && (bb->async_offset < sizeof(ElogBlackbox) || bb->async_offset > size
+            || bb->async_size > size - bb->async_offset || bb->async_write >= bb->async_size)) {
+        return false;
+    }
+    if (bb->buf_size && (bb->buf_offset < sizeof(ElogBlackbox) || bb->buf_offset > size
+            || bb->buf_size > size - bb->buf_offset || bb->buf_used > bb->buf_size)) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Extract the unflushed log from black box image. The image can be the black box memory,
+ * the shared memory file which is left by crashed process, or the core dump file.
+ * The first valid black box header in image will be used.
+ *
+ * @param image black box image
+ * @param size image size
+ * @param output output interface for the unflushed log, it may be called more than once
+ *
+ * @return unflushed log size
+ */
+size_t elog_blackbox_extract(const void *image, size_t size, void (*output)(const char *log, size_t size)) {
+    const char *base = NULL;
+    ElogBlackbox bb;
+    size_t offset, unflushed, start, extracted = 0;
+
+    ELOG_ASSERT(image);
+    ELOG_ASSERT(output);
+
+    for (offset = 0; offset + sizeof(ElogBlackbox) <= size; offset += sizeof(uint32_t)) {
+        base = (const char *) image + offset;
+        /* the image may be unaligned */
+        memcpy(&bb, base, sizeof(ElogBlackbox));
+        if (blackbox_is_valid(&bb, size - offset)) {
+            break;
+        }
+    }
+    if (offset + sizeof(ElogBlackbox) > size) {
+        return 0;
+    }
+
+    /* buffered output mode buffer */
+    if (bb.buf_size && bb.buf_used) {
+        output(base + bb.buf_offset, bb.buf_used);
+        extracted += bb.buf_used;
+    }
+    /* the unflushed log is before the write index in ring buffer, it may be wrapped */
+    if (bb.async_size && bb.async_unflushed) {
+        unflushed = bb.async_unflushed < bb.async_size ? bb.async_unflushed : bb.async_size;
+        start = (bb.async_write + bb.async_size - unflushed) % bb.async_size;
+        /* the oldest log is overwritten, skip its remaining part */
+        if (bb.async_unflushed > bb.async_size) {
+            while (unflushed && base[bb.async_offset + start] != '\n') {
+                start = (start + 1) % bb.async_size;
+                unflushed--;
+            }
+            if (unflushed) {
+                start = (start + 1) % bb.async_size;
+                unflushed--;
+            }
+        }
+        if (start + unflushed > bb.async_size) {
+            output(base + bb.async_offset + start, bb.async_size - start);
+            output(base + bb.async_offset, unflushed - (bb.async_size - start));
+        } else if (unflushed) {
+            output(base + bb.async_offset + start, unflushed);
+        }
+        extracted += unflushed;
+    }
+
+    return extracted;
+}
+
+/**
+ * Get the default object's black box configuration, the asynchronous output ring buffer and
+ * buffered output mode buffer will be placed in the black box memory which is mapped by port.
+ * The log which is left by last crashed process will be output by the output interface at first.
+ * The sink's asynchronous output ring buffer isn't placed in black box, so the sink should be synchronous.
+ *
+ * @param cfg configuration, its buffers size must be configured before
+ */
+void elog_blackbox_default_cfg(ElogCfg *cfg) {
+    extern void *elog_port_blackbox_map(size_t size);
+
+    size_t async_size = 0, buf_size = 0;
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    async_size = cfg->async_buf_size;
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    buf_size = cfg->buf_size;
+#endif
+
+    if (!blackbox) {
+        blackbox_size = BLACKBOX_ALIGN(sizeof(ElogBlackbox)) + BLACKBOX_ALIGN(async_size) + buf_size;
+        blackbox = elog_port_blackbox_map(blackbox_size);
+        if (!blackbox) {
+            /* using the default buffers */
+            return;
+        }
+        /* the last process is crashed when there is unflushed log */
+        if (cfg->output && blackbox_is_valid(blackbox, blackbox_size)) {
+            elog_blackbox_extract(blackbox, blackbox_size, cfg->output);
+        }
+    }
+
+    /* the header is invalid until all fields are initialized */
+    blackbox->magic = 0;
+    blackbox->version = ELOG_BLACKBOX_VERSION;
+    blackbox->async_offset = BLACKBOX_ALIGN(sizeof(ElogBlackbox));
+    blackbox->async_size = async_size;
+    blackbox->async_write = 0;
+    blackbox->async_unflushed = 0;
+    blackbox->buf_offset = blackbox->async_offset + BLACKBOX_ALIGN(async_size);
+    blackbox->buf_size = buf_size;
+    blackbox->buf_used = 0;
+    blackbox->reserved = 0;
+    blackbox->magic = ELOG_BLACKBOX_MAGIC;
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    if (async_size) {
+        cfg->async_buf = (char *) blackbox + blackbox->async_offset;
+    }
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    if (buf_size) {
+        cfg->buf = (char *) blackbox + blackbox->buf_offset;
+    }
+#endif
+    cfg->blackbox = blackbox;
+}
+
+#endif /* ELOG_BLACKBOX_ENABLE */
@@ -34,63 +34,282 @@
     #error "Please configure buffer size for buffered output mode (in elog_cfg.h)"
 #endif
 
-/* buffered output mode's buffer */
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+#include <time.h>
+#if defined(ELOG_BLACKBOX_ENABLE)
+    #error "The black box only records one buffer, it can't be used with ELOG_BUF_OUTPUT_USING_PTHREAD"
+#endif
+#if ELOG_BUF_OUTPUT_BUF_NUM < 2
+    #error "ELOG_BUF_OUTPUT_BUF_NUM must be 2 at least"
+#endif
+/* the buffered log will be output by flusher after the interval (ms) since the first log is put, 0: disable */
+#ifndef ELOG_BUF_OUTPUT_FLUSH_INTERVAL
+#define ELOG_BUF_OUTPUT_FLUSH_INTERVAL           1000
+#endif
+#endif /* ELOG_BUF_OUTPUT_USING_PTHREAD */
+
+/* default object's buffered output mode buffer */
 static char log_buf[ELOG_BUF_OUTPUT_BUF_SIZE] = { 0 };
-/* log buffer current write size */
-static size_t buf_write_size = 0;
-/* buffered output mode enabled flag */
-static bool is_enabled = false;
 
-extern void elog_port_output(const char *log, size_t size);
-extern void elog_output_lock(void);
-extern void elog_output_unlock(void);
+extern void elog_inst_output_lock(EasyLogger_t elog);
+extern void elog_inst_output_unlock(EasyLogger_t elog);
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+extern uint32_t elog_port_get_tick(void);
+#endif
+
+/**
+ * record the buffer write size to black box, so the buffered log can be extracted after crash
+ *
+ * @param buf buffered output object
+ */
+static void buf_blackbox_sync(ElogBuf *buf) {
+#ifdef ELOG_BLACKBOX_ENABLE
+    if (buf->blackbox) {
+        buf->blackbox->buf_used = buf->write_size;
+    }
+#else
+    (void) buf;
+#endif
+}
+
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+/**
+ * Hand over the filling buffer to flusher, then switch to the next buffer.
+ * It will wait when all other buffers are waiting for flusher. The buffer lock must be held.
+ *
+ * @param buf buffered output object
+ */
+static void buf_swap(ElogBuf *buf) {
+    while (buf->full_num + buf->flushing_num == ELOG_BUF_OUTPUT_BUF_NUM - 1) {
+        pthread_cond_wait(&buf->done, &buf->lock);
+    }
+    buf->full_size[buf->fill_index] = buf->write_size;
+    buf->full_num++;
+    buf->fill_index = (buf->fill_index + 1) % ELOG_BUF_OUTPUT_BUF_NUM;
+    buf->buf = buf->bufs[buf->fill_index];
+    buf->write_size = 0;
+    pthread_cond_signal(&buf->notice);
+}
+
+/**
+ * put the log to filling buffer, the full buffer is output by flusher
+ *
+ * @param buf buffered output object
+ * @param log log
+ * @param size log size
+ */
+static void buf_put(ElogBuf *buf, const char *log, size_t size) {
+    size_t write_size;
+
+    pthread_mutex_lock(&buf->lock);
+    while (size) {
+        if (buf->write_size == 0) {
+            buf->fill_tick = elog_port_get_tick();
+#if ELOG_BUF_OUTPUT_FLUSH_INTERVAL > 0
+            /* the idle flusher starts timing for auto flush */
+            if (buf->flusher_idle) {
+                pthread_cond_signal(&buf->notice);
+            }
+#endif
+        }
+        write_size = buf->buf_size - buf->write_size < size ? buf->buf_size - buf->write_size : size;
+        memcpy(buf->buf + buf->write_size, log, write_size);
+        buf->write_size += write_size;
+        log += write_size;
+        size -= write_size;
+        if (buf->write_size == buf->buf_size) {
+            buf_swap(buf);
+        }
+    }
+    pthread_mutex_unlock(&buf->lock);
+}
+
+/**
+ * get the absolute timeout on monotonic clock
+ */
+static void get_deadline(struct timespec *ts, uint32_t timeout_ms) {
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout_ms / 1000;
+    ts->tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * Flusher thread. The full buffer is output without buffer lock and output lock, so the logging
+ * threads keep filling the other buffer. The filling buffer is handed over when it's timeout.
+ */
+static void *buf_flush_thread(void *arg) {
+    ElogBuf *buf = arg;
+    uint8_t index;
+#if ELOG_BUF_OUTPUT_FLUSH_INTERVAL > 0
+    struct timespec deadline;
+    uint32_t elapsed;
+#endif
+
+    pthread_mutex_lock(&buf->lock);
+    while (true) {
+        if (buf->full_num) {
+            /* the oldest full buffer */
+            index = (buf->fill_index + ELOG_BUF_OUTPUT_BUF_NUM - buf->full_num) % ELOG_BUF_OUTPUT_BUF_NUM;
+            /* the buffer is taken before it's output, so the emergency drain won't output it again */
+            buf->flushing_num = 1;
+            __atomic_sub_fetch(&buf->full_num, 1, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock(&buf->lock);
+            buf->elog->output(buf->bufs[index], buf->full_size[index]);
+            pthread_mutex_lock(&buf->lock);
+            buf->flushing_num = 0;
+            pthread_cond_broadcast(&buf->done);
+            continue;
+        }
+        if (!buf->thread_running) {
+            break;
+        }
+#if ELOG_BUF_OUTPUT_FLUSH_INTERVAL > 0
+        if (buf->write_size) {
+            elapsed = elog_port_get_tick() - buf->fill_tick;
+            if (elapsed >= ELOG_BUF_OUTPUT_FLUSH_INTERVAL) {
+                buf_swap(buf);
+            } else {
+                get_deadline(&deadline, ELOG_BUF_OUTPUT_FLUSH_INTERVAL - elapsed);
+                pthread_cond_timedwait(&buf->notice, &buf->lock, &deadline);
+            }
+            continue;
+        }
+#endif
+        buf->flusher_idle = true;
+        pthread_cond_wait(&buf->notice, &buf->lock);
+        buf->flusher_idle = false;
+    }
+    pthread_mutex_unlock(&buf->lock);
+
+    return NULL;
+}
+
+/**
+ * hand over the filling buffer to flusher, then wait all buffers are output
+ *
+ * @param buf buffered output object
+ */
+static void buf_drain(ElogBuf *buf) {
+    pthread_mutex_lock(&buf->lock);
+    if (buf->write_size) {
+        buf_swap(buf);
+    }
+    while (buf->full_num || buf->flushing_num) {
+        pthread_cond_wait(&buf->done, &buf->lock);
+    }
+    pthread_mutex_unlock(&buf->lock);
+}
+#endif /* ELOG_BUF_OUTPUT_USING_PTHREAD */
 
 /**
- * output buffered logs when buffer is full
+ * Put the log to buffer. The full buffer is output by logging thread,
+ * or it's handed over to flusher thread when using pthread.
  *
+ * @param elog EasyLogger object
  * @param log will be buffered line's log
  * @param size log size
  */
-void elog_buf_output(const char *log, size_t size) {
+void elog_buf_output(EasyLogger_t elog, const char *log, size_t size) {
+    ElogBuf *buf = &elog->buf;
     size_t write_size = 0, write_index = 0;
 
-    if (!is_enabled) {
-        elog_port_output(log, size);
+    if (!buf->is_enabled) {
+        elog->output(log, size);
         return;
     }
 
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    if (buf->thread_running) {
+        buf_put(buf, log, size);
+        return;
+    }
+#endif
+
     while (true) {
-        if (buf_write_size + size > ELOG_BUF_OUTPUT_BUF_SIZE) {
-            write_size = ELOG_BUF_OUTPUT_BUF_SIZE - buf_write_size;
-            memcpy(log_buf + buf_write_size, log + write_index, write_size);
+        if (buf->write_size + size > buf->buf_size) {
+            write_size = buf->buf_size - buf->write_size;
+            memcpy(buf->buf + buf->write_size, log + write_index, write_size);
             write_index += write_size;
             size -= write_size;
             /* output log */
-            elog_port_output(log_buf, ELOG_BUF_OUTPUT_BUF_SIZE);
+            elog->output(buf->buf, buf->buf_size);
             /* reset write index */
-            buf_write_size = 0;
+            buf->write_size = 0;
+            buf_blackbox_sync(buf);
         } else {
-            memcpy(log_buf + buf_write_size, log + write_index, size);
-            buf_write_size += size;
+            memcpy(buf->buf + buf->write_size, log + write_index, size);
+            buf->write_size += size;
             break;
         }
     }
+    buf_blackbox_sync(buf);
 }
 
+#ifdef ELOG_EMERGENCY_ENABLE
+/**
+ * Drain all buffered logs to the output, it's used by emergency flush.
+ * The caller must hold the output lock.
+ *
+ * @param elog EasyLogger object
+ * @param output async-signal-safe output interface
+ */
+void elog_buf_emergency_drain(EasyLogger_t elog, void (*output)(const char *log, size_t size)) {
+    ElogBuf *buf = &elog->buf;
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    uint8_t i, index;
+
+    /* The buffer lock can't be used in signal handler, the full buffers are older than the filling buffer.
+     * The buffer which is taken by flusher isn't counted, it's being output. */
+    for (i = __atomic_load_n(&buf->full_num, __ATOMIC_SEQ_CST); i > 0; i--) {
+        index = (buf->fill_index + ELOG_BUF_OUTPUT_BUF_NUM - i) % ELOG_BUF_OUTPUT_BUF_NUM;
+        output(buf->bufs[index], buf->full_size[index]);
+    }
+#endif
+
+    if (buf->write_size == 0) {
+        return;
+    }
+    output(buf->buf, buf->write_size);
+    buf->write_size = 0;
+    buf_blackbox_sync(buf);
+}
+#endif /* ELOG_EMERGENCY_ENABLE */
+
 /**
  * flush all buffered logs to output device
  */
 void elog_flush(void) {
-    if (buf_write_size == 0)
+    elog_inst_flush(elog_get_default());
+}
+
+void elog_inst_flush(EasyLogger_t elog) {
+    ElogBuf *buf = &elog->buf;
+
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    if (buf->thread_running) {
+        /* the output lock keeps the logging threads out until all buffers are output */
+        elog_inst_output_lock(elog);
+        buf_drain(buf);
+        elog_inst_output_unlock(elog);
+        return;
+    }
+#endif
+
+    if (buf->write_size == 0)
         return;
     /* lock output */
-    elog_output_lock();
+    elog_inst_output_lock(elog);
     /* output log */
-    elog_port_output(log_buf, buf_write_size);
+    elog->output(buf->buf, buf->write_size);
     /* reset write index */
-    buf_write_size = 0;
+    buf->write_size = 0;
+    buf_blackbox_sync(buf);
     /* unlock output */
-    elog_output_unlock();
+    elog_inst_output_unlock(elog);
 }
 
 /**
@@ -100,6 +319,139 @@ void elog_flush(void) {
  * @param enabled true: enabled, false: disabled
  */
 void elog_buf_enabled(bool enabled) {
-    is_enabled = enabled;
+    elog_inst_buf_enabled(elog_get_default(), enabled);
+}
+
+void elog_inst_buf_enabled(EasyLogger_t elog, bool enabled) {
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    if (elog->buf.thread_running) {
+        /* the buffered log must be output before the log which is output directly */
+        elog_inst_output_lock(elog);
+        if (!enabled) {
+            buf_drain(&elog->buf);
+        }
+        elog->buf.is_enabled = enabled;
+        elog_inst_output_unlock(elog);
+        return;
+    }
+#endif
+    /* the object which has no buffer is always output directly */
+    elog->buf.is_enabled = enabled && elog->buf.buf;
+}
+
+/**
+ * get the buffer used size, the output lock must be held
+ *
+ * @param elog EasyLogger object
+ *
+ * @return used size of the filling buffer
+ */
+size_t elog_buf_get_used(EasyLogger_t elog) {
+    size_t used;
+
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    /* the filling buffer may be handed over by flusher */
+    if (elog->buf.thread_running) {
+        pthread_mutex_lock(&elog->buf.lock);
+        used = elog->buf.write_size;
+        pthread_mutex_unlock(&elog->buf.lock);
+        return used;
+    }
+#endif
+    used = elog->buf.write_size;
+
+    return used;
+}
+
+/**
+ * get the default object's buffered output configuration
+ *
+ * @param cfg configuration
+ */
+void elog_buf_default_cfg(ElogCfg *cfg) {
+    cfg->buf = log_buf;
+    cfg->buf_size = ELOG_BUF_OUTPUT_BUF_SIZE;
+}
+
+/**
+ * buffered output mode initialize
+ *
+ * @param elog EasyLogger object
+ * @param buf buffer, NULL: the object will output directly
+ * @param size buffer size
+ */
+void elog_buf_init(EasyLogger_t elog, char *buf, size_t size) {
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    pthread_condattr_t attr;
+    uint8_t i;
+#endif
+
+    elog->buf.is_enabled = false;
+    elog->buf.buf = size ? buf : NULL;
+    elog->buf.buf_size = size;
+    elog->buf.write_size = 0;
+
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    elog->buf.thread_running = false;
+    if (size < ELOG_BUF_OUTPUT_BUF_NUM * ELOG_LINE_BUF_SIZE) {
+        /* the buffer is too small to be split, the full buffer is output by logging thread */
+        return;
+    }
+    elog->buf.elog = elog;
+    elog->buf.buf_size = size / ELOG_BUF_OUTPUT_BUF_NUM;
+    for (i = 0; i < ELOG_BUF_OUTPUT_BUF_NUM; i++) {
+        elog->buf.bufs[i] = buf + i * elog->buf.buf_size;
+    }
+    elog->buf.fill_index = 0;
+    elog->buf.full_num = 0;
+    elog->buf.flushing_num = 0;
+    elog->buf.flusher_idle = false;
+
+    pthread_mutex_init(&elog->buf.lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&elog->buf.notice, &attr);
+    pthread_cond_init(&elog->buf.done, &attr);
+    pthread_condattr_destroy(&attr);
+
+    elog->buf.thread_running = true;
+    if (pthread_create(&elog->buf.flush_thread, NULL, buf_flush_thread, &elog->buf) != 0) {
+        elog->buf.thread_running = false;
+        elog->buf.buf_size = size;
+        pthread_cond_destroy(&elog->buf.notice);
+        pthread_cond_destroy(&elog->buf.done);
+        pthread_mutex_destroy(&elog->buf.lock);
+    }
+#endif /* ELOG_BUF_OUTPUT_USING_PTHREAD */
+}
+
+/**
+ * buffered output mode deinitialize, the remaining log will be output before return when using pthread
+ *
+ * @param elog EasyLogger object
+ */
+void elog_buf_deinit(EasyLogger_t elog) {
+#ifdef ELOG_BUF_OUTPUT_USING_PTHREAD
+    ElogBuf *buf = &elog->buf;
+
+    if (!buf->thread_running) {
+        return;
+    }
+    pthread_mutex_lock(&buf->lock);
+    if (buf->write_size) {
+        buf_swap(buf);
+    }
+    buf->thread_running = false;
+    pthread_cond_signal(&buf->notice);
+    pthread_mutex_unlock(&buf->lock);
+    /* the flusher outputs all full buffers before exit */
+    pthread_join(buf->flush_thread, NULL);
+
+    pthread_cond_destroy(&buf->notice);
+    pthread_cond_destroy(&buf->done);
+    pthread_mutex_destroy(&buf->lock);
+#else
+    (void) elog;
+#endif
 }
 #endif /* ELOG_BUF_OUTPUT_ENABLE */
@@ -0,0 +1,537 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Hot reloadable configuration file for Linux. The file is watched by inotify, and the
+ *           changed configuration is applied without restart.
+ * Created on: 2026-10-19
+ *
+ * The configuration file is made of `key = value` lines, the line which starts with '#' is comment.
+ *
+ *     # filter level, tag and keyword, the level can be A/E/W/I/D/V, full name or number
+ *     level = D
+ *     tag =
+ *     keyword =
+ *     # tag level filter, the tag can contain '.'
+ *     tag_level.can.disp = W
+ *     # format for the level, the format can be lvl|tag|time|p_info|t_info|dir|func|line, all or none
+ *     fmt.I = lvl|tag|time
+ *     # sink level and format, the sink is found by name, the output interface's sink name is "output"
+ *     sink.file.level = I
+ *     sink.file.fmt.W = all
+ *     # rate limit for the level and tag (empty: all tags), rate[/burst] [callsite], rate 0: remove
+ *     rate_limit.W.net = 10/20 callsite
+ *     # sampling for the level, n [random]
+ *     sampling.V = 100 random
+ *
+ * The filter is replaced by the file as a whole, so the removed tag level will be restored.
+ * The other settings are only changed when they are in the file.
+ */
+
+#include <elog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#ifdef ELOG_CONFIG_RELOAD_ENABLE
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/inotify.h>
+
+/* max length of every line in configuration file */
+#define LINE_MAX_LEN                             256
+/* max number of the sinks which are configured in the file */
+#define SINK_MAX_NUM                             8
+/* max number of the rate limits which are configured in the file */
+#define RATE_LIMIT_MAX_NUM                       8
+
+/* sink setting in configuration file */
+typedef struct {
+    char name[32];
+    bool level_set;
+    uint8_t level;
+    size_t fmt[ELOG_LVL_TOTAL_NUM];
+    uint8_t fmt_flag;                            /**< bit n: the level n format is set */
+} ConfigSink;
+
+/* rate limit setting in configuration file */
+typedef struct {
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
+    uint8_t level;
+    uint32_t rate;
+    uint32_t burst;
+    bool per_callsite;
+} ConfigRateLimit;
+
+/* all settings in configuration file, they are parsed before applied */
+typedef struct {
+    ElogFilter filter;
+    size_t fmt[ELOG_LVL_TOTAL_NUM];
+    uint8_t fmt_flag;                            /**< bit n: the level n format is set */
+    ConfigSink sink[SINK_MAX_NUM];
+    size_t sink_num;
+    ConfigRateLimit rate_limit[RATE_LIMIT_MAX_NUM];
+    size_t rate_limit_num;
+    uint32_t sample_n[ELOG_LVL_TOTAL_NUM];
+    bool sample_random[ELOG_LVL_TOTAL_NUM];
+    uint8_t sample_flag;                         /**< bit n: the level n sampling is set */
+} Config;
+
+/* configuration file watcher */
+typedef struct {
+    bool running;
+    EasyLogger_t elog;
+    char path[PATH_MAX];
+    int inotify_fd;
+    int wake_fd[2];
+    pthread_t thread;
+} ConfigWatcher;
+
+static ConfigWatcher watcher = { .inotify_fd = -1, .wake_fd = { -1, -1 } };
+
+extern void elog_inst_output_lock(EasyLogger_t elog);
+extern void elog_inst_output_unlock(EasyLogger_t elog);
+extern void elog_inst_filter_publish(EasyLogger_t elog, const ElogFilter *filter);
+
+/**
+ * remove the leading and trailing white space
+ */
+static char *strip(char *str) {
+    char *end;
+
+    while (isspace((unsigned char) *str)) {
+        str++;
+    }
+    end = str + strlen(str);
+    while (end > str && isspace((unsigned char) end[-1])) {
+        *--end = '\0';
+    }
+
+    return str;
+}
+
+/**
+ * parse the format set, such as "lvl|tag|time"
+ *
+ * @return true: parse success
+ */
+static bool parse_fmt(char *str, size_t *fmt) {
+    static const struct {
+        const char *name;
+        size_t fmt;
+    } table[] = {
+        { "lvl", ELOG_FMT_LVL }, { "tag", ELOG_FMT_TAG }, { "time", ELOG_FMT_TIME },
+        { "p_info", ELOG_FMT_P_INFO }, { "t_info", ELOG_FMT_T_INFO }, { "dir", ELOG_FMT_DIR },
+        { "func", ELOG_FMT_FUNC }, { "line", ELOG_FMT_LINE }, { "all", ELOG_FMT_ALL }, { "none", 0 },
+    };
+    char *item, *save = NULL;
+    size_t i;
+
+    *fmt = 0;
+    for (item = strtok_r(str, "|", &save); item; item = strtok_r(NULL, "|", &save)) {
+        item = strip(item);
+        for (i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+            if (!strcmp(item, table[i].name)) {
+                *fmt |= table[i].fmt;
+                break;
+            }
+        }
+        if (i == sizeof(table) / sizeof(table[0])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * parse one `key = value` line to configuration
+ *
+ * @return error message, NULL: parse success
+ */
+static const char *parse_line(Config *cfg, char *key, char *value) {
+    char *p, *end;
+    int level;
+    size_t i, fmt;
+
+    if (!strcmp(key, "level")) {
+        if ((level = elog_lvl_from_str(value)) < 0) {
+            return "invalid level";
+        }
+        cfg->filter.level = (uint8_t) level;
+    } else if (!strcmp(key, "tag")) {
+        strncpy(cfg->filter.tag, value, ELOG_FILTER_TAG_MAX_LEN);
+    } else if (!strcmp(key, "keyword")) {
+        strncpy(cfg->filter.keyword, value, ELOG_FILTER_KW_MAX_LEN);
+    } else if (!strncmp(key, "tag_level.", 10)) {
+        if ((level = elog_lvl_from_str(value)) < 0) {
+            return "invalid level";
+        }
+        for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM && cfg->filter.tag_lvl[i].tag_use_flag; i++);
+        if (i == ELOG_FILTER_TAG_LVL_MAX_NUM) {
+            return "too many tag levels";
+        }
+        strncpy(cfg->filter.tag_lvl[i].tag, key + 10, ELOG_FILTER_TAG_MAX_LEN);
+        cfg->filter.tag_lvl[i].level = (uint8_t) level;
+        cfg->filter.tag_lvl[i].tag_use_flag = true;
+    } else if (!strncmp(key, "fmt.", 4)) {
+        if ((level = elog_lvl_from_str(key + 4)) < 0) {
+            return "invalid level";
+        }
+        if (!parse_fmt(value, &fmt)) {
+            return "invalid format";
+        }
+        cfg->fmt[level] = fmt;
+        cfg->fmt_flag |= 1 << level;
+    } else if (!strncmp(key, "sink.", 5)) {
+        ConfigSink *sink;
+
+        key += 5;
+        /* the sink name can contain '.', the setting is at the end of key */
+        if ((p = strrchr(key, '.')) == NULL || p == key) {
+            return "invalid sink setting";
+        }
+        if (strcmp(p, ".level") && (p - key < 5 || strncmp(p - 4, ".fmt", 4))) {
+            return "invalid sink setting";
+        }
+        end = strcmp(p, ".level") ? p - 4 : p;
+        if ((size_t) (end - key) >= sizeof(sink->name)) {
+            return "too long sink name";
+        }
+        for (i = 0; i < cfg->sink_num; i++) {
+            if (!strncmp(cfg->sink[i].name, key, end - key) && cfg->sink[i].name[end - key] == '\0') {
+                break;
+            }
+        }
+        if (i == cfg->sink_num) {
+            if (cfg->sink_num == SINK_MAX_NUM) {
+                return "too many sinks";
+            }
+            memcpy(cfg->sink[i].name, key, end - key);
+            cfg->sink_num++;
+        }
+        sink = &cfg->sink[i];
+        if (end == p) {
+            if ((level = elog_lvl_from_str(value)) < 0) {
+                return "invalid level";
+            }
+            sink->level = (uint8_t) level;
+            sink->level_set = true;
+        } else {
+            if ((level = elog_lvl_from_str(p + 1)) < 0) {
+                return "invalid level";
+            }
+            if (!parse_fmt(value, &fmt)) {
+                return "invalid format";
+            }
+            sink->fmt[level] = fmt;
+            sink->fmt_flag |= 1 << level;
+        }
+    } else if (!strncmp(key, "rate_limit.", 11)) {
+#ifdef ELOG_RATE_LIMIT_ENABLE
+        ConfigRateLimit *limit;
+        char level_name[8] = { 0 };
+        size_t len;
+
+        if (cfg->rate_limit_num == RATE_LIMIT_MAX_NUM) {
+            return "too many rate limits";
+        }
+        limit = &cfg->rate_limit[cfg->rate_limit_num];
+        key += 11;
+        /* the level is followed by optional tag */
+        p = strchr(key, '.');
+        len = p ? (size_t) (p - key) : strlen(key);
+        if (len >= sizeof(level_name)) {
+            return "invalid level";
+        }
+        memcpy(level_name, key, len);
+        if ((level = elog_lvl_from_str(level_name)) < 0) {
+            return "invalid level";
+        }
+        limit->level = (uint8_t) level;
+        if (p) {
+            strncpy(limit->tag, p + 1, ELOG_FILTER_TAG_MAX_LEN);
+        }
+        limit->rate = strtoul(value, &end, 10);
+        limit->burst = *end == '/' ? strtoul(end + 1, &end, 10) : 0;
+        end = strip(end);
+        if (*end && strcmp(end, "callsite")) {
+            return "invalid rate limit";
+        }
+        limit->per_callsite = *end != '\0';
+        cfg->rate_limit_num++;
+#else
+        return "rate limit is disabled";
+#endif
+    } else if (!strncmp(key, "sampling.", 9)) {
+#ifdef ELOG_RATE_LIMIT_ENABLE
+        if ((level = elog_lvl_from_str(key + 9)) < 0) {
+            return "invalid level";
+        }
+        cfg->sample_n[level] = strtoul(value, &end, 10);
+        end = strip(end);
+        if (*end && strcmp(end, "random")) {
+            return "invalid sampling";
+        }
+        cfg->sample_random[level] = *end != '\0';
+        cfg->sample_flag |= 1 << level;
+#else
+        return "sampling is disabled";
+#endif
+    } else {
+        return "unknown key";
+    }
+
+    return NULL;
+}
+
+/**
+ * apply the parsed configuration, the filter is published as one snapshot
+ */
+static void config_apply(EasyLogger_t elog, const Config *cfg) {
+    ElogSink_t sink;
+    size_t i;
+    uint8_t level;
+
+    elog_inst_filter_publish(elog, &cfg->filter);
+    elog_inst_output_lock(elog);
+    for (level = 0; level < ELOG_LVL_TOTAL_NUM; level++) {
+        if (cfg->fmt_flag & (1 << level)) {
+            elog->enabled_fmt_set[level] = cfg->fmt[level];
+        }
+    }
+    for (i = 0; i < cfg->sink_num; i++) {
+        for (sink = elog->sinks; sink && strcmp(sink->name, cfg->sink[i].name); sink = sink->next);
+        if (sink == NULL) {
+            continue;
+        }
+        if (cfg->sink[i].level_set) {
+            sink->level = cfg->sink[i].level;
+        }
+        for (level = 0; level < ELOG_LVL_TOTAL_NUM; level++) {
+            if (cfg->sink[i].fmt_flag & (1 << level)) {
+                sink->fmt_set[level] = cfg->sink[i].fmt[level];
+                sink->fmt_set_flag |= 1 << level;
+            }
+        }
+    }
+    elog_inst_output_unlock(elog);
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    for (i = 0; i < cfg->rate_limit_num; i++) {
+        elog_inst_set_rate_limit(elog, cfg->rate_limit[i].tag, cfg->rate_limit[i].level, cfg->rate_limit[i].rate,
+                cfg->rate_limit[i].burst, cfg->rate_limit[i].per_callsite);
+    }
+    for (level = 0; level < ELOG_LVL_TOTAL_NUM; level++) {
+        if (cfg->sample_flag & (1 << level)) {
+            elog_inst_set_sampling(elog, level, cfg->sample_n[level], cfg->sample_random[level]);
+        }
+    }
+#endif
+}
+
+/**
+ * load the configuration file to default object
+ *
+ * @param path configuration file path
+ *
+ * @return true: load success, false: the file can't be read or it has error, nothing is changed
+ */
+bool elog_config_load(const char *path) {
+    return elog_inst_config_load(elog_get_default(), path);
+}
+
+bool elog_inst_config_load(EasyLogger_t elog, const char *path) {
+    Config *cfg;
+    FILE *fp;
+    char line[LINE_MAX_LEN], *key, *value;
+    const char *err = NULL;
+    size_t line_num = 0, i;
+
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(path);
+
+    if ((fp = fopen(path, "r")) == NULL) {
+        elog_inst_output(elog, ELOG_LVL_WARN, "elog", NULL, NULL, 0, "config %s can't be opened", path);
+        return false;
+    }
+    if ((cfg = calloc(1, sizeof(Config))) == NULL) {
+        fclose(fp);
+        return false;
+    }
+    /* the removed settings in filter are restored to default */
+    cfg->filter.level = ELOG_LVL_VERBOSE;
+    for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        cfg->filter.tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
+    }
+
+    while (err == NULL && fgets(line, sizeof(line), fp)) {
+        line_num++;
+        key = strip(line);
+        if (*key == '\0' || *key == '#') {
+            continue;
+        }
+        if ((value = strchr(key, '=')) == NULL) {
+            err = "missing '='";
+            break;
+        }
+        *value++ = '\0';
+        err = parse_line(cfg, strip(key), strip(value));
+    }
+    fclose(fp);
+
+    if (err) {
+        elog_inst_output(elog, ELOG_LVL_WARN, "elog", NULL, NULL, 0, "config %s:%lu %s, it's not applied", path,
+                (unsigned long) line_num, err);
+    } else {
+        config_apply(elog, cfg);
+        elog_inst_output(elog, ELOG_LVL_INFO, "elog", NULL, NULL, 0, "config %s is applied", path);
+    }
+    free(cfg);
+
+    return err == NULL;
+}
+
+static void *config_watch_thread(void *arg) {
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event *event;
+    struct pollfd fds[2];
+    const char *name = strrchr(watcher.path, '/');
+    ssize_t len;
+    bool changed;
+
+    (void) arg;
+    name = name ? name + 1 : watcher.path;
+    fds[0].fd = watcher.inotify_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = watcher.wake_fd[0];
+    fds[1].events = POLLIN;
+
+    while (poll(fds, 2, -1) >= 0 || errno == EINTR) {
+        if (fds[1].revents) {
+            break;
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+        changed = false;
+        while ((len = read(watcher.inotify_fd, buf, sizeof(buf))) > 0) {
+            for (event = (const struct inotify_event *) buf; (const char *) event < buf + len;
+                    event = (const struct inotify_event *) ((const char *) event + sizeof(*event) + event->len)) {
+                if (event->len && !strcmp(event->name, name)) {
+                    changed = true;
+                }
+            }
+        }
+        if (changed) {
+            elog_inst_config_load(watcher.elog, watcher.path);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Load the configuration file to default object, then watch it by inotify.
+ * The changed file will be loaded again, only one file can be watched.
+ *
+ * @param path configuration file path
+ *
+ * @return true: watch success
+ */
+bool elog_config_watch(const char *path) {
+    return elog_inst_config_watch(elog_get_default(), path);
+}
+
+bool elog_inst_config_watch(EasyLogger_t elog, const char *path) {
+    char dir[PATH_MAX];
+    const char *name;
+
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(path);
+
+    if (watcher.running || strlen(path) >= sizeof(watcher.path)) {
+        return false;
+    }
+    strcpy(watcher.path, path);
+    watcher.elog = elog;
+    /* watch the directory, the file may be replaced by rename when it's saved by editor */
+    name = strrchr(path, '/');
+    if (name == NULL) {
+        strcpy(dir, ".");
+    } else if (name == path) {
+        strcpy(dir, "/");
+    } else {
+        memcpy(dir, path, name - path);
+        dir[name - path] = '\0';
+    }
+    watcher.inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher.inotify_fd < 0) {
+        return false;
+    }
+    if (inotify_add_watch(watcher.inotify_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0
+            || pipe(watcher.wake_fd) < 0) {
+        close(watcher.inotify_fd);
+        watcher.inotify_fd = -1;
+        return false;
+    }
+    fcntl(watcher.wake_fd[0], F_SETFD, FD_CLOEXEC);
+    fcntl(watcher.wake_fd[1], F_SETFD, FD_CLOEXEC);
+    elog_inst_config_load(elog, path);
+    if (pthread_create(&watcher.thread, NULL, config_watch_thread, NULL) != 0) {
+        close(watcher.inotify_fd);
+        close(watcher.wake_fd[0]);
+        close(watcher.wake_fd[1]);
+        watcher.inotify_fd = watcher.wake_fd[0] = watcher.wake_fd[1] = -1;
+        return false;
+    }
+    watcher.running = true;
+
+    return true;
+}
+
+/**
+ * stop watching the configuration file
+ */
+void elog_config_unwatch(void) {
+    if (!watcher.running) {
+        return;
+    }
+    if (write(watcher.wake_fd[1], "", 1) < 0) {
+        /* the thread won't exit without wake up */
+        return;
+    }
+    pthread_join(watcher.thread, NULL);
+    close(watcher.inotify_fd);
+    close(watcher.wake_fd[0]);
+    close(watcher.wake_fd[1]);
+    watcher.inotify_fd = watcher.wake_fd[0] = watcher.wake_fd[1] = -1;
+    watcher.running = false;
+}
+
+#endif /* ELOG_CONFIG_RELOAD_ENABLE */
@@ -0,0 +1,641 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Local control server on Unix domain socket for POSIX. The statistics and filter can be
+ *           queried, and the filter can be changed at runtime by `elog_ctl` tool.
+ * Created on: 2026-10-19
+ *
+ * Every connection carries one command line, such as "tag_level net W\n". The server replies the
+ * command output, then the status line "ok" or "error" is replied and the connection is closed.
+ * The server is running on its own thread, the filter is read from the published snapshot and
+ * changed by the filter API, so the logging threads are never blocked by the slow client.
+ */
+
+/* struct ucred for SO_PEERCRED */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <elog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#ifdef ELOG_CTL_ENABLE
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL                             0
+#endif
+
+/* max length of the command line */
+#define CMD_LINE_MAX_LEN                         256
+/* the client is dropped when it's not sending or receiving in the timeout (ms) */
+#define CLIENT_IO_TIMEOUT                        1000
+
+/* control command */
+typedef struct {
+    const char *name;
+    const char *help;
+    ElogCtlHandler handler;
+} CtlCmd;
+
+/* control server */
+typedef struct {
+    bool running;
+    EasyLogger_t elog;
+    char path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+    int listen_fd;
+    int wake_fd[2];
+    int client_fd;                               /**< current client, the reply is written to it */
+    char last_char;                              /**< the last replied char */
+    pthread_t thread;
+} CtlServer;
+
+static bool cmd_help(EasyLogger_t elog, char *arg);
+static bool cmd_stats(EasyLogger_t elog, char *arg);
+static bool cmd_filter(EasyLogger_t elog, char *arg);
+static bool cmd_level(EasyLogger_t elog, char *arg);
+static bool cmd_tag(EasyLogger_t elog, char *arg);
+static bool cmd_keyword(EasyLogger_t elog, char *arg);
+static bool cmd_tag_level(EasyLogger_t elog, char *arg);
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+static bool cmd_flush(EasyLogger_t elog, char *arg);
+#endif
+#ifdef ELOG_CONFIG_RELOAD_ENABLE
+static bool cmd_reload(EasyLogger_t elog, char *arg);
+#endif
+#ifdef ELOG_BLACKBOX_ENABLE
+static bool cmd_blackbox(EasyLogger_t elog, char *arg);
+#endif
+
+static const CtlCmd builtin_cmd[] = {
+    { "help", "show all commands", cmd_help },
+    { "stats", "show the log statistics", cmd_stats },
+    { "filter", "show the filter", cmd_filter },
+    { "level", "<lvl>: set the filter level", cmd_level },
+    { "tag", "[tag]: set the filter tag, empty: all tags", cmd_tag },
+    { "keyword", "[keyword]: set the filter keyword, empty: all logs", cmd_keyword },
+    { "tag_level", "<tag> <lvl>: set the tag level, V: remove the tag level", cmd_tag_level },
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    { "flush", "flush the buffered output mode buffer", cmd_flush },
+#endif
+#ifdef ELOG_CONFIG_RELOAD_ENABLE
+    { "reload", "<path>: load the configuration file", cmd_reload },
+#endif
+#ifdef ELOG_BLACKBOX_ENABLE
+    { "blackbox", "dump the unflushed log in black box", cmd_blackbox },
+#endif
+};
+
+/* the commands which are registered by plugins and user */
+static CtlCmd user_cmd[ELOG_CTL_CMD_MAX_NUM];
+static size_t user_cmd_num = 0;
+static pthread_mutex_t user_cmd_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static CtlServer server = { .listen_fd = -1, .wake_fd = { -1, -1 }, .client_fd = -1 };
+
+static const char *level_name = "AEWIDV";
+
+/**
+ * Register the control command, the registered command will replace the same name command.
+ * The handler is called on the control server thread, its output is replied by elog_ctl_reply,
+ * the status line is "ok" when it returns true.
+ *
+ * @param name command name, it must be kept until the program exits
+ * @param help command help, it must be kept until the program exits
+ * @param handler command handler, the argument is the remaining command line
+ *
+ * @return true: register success
+ */
+bool elog_ctl_cmd_register(const char *name, const char *help, ElogCtlHandler handler) {
+    size_t i;
+    bool result = true;
+
+    ELOG_ASSERT(name);
+    ELOG_ASSERT(handler);
+
+    pthread_mutex_lock(&user_cmd_lock);
+    for (i = 0; i < user_cmd_num && strcmp(user_cmd[i].name, name); i++);
+    if (i == user_cmd_num) {
+        if (user_cmd_num == ELOG_CTL_CMD_MAX_NUM) {
+            result = false;
+            goto __exit;
+        }
+        user_cmd_num++;
+    }
+    user_cmd[i].name = name;
+    user_cmd[i].help = help ? help : "";
+    user_cmd[i].handler = handler;
+
+__exit:
+    pthread_mutex_unlock(&user_cmd_lock);
+
+    return result;
+}
+
+/**
+ * Reply the raw data to current client, it's only used in command handler.
+ * The client is dropped when it's not receiving in timeout.
+ *
+ * @param data data
+ * @param size data size
+ */
+void elog_ctl_reply_raw(const char *data, size_t size) {
+    ssize_t len;
+
+    if (server.client_fd < 0 || size == 0) {
+        return;
+    }
+    while (size) {
+        len = send(server.client_fd, data, size, MSG_NOSIGNAL);
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            close(server.client_fd);
+            server.client_fd = -1;
+            return;
+        }
+        data += len;
+        size -= len;
+    }
+    server.last_char = data[-1];
+}
+
+/**
+ * reply the formatted text to current client, it's only used in command handler
+ *
+ * @param format output format
+ * @param ... args
+ */
+void elog_ctl_reply(const char *format, ...) {
+    char buf[ELOG_LINE_BUF_SIZE];
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (len < 0) {
+        return;
+    }
+    elog_ctl_reply_raw(buf, (size_t) len < sizeof(buf) ? (size_t) len : sizeof(buf) - 1);
+}
+
+static bool cmd_help(EasyLogger_t elog, char *arg) {
+    size_t i;
+
+    (void) elog;
+    (void) arg;
+
+    for (i = 0; i < sizeof(builtin_cmd) / sizeof(builtin_cmd[0]); i++) {
+        elog_ctl_reply("%-10s %s\n", builtin_cmd[i].name, builtin_cmd[i].help);
+    }
+    pthread_mutex_lock(&user_cmd_lock);
+    for (i = 0; i < user_cmd_num; i++) {
+        elog_ctl_reply("%-10s %s\n", user_cmd[i].name, user_cmd[i].help);
+    }
+    pthread_mutex_unlock(&user_cmd_lock);
+
+    return true;
+}
+
+static bool cmd_stats(EasyLogger_t elog, char *arg) {
+    ElogStats stats;
+    uint8_t level;
+
+    (void) arg;
+
+    elog_inst_get_stats(elog, &stats);
+    elog_ctl_reply("output  :");
+    for (level = 0; level < ELOG_LVL_TOTAL_NUM; level++) {
+        elog_ctl_reply(" %c=%lu", level_name[level], (unsigned long) stats.output[level]);
+    }
+    elog_ctl_reply("\nfiltered: %lu\nlimited : %lu\ndeduped : %lu\ndropped : %lu\n", (unsigned long) stats.filtered,
+            (unsigned long) stats.limited, (unsigned long) stats.deduped, (unsigned long) stats.dropped);
+    if (stats.async_size) {
+        elog_ctl_reply("async   : %lu/%lu\n", (unsigned long) stats.async_used, (unsigned long) stats.async_size);
+    }
+    if (stats.buf_size) {
+        elog_ctl_reply("buf     : %lu/%lu\n", (unsigned long) stats.buf_used, (unsigned long) stats.buf_size);
+    }
+
+    return true;
+}
+
+static bool cmd_filter(EasyLogger_t elog, char *arg) {
+    ElogFilter filter;
+    size_t i;
+
+    (void) arg;
+
+    elog_inst_get_filter(elog, &filter);
+    elog_ctl_reply("level    : %c\ntag      : %s\nkeyword  : %s\n", level_name[filter.level], filter.tag,
+            filter.keyword);
+    for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        if (filter.tag_lvl[i].tag_use_flag) {
+            elog_ctl_reply("tag_level: %s %c\n", filter.tag_lvl[i].tag, level_name[filter.tag_lvl[i].level]);
+        }
+    }
+
+    return true;
+}
+
+static bool cmd_level(EasyLogger_t elog, char *arg) {
+    int8_t level = elog_lvl_from_str(arg);
+
+    if (level < 0) {
+        elog_ctl_reply("invalid level '%s'\n", arg);
+        return false;
+    }
+    elog_inst_set_filter_lvl(elog, (uint8_t) level);
+
+    return true;
+}
+
+static bool cmd_tag(EasyLogger_t elog, char *arg) {
+    elog_inst_set_filter_tag(elog, arg);
+
+    return true;
+}
+
+static bool cmd_keyword(EasyLogger_t elog, char *arg) {
+    elog_inst_set_filter_kw(elog, arg);
+
+    return true;
+}
+
+static bool cmd_tag_level(EasyLogger_t elog, char *arg) {
+    char *tag = arg, *lvl = strchr(arg, ' ');
+    int8_t level;
+
+    if (lvl == NULL || lvl == tag) {
+        elog_ctl_reply("usage: tag_level <tag> <lvl>\n");
+        return false;
+    }
+    *lvl++ = '\0';
+    while (*lvl == ' ') {
+        lvl++;
+    }
+    if ((level = elog_lvl_from_str(lvl)) < 0) {
+        elog_ctl_reply("invalid level '%s'\n", lvl);
+        return false;
+    }
+    elog_inst_set_filter_tag_lvl(elog, tag, (uint8_t) level);
+
+    return true;
+}
+
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+static bool cmd_flush(EasyLogger_t elog, char *arg) {
+    (void) arg;
+
+    elog_inst_flush(elog);
+
+    return true;
+}
+#endif /* ELOG_BUF_OUTPUT_ENABLE */
+
+#ifdef ELOG_CONFIG_RELOAD_ENABLE
+static bool cmd_reload(EasyLogger_t elog, char *arg) {
+    if (*arg == '\0') {
+        elog_ctl_reply("usage: reload <path>\n");
+        return false;
+    }
+
+    return elog_inst_config_load(elog, arg);
+}
+#endif /* ELOG_CONFIG_RELOAD_ENABLE */
+
+#ifdef ELOG_BLACKBOX_ENABLE
+static bool cmd_blackbox(EasyLogger_t elog, char *arg) {
+    extern void elog_inst_output_lock(EasyLogger_t elog);
+    extern void elog_inst_output_unlock(EasyLogger_t elog);
+
+    const ElogBlackbox *bb = NULL;
+    char *image = NULL;
+    size_t size = 0;
+
+    (void) arg;
+
+    elog_inst_output_lock(elog);
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+    bb = elog->async.blackbox;
+#elif defined(ELOG_BUF_OUTPUT_ENABLE)
+    bb = elog->buf.blackbox;
+#endif
+    /* the image is copied with lock, then it's replied without blocking the logging threads */
+    if (bb) {
+        size = bb->buf_offset + bb->buf_size;
+        if ((image = malloc(size)) != NULL) {
+            memcpy(image, bb, size);
+        }
+    }
+    elog_inst_output_unlock(elog);
+
+    if (bb == NULL) {
+        elog_ctl_reply("black box is unused\n");
+        return false;
+    }
+    if (image == NULL) {
+        return false;
+    }
+    elog_blackbox_extract(image, size, elog_ctl_reply_raw);
+    free(image);
+
+    return true;
+}
+#endif /* ELOG_BLACKBOX_ENABLE */
+
+/**
+ * read the command line from client
+ *
+ * @return true: read success
+ */
+static bool ctl_read_line(int fd, char *line, size_t size) {
+    size_t len = 0;
+    ssize_t result;
+    char *end;
+
+    while (len < size - 1) {
+        result = recv(fd, line + len, size - 1 - len, 0);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            break;
+        }
+        len += result;
+        line[len] = '\0';
+        if (strchr(line, '\n')) {
+            break;
+        }
+    }
+    line[len] = '\0';
+    if ((end = strpbrk(line, "\r\n")) != NULL) {
+        *end = '\0';
+    }
+
+    return len > 0;
+}
+
+/**
+ * execute the command line, the status line is replied after the command output
+ */
+static void ctl_execute(char *line) {
+    ElogCtlHandler handler = NULL;
+    char *arg;
+    size_t i;
+    bool result = false;
+
+    while (*line == ' ') {
+        line++;
+    }
+    if ((arg = strchr(line, ' ')) != NULL) {
+        *arg++ = '\0';
+        while (*arg == ' ') {
+            arg++;
+        }
+    } else {
+        arg = line + strlen(line);
+    }
+
+    for (i = 0; i < sizeof(builtin_cmd) / sizeof(builtin_cmd[0]); i++) {
+        if (!strcmp(builtin_cmd[i].name, line)) {
+            handler = builtin_cmd[i].handler;
+            break;
+        }
+    }
+    if (handler == NULL) {
+        pthread_mutex_lock(&user_cmd_lock);
+        for (i = 0; i < user_cmd_num; i++) {
+            if (!strcmp(user_cmd[i].name, line)) {
+                handler = user_cmd[i].handler;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&user_cmd_lock);
+    }
+
+    server.last_char = '\n';
+    if (handler) {
+        result = handler(server.elog, arg);
+    } else {
+        elog_ctl_reply("unknown command '%s', try 'help'\n", line);
+    }
+    if (server.last_char != '\n') {
+        elog_ctl_reply_raw("\n", 1);
+    }
+    elog_ctl_reply_raw(result ? "ok\n" : "error\n", result ? 3 : 6);
+}
+
+/**
+ * check the client is running as the same user of this process
+ *
+ * @return true: the client is allowed
+ */
+static bool ctl_peer_allowed(int fd) {
+#if defined(SO_PEERCRED)
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0) {
+        return false;
+    }
+
+    return cred.uid == geteuid();
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    uid_t uid;
+    gid_t gid;
+
+    if (getpeereid(fd, &uid, &gid) < 0) {
+        return false;
+    }
+
+    return uid == geteuid();
+#else
+    /* only the socket file mode is checked */
+    (void) fd;
+    return true;
+#endif
+}
+
+static void *ctl_server_thread(void *arg) {
+    struct timeval timeout = { CLIENT_IO_TIMEOUT / 1000, (CLIENT_IO_TIMEOUT % 1000) * 1000 };
+    struct pollfd fds[2];
+    char line[CMD_LINE_MAX_LEN];
+
+    (void) arg;
+    fds[0].fd = server.listen_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = server.wake_fd[0];
+    fds[1].events = POLLIN;
+
+    while (poll(fds, 2, -1) >= 0 || errno == EINTR) {
+        if (fds[1].revents) {
+            break;
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+        server.client_fd = accept(server.listen_fd, NULL, NULL);
+        if (server.client_fd < 0) {
+            continue;
+        }
+        fcntl(server.client_fd, F_SETFD, FD_CLOEXEC);
+        if (!ctl_peer_allowed(server.client_fd)) {
+            close(server.client_fd);
+            server.client_fd = -1;
+            continue;
+        }
+        /* the slow client can't block the server */
+        setsockopt(server.client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(server.client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if (ctl_read_line(server.client_fd, line, sizeof(line))) {
+            ctl_execute(line);
+        }
+        if (server.client_fd >= 0) {
+            close(server.client_fd);
+            server.client_fd = -1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * check the socket is listened by other server
+ *
+ * @return true: the socket is in use
+ */
+static bool ctl_socket_in_use(const struct sockaddr_un *addr) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool result;
+
+    if (fd < 0) {
+        return false;
+    }
+    result = connect(fd, (const struct sockaddr *) addr, sizeof(*addr)) == 0;
+    close(fd);
+
+    return result;
+}
+
+/**
+ * Start the control server for default object on its own thread.
+ * The socket file which is left by the exited process will be replaced.
+ *
+ * @param path Unix domain socket path, NULL: using ELOG_CTL_PATH
+ *
+ * @return true: start success
+ */
+bool elog_ctl_start(const char *path) {
+    return elog_inst_ctl_start(elog_get_default(), path);
+}
+
+bool elog_inst_ctl_start(EasyLogger_t elog, const char *path) {
+    struct sockaddr_un addr;
+
+    ELOG_ASSERT(elog);
+
+    if (path == NULL) {
+        path = ELOG_CTL_PATH;
+    }
+    if (server.running || strlen(path) >= sizeof(server.path)) {
+        return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (ctl_socket_in_use(&addr)) {
+        return false;
+    }
+    unlink(path);
+
+    server.listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server.listen_fd < 0) {
+        return false;
+    }
+    fcntl(server.listen_fd, F_SETFD, FD_CLOEXEC);
+    if (bind(server.listen_fd, (const struct sockaddr *) &addr, sizeof(addr)) < 0) {
+        goto __error;
+    }
+    /* Only the owner can control the logger. The process wide umask isn't changed, the socket file can't be
+     * connected before listen, and the client is still checked by its credentials. */
+    if (chmod(path, S_IRWXU) < 0 || listen(server.listen_fd, 4) < 0 || pipe(server.wake_fd) < 0) {
+        unlink(path);
+        goto __error;
+    }
+    fcntl(server.wake_fd[0], F_SETFD, FD_CLOEXEC);
+    fcntl(server.wake_fd[1], F_SETFD, FD_CLOEXEC);
+    strcpy(server.path, path);
+    server.elog = elog;
+    if (pthread_create(&server.thread, NULL, ctl_server_thread, NULL) != 0) {
+        unlink(path);
+        close(server.wake_fd[0]);
+        close(server.wake_fd[1]);
+        server.wake_fd[0] = server.wake_fd[1] = -1;
+        goto __error;
+    }
+    server.running = true;
+
+    return true;
+
+__error:
+    close(server.listen_fd);
+    server.listen_fd = -1;
+
+    return false;
+}
+
+/**
+ * stop the control server and remove its socket file
+ */
+void elog_ctl_stop(void) {
+    if (!server.running) {
+        return;
+    }
+    if (write(server.wake_fd[1], "", 1) < 0) {
+        /* the thread won't exit without wake up */
+        return;
+    }
+    pthread_join(server.thread, NULL);
+    close(server.listen_fd);
+    close(server.wake_fd[0]);
+    close(server.wake_fd[1]);
+    server.listen_fd = server.wake_fd[0] = server.wake_fd[1] = -1;
+    unlink(server.path);
+    server.running = false;
+}
+
+#endif /* ELOG_CTL_ENABLE */
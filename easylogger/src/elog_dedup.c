@@ -0,0 +1,197 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Duplicate logs suppression. The repeated log is collapsed to "last message repeated N times"
+ *           after it's formatted, so it won't consume the ring buffer and output bandwidth.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+
+#ifdef ELOG_DEDUP_ENABLE
+
+#define FNV1A64_OFFSET                           0xCBF29CE484222325ULL
+#define FNV1A64_PRIME                            0x100000001B3ULL
+
+extern uint32_t elog_port_get_tick(void);
+extern void elog_inst_output_lock(EasyLogger_t elog);
+extern void elog_inst_output_unlock(EasyLogger_t elog);
+extern void elog_summary_output(EasyLogger_t elog, uint8_t level, const char *tag, const char *format, ...);
+
+static uint64_t fnv1a64(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *p = data;
+
+    while (size--) {
+        hash ^= *p++;
+        hash *= FNV1A64_PRIME;
+    }
+
+    return hash;
+}
+
+static uint64_t fnv1a64_str(uint64_t hash, const char *str) {
+    return str ? fnv1a64(hash, str, strlen(str) + 1) : fnv1a64(hash, "", 1);
+}
+
+/**
+ * output the last log's repeated number, the output lock must be held
+ *
+ * @param elog EasyLogger object
+ */
+void elog_dedup_flush(EasyLogger_t elog) {
+    ElogDedup *dedup = &elog->dedup;
+
+    if (dedup->repeat) {
+        elog_summary_output(elog, dedup->level, dedup->tag, "last message repeated %lu times",
+                (unsigned long) dedup->repeat);
+        dedup->repeat = 0;
+    }
+}
+
+/**
+ * output the last log's repeated number when the window is expired, the output lock must be held
+ *
+ * @param elog EasyLogger object
+ *
+ * @return the time (ms) until the current window is expired, 0: the suppression has no window
+ */
+uint32_t elog_dedup_expire(EasyLogger_t elog) {
+    ElogDedup *dedup = &elog->dedup;
+    uint32_t elapsed;
+
+    if (dedup->mode == ELOG_DEDUP_NONE || dedup->window == 0) {
+        return 0;
+    }
+
+    elapsed = elog_port_get_tick() - dedup->tick;
+    if (elapsed < dedup->window) {
+        return dedup->window - elapsed;
+    }
+    /* the hash is kept, so the next same log is output as a new one */
+    elog_dedup_flush(elog);
+
+    return dedup->window;
+}
+
+/**
+ * Output the last log's repeated number when the window is expired. The asynchronous output thread
+ * calls it on every window. Otherwise it should be called periodically (such as in a timer or the idle task),
+ * or the repeated number is output until the next log arrives.
+ */
+void elog_dedup_poll(void) {
+    elog_inst_dedup_poll(elog_get_default());
+}
+
+void elog_inst_dedup_poll(EasyLogger_t elog) {
+    elog_inst_output_lock(elog);
+    elog_dedup_expire(elog);
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * Set the duplicate log suppression mode. The repeated log will be collapsed to
+ * "last message repeated N times", which is output when a different log arrives or the window is expired.
+ *
+ * @param mode ELOG_DEDUP_NONE: disable, ELOG_DEDUP_MSG: compare the formatted message,
+ *        ELOG_DEDUP_CALLSITE: compare the callsite (file, function and line)
+ * @param window the repeated log is collapsed in the window (ms) since the log is output, 0: no limit
+ */
+void elog_set_dedup(uint8_t mode, uint32_t window) {
+    elog_inst_set_dedup(elog_get_default(), mode, window);
+}
+
+void elog_inst_set_dedup(EasyLogger_t elog, uint8_t mode, uint32_t window) {
+    ELOG_ASSERT(mode <= ELOG_DEDUP_CALLSITE);
+
+    elog_inst_output_lock(elog);
+    elog_dedup_flush(elog);
+    elog->dedup.hash = 0;
+    elog->dedup.mode = (ElogDedupMode) mode;
+    elog->dedup.window = window;
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * calculate the log record's hash by suppression mode
+ */
+static uint64_t record_hash(ElogDedupMode mode, const ElogRecord *rec) {
+    uint64_t hash = fnv1a64(FNV1A64_OFFSET, &rec->level, sizeof(rec->level));
+    size_t i;
+
+    hash = fnv1a64_str(hash, rec->tag);
+    if (mode == ELOG_DEDUP_CALLSITE) {
+        hash = fnv1a64(hash, &rec->file, sizeof(rec->file));
+        hash = fnv1a64(hash, &rec->func, sizeof(rec->func));
+        hash = fnv1a64(hash, &rec->line, sizeof(rec->line));
+        return hash;
+    }
+    hash = fnv1a64(hash, rec->msg, rec->msg_len);
+    for (i = 0; i < rec->kv_num; i++) {
+        hash = fnv1a64_str(hash, rec->kv[i].key);
+        if (rec->kv[i].type == ELOG_KV_STR) {
+            hash = fnv1a64_str(hash, rec->kv[i].value.str);
+        } else {
+            hash = fnv1a64(hash, &rec->kv[i].value, sizeof(rec->kv[i].value));
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * Check the formatted log record is duplicate, the output lock must be held.
+ * The last log's repeated number will be output before the different log.
+ *
+ * @param elog EasyLogger object
+ * @param rec log record
+ *
+ * @return true: the log is duplicate, it will be dropped
+ */
+bool elog_dedup_check(EasyLogger_t elog, const ElogRecord *rec) {
+    ElogDedup *dedup = &elog->dedup;
+    uint64_t hash;
+    uint32_t tick;
+
+    if (dedup->mode == ELOG_DEDUP_NONE) {
+        return false;
+    }
+
+    hash = record_hash(dedup->mode, rec);
+    tick = elog_port_get_tick();
+    if (dedup->hash == hash && (dedup->window == 0 || tick - dedup->tick < dedup->window)) {
+        dedup->repeat++;
+        return true;
+    }
+    /* the different log arrives or the window is expired */
+    elog_dedup_flush(elog);
+    dedup->hash = hash;
+    dedup->tick = tick;
+    dedup->level = rec->level;
+    strncpy(dedup->tag, rec->tag, ELOG_FILTER_TAG_MAX_LEN);
+
+    return false;
+}
+
+#endif /* ELOG_DEDUP_ENABLE */
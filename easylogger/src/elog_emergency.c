@@ -0,0 +1,333 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Async-signal-safe emergency output. It's used in the signal handler such as SIGSEGV,
+ *           the log is formatted without stdio, and written to the configured fds by write(2).
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+#include <stdarg.h>
+
+#ifdef ELOG_EMERGENCY_ENABLE
+#include <unistd.h>
+#include <errno.h>
+
+/* max number of the emergency output fds */
+#ifdef ELOG_EMERGENCY_FD_MAX_NUM
+#define FD_MAX_NUM                               ELOG_EMERGENCY_FD_MAX_NUM
+#else
+#define FD_MAX_NUM                               4
+#endif
+
+/* level sign for emergency log */
+static const char level_sign[] = { 'A', 'E', 'W', 'I', 'D', 'V' };
+/* emergency output fds, the standard error is used by default */
+static int emergency_fds[FD_MAX_NUM] = { STDERR_FILENO };
+static size_t emergency_fd_num = 1;
+/* preallocated emergency log buffer, it's busy when a signal handler is using it */
+static char emergency_buf[ELOG_LINE_BUF_SIZE];
+static volatile int emergency_buf_busy = 0;
+
+extern bool elog_port_output_trylock(void);
+extern void elog_port_output_unlock(void);
+
+/**
+ * set the emergency output fds, it's not async-signal-safe
+ *
+ * @param fds file descriptors, such as STDERR_FILENO and the crash log file
+ * @param num fds number, the fds which is beyond ELOG_EMERGENCY_FD_MAX_NUM will be ignored
+ */
+void elog_emergency_set_fds(const int *fds, size_t num) {
+    size_t i;
+
+    if (num > FD_MAX_NUM) {
+        num = FD_MAX_NUM;
+    }
+    /* the signal handler may see the old fds, but never the invalid count */
+    emergency_fd_num = 0;
+    for (i = 0; i < num; i++) {
+        emergency_fds[i] = fds[i];
+    }
+    emergency_fd_num = num;
+}
+
+/**
+ * write the log to all emergency output fds, it's async-signal-safe
+ *
+ * @param log log
+ * @param size log size
+ */
+static void emergency_write(const char *log, size_t size) {
+    size_t i, written;
+    ssize_t len;
+
+    for (i = 0; i < emergency_fd_num; i++) {
+        for (written = 0; written < size; written += len) {
+            len = write(emergency_fds[i], log + written, size - written);
+            if (len < 0 && errno == EINTR) {
+                len = 0;
+            } else if (len <= 0) {
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * put the char to buffer
+ */
+static size_t put_char(char *buf, size_t cur_len, size_t size, char c) {
+    if (cur_len < size) {
+        buf[cur_len] = c;
+    }
+    return cur_len + 1;
+}
+
+/**
+ * put the unsigned integer to buffer
+ *
+ * @param value unsigned integer
+ * @param base 10 or 16
+ * @param width min width
+ * @param pad pad char, ' ' or '0'
+ * @param negative the integer is negative
+ */
+static size_t put_uint(char *buf, size_t cur_len, size_t size, unsigned long long value, unsigned base,
+        size_t width, char pad, bool negative) {
+    const char *digits = "0123456789abcdef";
+    char tmp[24];
+    size_t len = 0;
+
+    do {
+        tmp[len++] = digits[value % base];
+        value /= base;
+    } while (value);
+    if (negative) {
+        if (pad == '0') {
+            cur_len = put_char(buf, cur_len, size, '-');
+        } else {
+            tmp[len++] = '-';
+        }
+        width = width ? width - 1 : 0;
+    }
+    for (; width > len; width--) {
+        cur_len = put_char(buf, cur_len, size, pad);
+    }
+    while (len) {
+        cur_len = put_char(buf, cur_len, size, tmp[--len]);
+    }
+
+    return cur_len;
+}
+
+/**
+ * Async-signal-safe format, it only supports the flag '0' and '-', width, the length modifier
+ * 'h', 'l', 'll' and 'z', and the conversion 'd', 'i', 'u', 'x', 'p', 's', 'c' and '%'.
+ *
+ * @param buf output buffer
+ * @param size output buffer size
+ * @param format format
+ * @param args arguments
+ *
+ * @return formatted length, it's not more than size
+ */
+static size_t emergency_vformat(char *buf, size_t size, const char *format, va_list args) {
+    size_t cur_len = 0, width, start;
+    unsigned long long u;
+    long long i;
+    const char *s;
+    char pad;
+    bool left;
+    int lng;
+
+    for (; *format; format++) {
+        if (*format != '%') {
+            cur_len = put_char(buf, cur_len, size, *format);
+            continue;
+        }
+        pad = ' ';
+        left = false;
+        width = 0;
+        lng = 0;
+        for (format++; *format == '0' || *format == '-'; format++) {
+            if (*format == '0') {
+                pad = '0';
+            } else {
+                left = true;
+            }
+        }
+        for (; *format >= '0' && *format <= '9'; format++) {
+            width = width * 10 + *format - '0';
+        }
+        for (; *format == 'l' || *format == 'h' || *format == 'z'; format++) {
+            if (*format == 'l') {
+                lng++;
+            } else if (*format == 'z') {
+                lng = sizeof(size_t) > sizeof(long) ? 2 : 1;
+            }
+        }
+        if (left) {
+            pad = ' ';
+        }
+        start = cur_len;
+        switch (*format) {
+        case 'd':
+        case 'i':
+            i = lng >= 2 ? va_arg(args, long long) : lng ? va_arg(args, long) : va_arg(args, int);
+            u = i < 0 ? 0ULL - (unsigned long long) i : (unsigned long long) i;
+            cur_len = put_uint(buf, cur_len, size, u, 10, left ? 0 : width, pad, i < 0);
+            break;
+        case 'u':
+        case 'x':
+            u = lng >= 2 ? va_arg(args, unsigned long long) : lng ? va_arg(args, unsigned long) :
+                    va_arg(args, unsigned int);
+            cur_len = put_uint(buf, cur_len, size, u, *format == 'u' ? 10 : 16, left ? 0 : width, pad, false);
+            break;
+        case 'p':
+            cur_len = put_char(buf, cur_len, size, '0');
+            cur_len = put_char(buf, cur_len, size, 'x');
+            cur_len = put_uint(buf, cur_len, size, (unsigned long long) (uintptr_t) va_arg(args, void *), 16, 0,
+                    ' ', false);
+            break;
+        case 's':
+            s = va_arg(args, const char *);
+            if (!s) {
+                s = "(null)";
+            }
+            for (; !left && width > strlen(s); width--) {
+                cur_len = put_char(buf, cur_len, size, ' ');
+            }
+            for (; *s; s++) {
+                cur_len = put_char(buf, cur_len, size, *s);
+            }
+            break;
+        case 'c':
+            cur_len = put_char(buf, cur_len, size, (char) va_arg(args, int));
+            break;
+        case '%':
+            cur_len = put_char(buf, cur_len, size, '%');
+            break;
+        case '\0':
+            format--;
+            break;
+        default:
+            cur_len = put_char(buf, cur_len, size, '%');
+            cur_len = put_char(buf, cur_len, size, *format);
+            break;
+        }
+        for (; left && cur_len - start < width; ) {
+            cur_len = put_char(buf, cur_len, size, ' ');
+        }
+    }
+
+    return cur_len < size ? cur_len : size;
+}
+
+/**
+ * Output the emergency log, it's async-signal-safe. The log has level and tag only, and it's
+ * written to the emergency output fds directly without the output lock, filter and sinks.
+ * It will be dropped when the emergency buffer is used by other signal handler.
+ *
+ * @param level level
+ * @param tag tag
+ * @param format output format, see emergency_vformat for the supported format
+ * @param ... args
+ */
+void elog_emergency_output(uint8_t level, const char *tag, const char *format, ...) {
+    size_t newline_len = strlen(ELOG_NEWLINE_SIGN), size = sizeof(emergency_buf) - newline_len, len = 0;
+    va_list args;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    if (__sync_lock_test_and_set(&emergency_buf_busy, 1)) {
+        return;
+    }
+
+    len = put_char(emergency_buf, len, size, level_sign[level]);
+    len = put_char(emergency_buf, len, size, '/');
+    for (; tag && *tag; tag++) {
+        len = put_char(emergency_buf, len, size, *tag);
+    }
+    len = put_char(emergency_buf, len, size, ' ');
+    if (len > size) {
+        len = size;
+    }
+    va_start(args, format);
+    len += emergency_vformat(emergency_buf + len, size - len, format, args);
+    va_end(args);
+    memcpy(emergency_buf + len, ELOG_NEWLINE_SIGN, newline_len);
+    emergency_write(emergency_buf, len + newline_len);
+
+    __sync_lock_release(&emergency_buf_busy);
+}
+
+/**
+ * Flush the default object's asynchronous output ring buffer, its sinks' ring buffers and buffered
+ * output mode buffer to the emergency output fds, it's async-signal-safe. They will be skipped when
+ * the output lock is held by other thread or the interrupted code, the black box can keep the object's
+ * buffers in this case.
+ */
+void elog_emergency_flush(void) {
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    extern void elog_async_emergency_drain(ElogAsync *async, void (*output)(const char *log, size_t size));
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    extern void elog_buf_emergency_drain(EasyLogger_t elog, void (*output)(const char *log, size_t size));
+#endif
+
+    EasyLogger_t elog = elog_get_default();
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    ElogSink_t sink;
+#endif
+    bool locked = false;
+
+    if (!elog->init_ok) {
+        return;
+    }
+    if (elog->output_lock_enabled) {
+        locked = elog_port_output_trylock();
+        if (!locked) {
+            return;
+        }
+    }
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    elog_async_emergency_drain(&elog->async, emergency_write);
+    /* the sinks list and their ring buffers are protected by the same output lock */
+    for (sink = elog->sinks; sink; sink = sink->next) {
+        if (sink != &elog->output_sink) {
+            elog_async_emergency_drain(&sink->async, emergency_write);
+        }
+    }
+#endif
+#ifdef ELOG_BUF_OUTPUT_ENABLE
+    elog_buf_emergency_drain(elog, emergency_write);
+#endif
+    if (locked) {
+        elog_port_output_unlock();
+    }
+}
+
+#endif /* ELOG_EMERGENCY_ENABLE */
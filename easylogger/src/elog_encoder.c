@@ -0,0 +1,732 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: JSON lines and logfmt encoders for the structured log record.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+/* the JSON string escape is scanning 16 bytes once by SSE2, otherwise one machine word once */
+#if defined(__SSE2__) && defined(__GNUC__)
+#define ENCODER_USING_SSE2
+#include <emmintrin.h>
+#endif
+
+/* line log writer, it never splits an escape sequence and always keeps the space for line end */
+typedef struct {
+    char *buf;
+    size_t limit;                                /**< writable size, the reserved space for line end is excluded */
+    size_t len;
+    bool full;                                   /**< the following field will be dropped when it's full */
+} LogWriter;
+
+/* level name */
+static const char *level_name[] = {
+        [ELOG_LVL_ASSERT]  = "assert",
+        [ELOG_LVL_ERROR]   = "error",
+        [ELOG_LVL_WARN]    = "warn",
+        [ELOG_LVL_INFO]    = "info",
+        [ELOG_LVL_DEBUG]   = "debug",
+        [ELOG_LVL_VERBOSE] = "verbose",
+};
+
+static bool writer_init(LogWriter *w, char *buf, size_t size, size_t reserve) {
+    if (size <= reserve) {
+        return false;
+    }
+    w->buf = buf;
+    w->limit = size - reserve;
+    w->len = 0;
+    w->full = false;
+    return true;
+}
+
+/**
+ * write the data, it's all written or nothing is written
+ */
+static void write_raw(LogWriter *w, const char *data, size_t size) {
+    if (w->full) {
+        return;
+    }
+    if (w->len + size > w->limit) {
+        w->full = true;
+        return;
+    }
+    memcpy(w->buf + w->len, data, size);
+    w->len += size;
+}
+
+static void write_str(LogWriter *w, const char *str) {
+    write_raw(w, str, strlen(str));
+}
+
+/**
+ * get the length of the leading run which has no character need to be escaped in JSON string
+ *
+ * @param src string
+ * @param len string length
+ *
+ * @return the run length
+ */
+static size_t json_plain_len(const char *src, size_t len) {
+    size_t i = 0;
+    unsigned char c;
+
+#ifdef ENCODER_USING_SSE2
+    const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+    __m128i data, found;
+    int mask;
+
+    for (; i + 16 <= len; i += 16) {
+        data = _mm_loadu_si128((const __m128i *) (src + i));
+        /* the control character is less than 0x20: max(data, 0x1F) == 0x1F */
+        found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, quote), _mm_cmpeq_epi8(data, backslash)),
+                _mm_cmpeq_epi8(_mm_max_epu8(data, ctrl), ctrl));
+        mask = _mm_movemask_epi8(found);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#else
+#define WORD_ONES                ((size_t) -1 / 0xFF)
+#define WORD_HIGHS               (WORD_ONES * 0x80)
+/* any byte in word is less than n (n <= 128) */
+#define WORD_HAS_LESS(x, n)      (((x) - WORD_ONES * (n)) & ~(x) & WORD_HIGHS)
+#define WORD_HAS_ZERO(x)         WORD_HAS_LESS(x, 1)
+    size_t word;
+
+    for (; i + sizeof(size_t) <= len; i += sizeof(size_t)) {
+        memcpy(&word, src + i, sizeof(size_t));
+        if (WORD_HAS_LESS(word, 0x20) || WORD_HAS_ZERO(word ^ (WORD_ONES * '"'))
+                || WORD_HAS_ZERO(word ^ (WORD_ONES * '\\'))) {
+            /* find the exact position by bytes */
+            break;
+        }
+    }
+#endif /* ENCODER_USING_SSE2 */
+
+    for (; i < len; i++) {
+        c = (unsigned char) src[i];
+        if (c == '"' || c == '\\' || c < 0x20) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * write the escaped JSON string content, the unchanged runs are copied in bulk.
+ * The string will be truncated on the UTF-8 character boundary when it's full.
+ */
+static void write_json_escaped(LogWriter *w, const char *src, size_t len) {
+    size_t run, room, esc_len;
+    char esc[8];
+
+    while (len && !w->full) {
+        run = json_plain_len(src, len);
+        room = w->limit - w->len;
+        if (run > room) {
+            run = room;
+            /* don't split the UTF-8 multi-byte character */
+            while (run && ((unsigned char) src[run] & 0xC0) == 0x80) {
+                run--;
+            }
+            w->full = true;
+        }
+        memcpy(w->buf + w->len, src, run);
+        w->len += run;
+        src += run;
+        len -= run;
+        if (w->full || !len) {
+            break;
+        }
+        /* escape one character */
+        switch (*src) {
+        case '"':  esc_len = 2; memcpy(esc, "\\\"", 2); break;
+        case '\\': esc_len = 2; memcpy(esc, "\\\\", 2); break;
+        case '\n': esc_len = 2; memcpy(esc, "\\n", 2); break;
+        case '\r': esc_len = 2; memcpy(esc, "\\r", 2); break;
+        case '\t': esc_len = 2; memcpy(esc, "\\t", 2); break;
+        default:   esc_len = snprintf(esc, sizeof(esc), "\\u%04x", (unsigned char) *src); break;
+        }
+        write_raw(w, esc, esc_len);
+        src++;
+        len--;
+    }
+}
+
+/**
+ * write the quoted JSON string, the closing quote is always written even the string is truncated
+ */
+static void write_json_string(LogWriter *w, const char *str, size_t len) {
+    if (w->full) {
+        return;
+    }
+    if (w->len + 2 > w->limit) {
+        w->full = true;
+        return;
+    }
+    w->buf[w->len++] = '"';
+    /* keep the space for closing quote */
+    w->limit--;
+    write_json_escaped(w, str, len);
+    w->limit++;
+    w->buf[w->len++] = '"';
+}
+
+/**
+ * write the JSON field, the whole field is dropped when the key and value beginning can't be written
+ */
+static void json_field(LogWriter *w, const char *key, const char *value, size_t value_len) {
+    size_t start = w->len, value_start;
+
+    if (w->full) {
+        return;
+    }
+    /* the first field is after '{' */
+    if (start > 1) {
+        write_raw(w, ",", 1);
+    }
+    write_raw(w, "\"", 1);
+    write_json_escaped(w, key, strlen(key));
+    write_raw(w, "\":", 2);
+    value_start = w->len;
+    write_json_string(w, value, value_len);
+    if (w->full && w->len <= value_start) {
+        /* the value is not started */
+        w->len = start;
+    }
+}
+
+static void json_field_num(LogWriter *w, const char *key, long value) {
+    char field[ELOG_FILTER_TAG_MAX_LEN + 32];
+    int len;
+
+    if (w->full) {
+        return;
+    }
+    len = snprintf(field, sizeof(field), "%s\"%s\":%ld", w->len > 1 ? "," : "", key, value);
+    if (len > 0 && (size_t) len < sizeof(field)) {
+        write_raw(w, field, len);
+    }
+}
+
+/**
+ * write the JSON field which value is written directly, the whole field is dropped when it can't be written
+ */
+static void json_field_raw(LogWriter *w, const char *key, const char *value, size_t value_len) {
+    size_t start = w->len;
+
+    if (w->full) {
+        return;
+    }
+    if (start > 1) {
+        write_raw(w, ",", 1);
+    }
+    write_raw(w, "\"", 1);
+    write_json_escaped(w, key, strlen(key));
+    write_raw(w, "\":", 2);
+    write_raw(w, value, value_len);
+    if (w->full) {
+        w->len = start;
+    }
+}
+
+/**
+ * write the typed key/value pair as JSON field, the number and bool are not quoted.
+ * The JSON has no infinite and NaN, they will be written as null.
+ */
+static void json_field_kv(LogWriter *w, const ElogKv *kv) {
+    char value[32];
+    size_t len;
+
+    if (kv->type == ELOG_KV_STR) {
+        json_field(w, kv->key, kv->value.str ? kv->value.str : "", kv->value.str ? strlen(kv->value.str) : 0);
+        return;
+    }
+    if (kv->type == ELOG_KV_F64 && !isfinite(kv->value.f64)) {
+        json_field_raw(w, kv->key, "null", 4);
+        return;
+    }
+    len = elog_kv_value_to_str(kv, value, sizeof(value));
+    json_field_raw(w, kv->key, value, len);
+}
+
+/**
+ * Render the record to JSON line, such as:
+ * {"time":"...","level":"info","tag":"main","process":"...","thread":"...","file":"...","line":1,"func":"...","msg":"..."}
+ * The level, tag and message are always rendered, the other fields are rendered by the sink's format.
+ * The extra key/value pairs are rendered after the message.
+ *
+ * @param sink sink
+ * @param rec log record
+ * @param log line log buffer
+ * @param size line log buffer size
+ *
+ * @return line log length
+ */
+size_t elog_json_render(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size) {
+    size_t fmt = elog_sink_get_fmt(sink, rec->level), i, newline_len = strlen(ELOG_NEWLINE_SIGN);
+    LogWriter w;
+
+    /* reserve the space for '}' and newline sign */
+    if (!writer_init(&w, log, size, 1 + newline_len)) {
+        return 0;
+    }
+
+    write_raw(&w, "{", 1);
+    if (fmt & ELOG_FMT_TIME) {
+        json_field(&w, "time", rec->time, strlen(rec->time));
+    }
+    json_field(&w, "level", level_name[rec->level], strlen(level_name[rec->level]));
+    json_field(&w, "tag", rec->tag, strlen(rec->tag));
+    if (fmt & ELOG_FMT_P_INFO) {
+        json_field(&w, "process", rec->p_info, strlen(rec->p_info));
+    }
+    if (fmt & ELOG_FMT_T_INFO) {
+        json_field(&w, "thread", rec->t_info, strlen(rec->t_info));
+    }
+    if ((fmt & ELOG_FMT_DIR) && rec->file) {
+        json_field(&w, "file", rec->file, strlen(rec->file));
+    }
+    if ((fmt & ELOG_FMT_LINE) && rec->line) {
+        json_field_num(&w, "line", rec->line);
+    }
+    if ((fmt & ELOG_FMT_FUNC) && rec->func) {
+        json_field(&w, "func", rec->func, strlen(rec->func));
+    }
+    json_field(&w, "msg", rec->msg, rec->msg_len);
+    for (i = 0; i < rec->kv_num; i++) {
+        json_field_kv(&w, &rec->kv[i]);
+    }
+
+    /* the line end is using reserved space */
+    w.buf[w.len++] = '}';
+    memcpy(w.buf + w.len, ELOG_NEWLINE_SIGN, newline_len);
+
+    return w.len + newline_len;
+}
+
+/**
+ * the logfmt value need to be quoted
+ */
+static bool logfmt_need_quote(const char *value, size_t len) {
+    size_t i;
+    unsigned char c;
+
+    if (!len) {
+        return true;
+    }
+    for (i = 0; i < len; i++) {
+        c = (unsigned char) value[i];
+        if (c <= ' ' || c == '=' || c == '"' || c == '\\' || c == 0x7F) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * write the logfmt field, the whole field is dropped when the key and value beginning can't be written
+ */
+static void logfmt_field(LogWriter *w, const char *key, const char *value, size_t value_len, bool quote) {
+    size_t start = w->len, value_start;
+
+    if (w->full) {
+        return;
+    }
+    if (start) {
+        write_raw(w, " ", 1);
+    }
+    write_str(w, key);
+    write_raw(w, "=", 1);
+    value_start = w->len;
+    if (quote || logfmt_need_quote(value, value_len)) {
+        write_json_string(w, value, value_len);
+    } else if (!w->full) {
+        /* the unquoted value is truncated directly */
+        if (value_len > w->limit - w->len) {
+            value_len = w->limit - w->len;
+            w->full = true;
+        }
+        memcpy(w->buf + w->len, value, value_len);
+        w->len += value_len;
+    }
+    if (w->full && w->len <= value_start) {
+        /* the value is not started */
+        w->len = start;
+    }
+}
+
+/**
+ * write the typed key/value pair as logfmt field, the number and bool are never truncated
+ */
+static void logfmt_field_kv(LogWriter *w, const ElogKv *kv) {
+    char value[32];
+    size_t len;
+
+    if (kv->type == ELOG_KV_STR) {
+        logfmt_field(w, kv->key, kv->value.str ? kv->value.str : "", kv->value.str ? strlen(kv->value.str) : 0,
+                false);
+        return;
+    }
+    len = elog_kv_value_to_str(kv, value, sizeof(value));
+    if (!w->full && w->len + 1 + strlen(kv->key) + 1 + len > w->limit) {
+        w->full = true;
+        return;
+    }
+    logfmt_field(w, kv->key, value, len, false);
+}
+
+/**
+ * Render the record to logfmt line, such as:
+ * time="..." level=info tag=main process=... thread=... file=... line=1 func=... msg="..."
+ * The level, tag and message are always rendered, the other fields are rendered by the sink's format.
+ * The extra key/value pairs are rendered after the message.
+ *
+ * @param sink sink
+ * @param rec log record
+ * @param log line log buffer
+ * @param size line log buffer size
+ *
+ * @return line log length
+ */
+size_t elog_logfmt_render(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size) {
+    size_t fmt = elog_sink_get_fmt(sink, rec->level), i, newline_len = strlen(ELOG_NEWLINE_SIGN);
+    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
+    LogWriter w;
+
+    /* reserve the space for newline sign */
+    if (!writer_init(&w, log, size, newline_len)) {
+        return 0;
+    }
+
+    if (fmt & ELOG_FMT_TIME) {
+        logfmt_field(&w, "time", rec->time, strlen(rec->time), true);
+    }
+    logfmt_field(&w, "level", level_name[rec->level], strlen(level_name[rec->level]), false);
+    logfmt_field(&w, "tag", rec->tag, strlen(rec->tag), false);
+    if (fmt & ELOG_FMT_P_INFO) {
+        logfmt_field(&w, "process", rec->p_info, strlen(rec->p_info), false);
+    }
+    if (fmt & ELOG_FMT_T_INFO) {
+        logfmt_field(&w, "thread", rec->t_info, strlen(rec->t_info), false);
+    }
+    if ((fmt & ELOG_FMT_DIR) && rec->file) {
+        logfmt_field(&w, "file", rec->file, strlen(rec->file), false);
+    }
+    if ((fmt & ELOG_FMT_LINE) && rec->line) {
+        snprintf(line_num, sizeof(line_num), "%ld", rec->line);
+        logfmt_field(&w, "line", line_num, strlen(line_num), false);
+    }
+    if ((fmt & ELOG_FMT_FUNC) && rec->func) {
+        logfmt_field(&w, "func", rec->func, strlen(rec->func), false);
+    }
+    logfmt_field(&w, "msg", rec->msg, rec->msg_len, true);
+    for (i = 0; i < rec->kv_num; i++) {
+        logfmt_field_kv(&w, &rec->kv[i]);
+    }
+
+    /* the newline sign is using reserved space */
+    memcpy(w.buf + w.len, ELOG_NEWLINE_SIGN, newline_len);
+
+    return w.len + newline_len;
+}
+
+/* binary record magic number */
+#define BINARY_MAGIC                   0xEB
+/* binary record header: magic(1) + record length(2) + level(1) + key/value number(1) */
+#define BINARY_HEAD_SIZE               5
+/* binary record max length */
+#define BINARY_MAX_SIZE                0xFFFF
+
+static void write_varint(LogWriter *w, uint64_t value) {
+    char buf[10];
+    size_t len = 0;
+
+    while (value >= 0x80) {
+        buf[len++] = (char) (value | 0x80);
+        value >>= 7;
+    }
+    buf[len++] = (char) value;
+    write_raw(w, buf, len);
+}
+
+/**
+ * write the string with '\0', it will be decoded to the record without copy
+ */
+static void write_cstr(LogWriter *w, const char *str) {
+    write_raw(w, str ? str : "", (str ? strlen(str) : 0) + 1);
+}
+
+/**
+ * write the typed key/value pair, the whole pair is dropped when it can't be written
+ *
+ * @return true: the pair is written
+ */
+static bool binary_kv(LogWriter *w, const ElogKv *kv) {
+    size_t start = w->len;
+    uint64_t bits;
+    char f64[8];
+    size_t i;
+
+    write_cstr(w, kv->key);
+    write_raw(w, (const char *) &(uint8_t) { (uint8_t) kv->type }, 1);
+    switch (kv->type) {
+    case ELOG_KV_STR:
+        write_cstr(w, kv->value.str);
+        break;
+    case ELOG_KV_I64:
+        /* zigzag encoding, the small negative number is short too */
+        write_varint(w, ((uint64_t) kv->value.i64 << 1) ^ (uint64_t) (kv->value.i64 >> 63));
+        break;
+    case ELOG_KV_U64:
+        write_varint(w, kv->value.u64);
+        break;
+    case ELOG_KV_F64:
+        memcpy(&bits, &kv->value.f64, sizeof(bits));
+        for (i = 0; i < sizeof(f64); i++) {
+            f64[i] = (char) (bits >> (i * 8));
+        }
+        write_raw(w, f64, sizeof(f64));
+        break;
+    case ELOG_KV_BOOL:
+        write_raw(w, kv->value.b ? "\1" : "\0", 1);
+        break;
+    default:
+        break;
+    }
+    if (w->full) {
+        w->len = start;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Render the record to compact binary record, the typed key/value pairs are kept in their type.
+ * It can be decoded by elog_binary_decode. The record is:
+ * magic(0xEB) | record length(u16 LE) | level(u8) | key/value number(u8) | line(varint) |
+ * tag | file | func | time | process | thread | key/value pairs | message
+ * All strings are end with '\0'. The key/value pair is: key | type(u8) | value, the integer value is
+ * varint (zigzag for signed), the double value is 8 bytes little endian and the bool value is u8.
+ * The file, func, time, process and thread are empty when they are not in the sink's format.
+ * The key/value pairs which have no space will be dropped and the message will be truncated.
+ *
+ * @param sink sink
+ * @param rec log record
+ * @param log record buffer
+ * @param size record buffer size
+ *
+ * @return record length, it will be 0 when the buffer is too small
+ */
+size_t elog_binary_render(ElogSink_t sink, const ElogRecord *rec, char *log, size_t size) {
+    size_t fmt = elog_sink_get_fmt(sink, rec->level), i, msg_len;
+    uint8_t kv_num = 0;
+    LogWriter w;
+
+    if (size > BINARY_MAX_SIZE) {
+        size = BINARY_MAX_SIZE;
+    }
+    /* reserve the space for message end sign */
+    if (!writer_init(&w, log, size, 1)) {
+        return 0;
+    }
+
+    w.len = BINARY_HEAD_SIZE;
+    if (w.len > w.limit) {
+        return 0;
+    }
+    write_varint(&w, (fmt & ELOG_FMT_LINE) && rec->line > 0 ? (uint64_t) rec->line : 0);
+    write_cstr(&w, rec->tag);
+    write_cstr(&w, (fmt & ELOG_FMT_DIR) ? rec->file : NULL);
+    write_cstr(&w, (fmt & ELOG_FMT_FUNC) ? rec->func : NULL);
+    write_cstr(&w, (fmt & ELOG_FMT_TIME) ? rec->time : NULL);
+    write_cstr(&w, (fmt & ELOG_FMT_P_INFO) ? rec->p_info : NULL);
+    write_cstr(&w, (fmt & ELOG_FMT_T_INFO) ? rec->t_info : NULL);
+    if (w.full) {
+        return 0;
+    }
+    for (i = 0; i < rec->kv_num && kv_num < UINT8_MAX; i++) {
+        if (binary_kv(&w, &rec->kv[i])) {
+            kv_num++;
+        } else {
+            /* try the following pair, maybe it's shorter */
+            w.full = false;
+        }
+    }
+    /* the message is truncated */
+    msg_len = rec->msg_len;
+    if (msg_len > w.limit - w.len) {
+        msg_len = w.limit - w.len;
+    }
+    memcpy(w.buf + w.len, rec->msg, msg_len);
+    w.len += msg_len;
+    /* the message end sign is using reserved space */
+    w.buf[w.len++] = '\0';
+
+    log[0] = (char) BINARY_MAGIC;
+    log[1] = (char) (w.len & 0xFF);
+    log[2] = (char) (w.len >> 8);
+    log[3] = (char) rec->level;
+    log[4] = (char) kv_num;
+
+    return w.len;
+}
+
+static bool read_varint(const char *log, size_t size, size_t *pos, uint64_t *value) {
+    unsigned int shift = 0;
+    uint8_t byte;
+
+    *value = 0;
+    do {
+        if (*pos >= size || shift > 63) {
+            return false;
+        }
+        byte = (uint8_t) log[(*pos)++];
+        *value |= (uint64_t) (byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    return true;
+}
+
+static const char *read_cstr(const char *log, size_t size, size_t *pos) {
+    const char *str = log + *pos, *end;
+
+    if (*pos >= size || (end = memchr(str, '\0', size - *pos)) == NULL) {
+        return NULL;
+    }
+    *pos += end - str + 1;
+
+    return str;
+}
+
+/**
+ * Decode the binary record which is rendered by elog_binary_render. The record's strings are pointed to
+ * the record buffer, so the buffer must be kept when the record is using.
+ *
+ * @param log record buffer
+ * @param size record buffer size, it can contain more than one record
+ * @param rec decoded log record, the empty file and func will be NULL
+ * @param kv decoded key/value pairs buffer
+ * @param kv_max key/value pairs buffer size, the remaining pairs will be skipped
+ *
+ * @return decoded record length, it will be 0 when the record is incomplete or broken
+ */
+size_t elog_binary_decode(const char *log, size_t size, ElogRecord *rec, ElogKv *kv, size_t kv_max) {
+    size_t rec_len, pos = BINARY_HEAD_SIZE, i, j, kv_num;
+    uint64_t value;
+    ElogKv pair;
+
+    ELOG_ASSERT(log);
+    ELOG_ASSERT(rec);
+
+    if (size < BINARY_HEAD_SIZE || (uint8_t) log[0] != BINARY_MAGIC) {
+        return 0;
+    }
+    rec_len = (uint8_t) log[1] | ((size_t) (uint8_t) log[2] << 8);
+    if (rec_len < BINARY_HEAD_SIZE || rec_len > size || (uint8_t) log[3] > ELOG_LVL_VERBOSE) {
+        return 0;
+    }
+    memset(rec, 0, sizeof(ElogRecord));
+    rec->level = (uint8_t) log[3];
+    kv_num = (uint8_t) log[4];
+    if (!read_varint(log, rec_len, &pos, &value)) {
+        return 0;
+    }
+    rec->line = (long) value;
+    if ((rec->tag = read_cstr(log, rec_len, &pos)) == NULL
+            || (rec->file = read_cstr(log, rec_len, &pos)) == NULL
+            || (rec->func = read_cstr(log, rec_len, &pos)) == NULL
+            || (rec->time = read_cstr(log, rec_len, &pos)) == NULL
+            || (rec->p_info = read_cstr(log, rec_len, &pos)) == NULL
+            || (rec->t_info = read_cstr(log, rec_len, &pos)) == NULL) {
+        return 0;
+    }
+    if (rec->file[0] == '\0') {
+        rec->file = NULL;
+    }
+    if (rec->func[0] == '\0') {
+        rec->func = NULL;
+    }
+    for (i = 0; i < kv_num; i++) {
+        if ((pair.key = read_cstr(log, rec_len, &pos)) == NULL || pos >= rec_len) {
+            return 0;
+        }
+        pair.type = (ElogKvType) (uint8_t) log[pos++];
+        switch (pair.type) {
+        case ELOG_KV_STR:
+            if ((pair.value.str = read_cstr(log, rec_len, &pos)) == NULL) {
+                return 0;
+            }
+            break;
+        case ELOG_KV_I64:
+            if (!read_varint(log, rec_len, &pos, &value)) {
+                return 0;
+            }
+            pair.value.i64 = (int64_t) ((value >> 1) ^ (0 - (value & 1)));
+            break;
+        case ELOG_KV_U64:
+            if (!read_varint(log, rec_len, &pos, &pair.value.u64)) {
+                return 0;
+            }
+            break;
+        case ELOG_KV_F64:
+            if (pos + 8 > rec_len) {
+                return 0;
+            }
+            for (j = 0, value = 0; j < 8; j++) {
+                value |= (uint64_t) (uint8_t) log[pos + j] << (j * 8);
+            }
+            memcpy(&pair.value.f64, &value, sizeof(value));
+            pos += 8;
+            break;
+        case ELOG_KV_BOOL:
+            if (pos >= rec_len) {
+                return 0;
+            }
+            pair.value.b = log[pos++] != 0;
+            break;
+        default:
+            return 0;
+        }
+        if (kv && rec->kv_num < kv_max) {
+            kv[rec->kv_num++] = pair;
+        }
+    }
+    rec->kv = kv;
+    if ((rec->msg = read_cstr(log, rec_len, &pos)) == NULL) {
+        return 0;
+    }
+    rec->msg_len = strlen(rec->msg);
+
+    return rec_len;
+}
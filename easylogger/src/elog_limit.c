@@ -0,0 +1,436 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Logs rate limit and sampling. The token bucket rate limit is configured by tag and level,
+ *           the sampling is configured by level. They are checked before the log is formatted without lock.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+
+/* the suppressed log number report interval (ms) */
+#ifdef ELOG_RATE_LIMIT_REPORT_INTERVAL
+#define REPORT_INTERVAL                          ELOG_RATE_LIMIT_REPORT_INTERVAL
+#else
+#define REPORT_INTERVAL                          5000
+#endif
+
+/* the arrival time is in 1/256 millisecond */
+#define TICK_SCALE                               256
+/* the callsite is put to one of the adjacent buckets */
+#define CALLSITE_WAYS                            2
+
+extern uint32_t elog_port_get_tick(void);
+extern void elog_inst_output_lock(EasyLogger_t elog);
+extern void elog_inst_output_unlock(EasyLogger_t elog);
+extern void elog_summary_output(EasyLogger_t elog, uint8_t level, const char *tag, const char *format, ...);
+
+/**
+ * Set the token bucket rate limit for the tag and level. The log which is over the rate will be suppressed,
+ * and the suppressed log number will be reported periodically.
+ *
+ * example:
+ *     // the warn log of "net" tag can output 10 logs per second, and 20 logs in one burst
+ *     elog_set_rate_limit("net", ELOG_LVL_WARN, 10, 20, false);
+ *     // every callsite of info log can output 1 log per second
+ *     elog_set_rate_limit("", ELOG_LVL_INFO, 1, 1, true);
+ *     // remove the rate limit
+ *     elog_set_rate_limit("net", ELOG_LVL_WARN, 0, 0, false);
+ *
+ * @param tag log tag, the empty tag is matching all tags which have no their own rule
+ * @param level level
+ * @param rate log number per second, 0: remove the rule
+ * @param burst max log number in one burst, it's same as rate when it's 0
+ * @param per_callsite true: every callsite has its own token bucket, false: all callsites share one token bucket
+ */
+void elog_set_rate_limit(const char *tag, uint8_t level, uint32_t rate, uint32_t burst, bool per_callsite) {
+    elog_inst_set_rate_limit(elog_get_default(), tag, level, rate, burst, per_callsite);
+}
+
+void elog_inst_set_rate_limit(EasyLogger_t elog, const char *tag, uint8_t level, uint32_t rate, uint32_t burst,
+        bool per_callsite) {
+    ElogRateLimit *limit = &elog->limit;
+    ElogRateLimitRule *rule = NULL;
+    uint32_t seq, interval = 0, tolerance = 0;
+    uint8_t i, num = 0;
+
+    ELOG_ASSERT(tag);
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    if (burst == 0) {
+        burst = rate;
+    }
+    if (rate) {
+        interval = TICK_SCALE * 1000 / rate;
+        if (interval == 0) {
+            interval = 1;
+        }
+        /* the arrival time is compared in signed 32 bits */
+        if ((uint64_t) interval * burst >= INT32_MAX) {
+            burst = (INT32_MAX - 1) / interval;
+        }
+        tolerance = interval * (burst - 1);
+    }
+
+    elog_inst_output_lock(elog);
+    /* find the rule or a free rule */
+    for (i = 0; i < ELOG_RATE_LIMIT_RULE_MAX_NUM; i++) {
+        if (limit->rule[i].use_flag) {
+            if (limit->rule[i].level == level && !strncmp(limit->rule[i].tag, tag, ELOG_FILTER_TAG_MAX_LEN)) {
+                rule = &limit->rule[i];
+                break;
+            }
+        } else if (rule == NULL) {
+            rule = &limit->rule[i];
+        }
+    }
+    if (rule) {
+        /* the rule is changed when the checker is reading it, the checker will read it again */
+        seq = __atomic_load_n(&limit->rule_seq, __ATOMIC_RELAXED);
+        __atomic_store_n(&limit->rule_seq, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        rule->use_flag = false;
+        memset(rule->tag, 0, sizeof(rule->tag));
+        if (rate) {
+            strncpy(rule->tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+            rule->level = level;
+            rule->rate = rate;
+            rule->burst = burst;
+            rule->per_callsite = per_callsite;
+            /* the callsite buckets which are using the old rule will be reset */
+            rule->id = seq + 2;
+            rule->interval = interval;
+            rule->tolerance = tolerance;
+            __atomic_store_n(&rule->bucket.tat, elog_port_get_tick() * TICK_SCALE, __ATOMIC_RELAXED);
+            __atomic_store_n(&rule->bucket.suppressed, 0, __ATOMIC_RELAXED);
+            rule->use_flag = true;
+        }
+        __atomic_store_n(&limit->rule_seq, seq + 2, __ATOMIC_RELEASE);
+    }
+    for (i = 0; i < ELOG_RATE_LIMIT_RULE_MAX_NUM; i++) {
+        if (limit->rule[i].use_flag) {
+            num++;
+        }
+    }
+    __atomic_store_n(&limit->rule_num, num, __ATOMIC_RELEASE);
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * Set the sampling for the level, only 1 in N log will output. It's useful for the high frequency verbose log.
+ *
+ * @param level level
+ * @param n 1 in N log will output, 0 or 1: disable the sampling
+ * @param random true: every log is output with 1/N probability, false: every N-th log is output
+ */
+void elog_set_sampling(uint8_t level, uint32_t n, bool random) {
+    elog_inst_set_sampling(elog_get_default(), level, n, random);
+}
+
+void elog_inst_set_sampling(EasyLogger_t elog, uint8_t level, uint32_t n, bool random) {
+    ElogRateLimit *limit = &elog->limit;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    elog_inst_output_lock(elog);
+    if (limit->sample_seed == 0) {
+        limit->sample_seed = elog_port_get_tick() | 1;
+    }
+    limit->sample_random[level] = random;
+    limit->sample_count[level] = 0;
+    __atomic_store_n(&limit->sample_n[level], n, __ATOMIC_RELEASE);
+    elog_inst_output_unlock(elog);
+}
+
+/**
+ * check the log is sampled, it's lock free
+ *
+ * @return true: the log will be output
+ */
+static bool sample_check(ElogRateLimit *limit, uint8_t level) {
+    uint32_t n = __atomic_load_n(&limit->sample_n[level], __ATOMIC_ACQUIRE), x;
+
+    if (n <= 1) {
+        return true;
+    }
+    if (limit->sample_random[level]) {
+        /* xorshift32, the concurrent update may get the same number, it's harmless for sampling */
+        x = __atomic_load_n(&limit->sample_seed, __ATOMIC_RELAXED);
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        __atomic_store_n(&limit->sample_seed, x, __ATOMIC_RELAXED);
+        return x % n == 0;
+    } else {
+        return __atomic_fetch_add(&limit->sample_count[level], 1, __ATOMIC_RELAXED) % n == 0;
+    }
+}
+
+/**
+ * Find the rule for the tag and level, the rule of the same tag is preferred to the all tags rule.
+ * The rule's parameters are copied to the snapshot, it's discarded when the rules are changed meanwhile.
+ *
+ * @return false: the rules are changing
+ */
+static bool rule_find(ElogRateLimit *limit, uint8_t level, const char *tag, ElogRateLimitRule **found,
+        ElogRateLimitRule *snapshot) {
+    ElogRateLimitRule *all = NULL, *rule = NULL;
+    uint32_t seq = __atomic_load_n(&limit->rule_seq, __ATOMIC_ACQUIRE);
+    uint8_t i;
+
+    if (seq & 1) {
+        return false;
+    }
+    for (i = 0; i < ELOG_RATE_LIMIT_RULE_MAX_NUM && !rule; i++) {
+        if (!limit->rule[i].use_flag || limit->rule[i].level != level) {
+            continue;
+        }
+        if (limit->rule[i].tag[0] == '\0') {
+            all = &limit->rule[i];
+        } else if (!strncmp(limit->rule[i].tag, tag, ELOG_FILTER_TAG_MAX_LEN)) {
+            rule = &limit->rule[i];
+        }
+    }
+    if (!rule) {
+        rule = all;
+    }
+    if (rule) {
+        snapshot->per_callsite = rule->per_callsite;
+        snapshot->id = rule->id;
+        snapshot->interval = rule->interval;
+        snapshot->tolerance = rule->tolerance;
+    }
+    *found = rule;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return seq == __atomic_load_n(&limit->rule_seq, __ATOMIC_RELAXED);
+}
+
+/**
+ * Take a token from bucket. The bucket is full when the theoretical arrival time isn't later than now,
+ * and every token moves it by one interval, the log is suppressed when it's later than the burst tolerance.
+ *
+ * @return true: got the token
+ */
+static bool bucket_take(EasyLogger_t elog, ElogTokenBucket *bucket, const ElogRateLimitRule *rule, uint32_t tick,
+        uint8_t level, const char *tag) {
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE) && defined(ELOG_ASYNC_OUTPUT_USING_PTHREAD)
+    extern void elog_async_wakeup(ElogAsync *async);
+#endif
+    uint32_t now = tick * TICK_SCALE, tat, ahead;
+
+    tat = __atomic_load_n(&bucket->tat, __ATOMIC_RELAXED);
+    do {
+        ahead = tat - now;
+        /* the arrival time is passed, or it's too old after long idle time */
+        if ((int32_t) ahead < 0 || ahead > rule->tolerance + rule->interval) {
+            ahead = 0;
+        }
+        if (ahead > rule->tolerance) {
+            if (__atomic_fetch_add(&bucket->suppressed, 1, __ATOMIC_RELAXED) == 0) {
+                bucket->level = level;
+                strncpy(bucket->tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+                __atomic_store_n(&bucket->report_tick, tick, __ATOMIC_RELEASE);
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE) && defined(ELOG_ASYNC_OUTPUT_USING_PTHREAD)
+                /* the output thread will report it after the report interval */
+                elog_async_wakeup(&elog->async);
+#endif
+            }
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(&bucket->tat, &tat, now + ahead + rule->interval, true, __ATOMIC_RELAXED,
+            __ATOMIC_RELAXED));
+
+    return true;
+}
+
+/**
+ * check the bucket is full, it's same as the bucket which is reset
+ */
+static bool bucket_is_full(ElogTokenBucket *bucket, const ElogRateLimitRule *rule, uint32_t tick) {
+    uint32_t ahead = __atomic_load_n(&bucket->tat, __ATOMIC_RELAXED) - tick * TICK_SCALE;
+
+    return (int32_t) ahead <= 0 || ahead > rule->tolerance + rule->interval;
+}
+
+/**
+ * Find the callsite's token bucket in the adjacent buckets. The bucket of other callsite is only taken
+ * when it's full, so the colliding callsites never get a new burst by evicting each other. The callsite
+ * which has no bucket is using the rule's bucket.
+ *
+ * @param suppressed the evicted callsite's suppressed log number
+ *
+ * @return token bucket
+ */
+static ElogTokenBucket *callsite_find(ElogRateLimit *limit, ElogRateLimitRule *rule,
+        const ElogRateLimitRule *snapshot, uint32_t hash, uint32_t tick, uint32_t *suppressed) {
+    ElogRateLimitCallsite *callsite;
+    uint32_t key = (hash ^ snapshot->id * 2246822519U) | 1, old;
+    uint8_t i;
+
+    for (i = 0; i < CALLSITE_WAYS; i++) {
+        callsite = &limit->callsite[(hash + i) % ELOG_RATE_LIMIT_CALLSITE_MAX_NUM];
+        if (__atomic_load_n(&callsite->key, __ATOMIC_ACQUIRE) == key) {
+            return &callsite->bucket;
+        }
+    }
+    for (i = 0; i < CALLSITE_WAYS; i++) {
+        callsite = &limit->callsite[(hash + i) % ELOG_RATE_LIMIT_CALLSITE_MAX_NUM];
+        old = __atomic_load_n(&callsite->key, __ATOMIC_ACQUIRE);
+        if ((old == 0 || bucket_is_full(&callsite->bucket, snapshot, tick)) && __atomic_compare_exchange_n(
+                &callsite->key, &old, key, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            /* the evicted callsite's suppressed log number will be reported now */
+            if (old) {
+                *suppressed = __atomic_exchange_n(&callsite->bucket.suppressed, 0, __ATOMIC_RELAXED);
+            }
+            return &callsite->bucket;
+        }
+    }
+
+    return &rule->bucket;
+}
+
+/**
+ * Check the log by sampling and rate limit. It's called before the log is formatted, and it's lock free.
+ *
+ * @param elog EasyLogger object
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param suppressed the suppressed log number which should be reported now, 0: no report
+ *
+ * @return true: the log will be output
+ */
+bool elog_limit_check(EasyLogger_t elog, uint8_t level, const char *tag, const char *file, const char *func,
+        long line, uint32_t *suppressed) {
+    ElogRateLimit *limit = &elog->limit;
+    ElogRateLimitRule *rule, snapshot;
+    ElogTokenBucket *bucket;
+    uint32_t tick, hash;
+    bool result;
+
+    *suppressed = 0;
+    if (!sample_check(limit, level)) {
+        return false;
+    }
+    /* the rate limit is unused */
+    if (__atomic_load_n(&limit->rule_num, __ATOMIC_ACQUIRE) == 0) {
+        return true;
+    }
+    /* the log isn't limited when the rules are changing */
+    if (!rule_find(limit, level, tag, &rule, &snapshot) || !rule) {
+        return true;
+    }
+
+    tick = elog_port_get_tick();
+    if (snapshot.per_callsite) {
+        hash = (uint32_t) ((uintptr_t) file ^ (uintptr_t) func * 31) ^ (uint32_t) line * 2654435761U;
+        bucket = callsite_find(limit, rule, &snapshot, hash, tick, suppressed);
+    } else {
+        bucket = &rule->bucket;
+    }
+    result = bucket_take(elog, bucket, &snapshot, tick, level, tag);
+    if (__atomic_load_n(&bucket->suppressed, __ATOMIC_RELAXED)
+            && tick - __atomic_load_n(&bucket->report_tick, __ATOMIC_RELAXED) >= REPORT_INTERVAL) {
+        *suppressed += __atomic_exchange_n(&bucket->suppressed, 0, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+/**
+ * output the bucket's suppressed log number when the report interval is expired
+ *
+ * @return the time (ms) until the bucket's report interval is expired, 0: no suppressed log
+ */
+static uint32_t bucket_expire(EasyLogger_t elog, ElogTokenBucket *bucket, uint32_t tick) {
+    uint32_t suppressed, elapsed;
+
+    if (__atomic_load_n(&bucket->suppressed, __ATOMIC_RELAXED) == 0) {
+        return 0;
+    }
+    elapsed = tick - __atomic_load_n(&bucket->report_tick, __ATOMIC_ACQUIRE);
+    if (elapsed < REPORT_INTERVAL) {
+        return REPORT_INTERVAL - elapsed;
+    }
+    suppressed = __atomic_exchange_n(&bucket->suppressed, 0, __ATOMIC_RELAXED);
+    if (suppressed) {
+        elog_summary_output(elog, bucket->level, bucket->tag, "suppressed %lu messages", (unsigned long) suppressed);
+    }
+
+    return 0;
+}
+
+/**
+ * output the suppressed log number of all buckets when the report interval is expired, the output lock must be held
+ *
+ * @param elog EasyLogger object
+ *
+ * @return the time (ms) until the next report should be checked, 0: the rate limit is unused
+ */
+uint32_t elog_limit_expire(EasyLogger_t elog) {
+    ElogRateLimit *limit = &elog->limit;
+    uint32_t tick, timeout = REPORT_INTERVAL, remain;
+    size_t i;
+
+    if (__atomic_load_n(&limit->rule_num, __ATOMIC_ACQUIRE) == 0) {
+        return 0;
+    }
+
+    tick = elog_port_get_tick();
+    for (i = 0; i < ELOG_RATE_LIMIT_RULE_MAX_NUM + ELOG_RATE_LIMIT_CALLSITE_MAX_NUM; i++) {
+        if (i < ELOG_RATE_LIMIT_RULE_MAX_NUM) {
+            remain = bucket_expire(elog, &limit->rule[i].bucket, tick);
+        } else {
+            remain = bucket_expire(elog, &limit->callsite[i - ELOG_RATE_LIMIT_RULE_MAX_NUM].bucket, tick);
+        }
+        if (remain && remain < timeout) {
+            timeout = remain;
+        }
+    }
+
+    return timeout;
+}
+
+/**
+ * Output the suppressed log number when the report interval is expired. The asynchronous output thread
+ * calls it periodically. Otherwise it should be called periodically (such as in a timer or the idle task),
+ * or the suppressed log number is output until the same log arrives after the report interval.
+ */
+void elog_rate_limit_poll(void) {
+    elog_inst_rate_limit_poll(elog_get_default());
+}
+
+void elog_inst_rate_limit_poll(EasyLogger_t elog) {
+    elog_inst_output_lock(elog);
+    elog_limit_expire(elog);
+    elog_inst_output_unlock(elog);
+}
+
+#endif /* ELOG_RATE_LIMIT_ENABLE */
@@ -0,0 +1,236 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Logs output sinks. Each sink has its own level, format and asynchronous output queue.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <string.h>
+
+extern void elog_inst_output_lock(EasyLogger_t elog);
+extern void elog_inst_output_unlock(EasyLogger_t elog);
+
+/**
+ * Sink initialize. The sink output all level log with the object's format by default.
+ *
+ * @param sink sink
+ * @param name sink name
+ * @param output sink output interface
+ */
+void elog_sink_init(ElogSink_t sink, const char *name, void (*output)(const char *log, size_t size)) {
+    ELOG_ASSERT(sink);
+    ELOG_ASSERT(output);
+
+    memset(sink, 0, sizeof(ElogSink));
+    sink->name = name;
+    sink->output = output;
+    sink->level = ELOG_LVL_VERBOSE;
+}
+
+/**
+ * set the sink's level, the log which level is less than it will not output to this sink
+ *
+ * @param sink sink
+ * @param level level
+ */
+void elog_sink_set_lvl(ElogSink_t sink, uint8_t level) {
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    sink->level = level;
+}
+
+/**
+ * set the sink's output format, the sink is using the object's format on the level which is not set
+ *
+ * @param sink sink
+ * @param level level
+ * @param set format set
+ */
+void elog_sink_set_fmt(ElogSink_t sink, uint8_t level, size_t set) {
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    sink->fmt_set[level] = set;
+    sink->fmt_set_flag |= 1 << level;
+}
+
+/**
+ * set the sink's text color enable or disable, it's disabled by default.
+ * The text color will output only when the object's text color is also enabled.
+ *
+ * @param sink sink
+ * @param enabled TRUE: enable FALSE: disable
+ */
+void elog_sink_set_text_color_enabled(ElogSink_t sink, bool enabled) {
+#ifdef ELOG_COLOR_ENABLE
+    sink->text_color_enabled = enabled;
+#else
+    (void) sink;
+    (void) enabled;
+#endif
+}
+
+/**
+ * Set the sink's render, it renders the structured log record to line log, such as: JSON.
+ * The sinks which have the same render, format and text color setting will share the rendered log.
+ *
+ * @param sink sink
+ * @param render sink render, NULL: using the default text format
+ */
+void elog_sink_set_render(ElogSink_t sink, size_t (*render)(ElogSink_t sink, const ElogRecord *rec, char *log,
+        size_t size)) {
+    sink->render = render;
+}
+
+/**
+ * Set the sink's asynchronous output ring buffer, it must be set before register.
+ * The sink has its own output thread when using pthread, otherwise the notice will be called
+ * when the new log is put, then the log can be got by elog_sink_async_get_log.
+ *
+ * @param sink sink
+ * @param buf ring buffer, NULL: the sink will output directly
+ * @param size ring buffer size
+ * @param notice output notice, it's unused when using pthread
+ */
+void elog_sink_set_async(ElogSink_t sink, char *buf, size_t size, void (*notice)(void)) {
+    ELOG_ASSERT(!sink->elog);
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    sink->async_buf = buf;
+    sink->async_buf_size = size;
+    sink->async_notice = notice;
+#else
+    (void) buf;
+    (void) size;
+    (void) notice;
+#endif
+}
+
+/**
+ * register the sink to default object
+ *
+ * @param sink sink
+ *
+ * @return result
+ */
+ElogErrCode elog_sink_register(ElogSink_t sink) {
+    return elog_inst_sink_register(elog_get_default(), sink);
+}
+
+/**
+ * unregister the sink from default object
+ *
+ * @param sink sink
+ */
+void elog_sink_unregister(ElogSink_t sink) {
+    elog_inst_sink_unregister(elog_get_default(), sink);
+}
+
+/**
+ * Register the sink to the object, the log will be output to all registered sinks.
+ * It can be registered before the object initialize.
+ *
+ * @param elog EasyLogger object
+ * @param sink sink
+ *
+ * @return result
+ */
+ElogErrCode elog_inst_sink_register(EasyLogger_t elog, ElogSink_t sink) {
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    extern ElogErrCode elog_async_init(ElogAsync *async, EasyLogger_t elog, void (*output)(const char *log, size_t size),
+            char *buf, size_t size, void (*notice)(void));
+#endif
+
+    ElogErrCode result = ELOG_NO_ERR;
+    ElogSink_t *tail;
+
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(sink);
+    ELOG_ASSERT(sink->output);
+    ELOG_ASSERT(!sink->elog);
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    result = elog_async_init(&sink->async, elog, sink->output, sink->async_buf, sink->async_buf_size,
+            sink->async_notice);
+    if (result != ELOG_NO_ERR) {
+        return result;
+    }
+    sink->async.is_enabled = sink->async.init_ok;
+#endif
+
+    sink->elog = elog;
+    sink->next = NULL;
+    /* lock output */
+    elog_inst_output_lock(elog);
+    /* add to the tail */
+    for (tail = &elog->sinks; *tail; tail = &(*tail)->next);
+    *tail = sink;
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+
+    return result;
+}
+
+/**
+ * Unregister the sink from the object.
+ * The remaining log in sink's ring buffer will be output before return when using pthread.
+ *
+ * @param elog EasyLogger object
+ * @param sink sink
+ */
+void elog_inst_sink_unregister(EasyLogger_t elog, ElogSink_t sink) {
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    extern void elog_async_deinit(ElogAsync *async);
+#endif
+
+    ElogSink_t *node;
+    bool found = false;
+
+    ELOG_ASSERT(elog);
+    ELOG_ASSERT(sink);
+
+    /* lock output */
+    elog_inst_output_lock(elog);
+    for (node = &elog->sinks; *node; node = &(*node)->next) {
+        if (*node == sink) {
+            *node = sink->next;
+            found = true;
+            break;
+        }
+    }
+    /* unlock output */
+    elog_inst_output_unlock(elog);
+
+    if (!found) {
+        return;
+    }
+
+#ifdef ELOG_ASYNC_OUTPUT_ENABLE
+    if (sink != &elog->output_sink) {
+        elog_async_deinit(&sink->async);
+    }
+#endif
+    sink->elog = NULL;
+    sink->next = NULL;
+}
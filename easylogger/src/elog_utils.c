@@ -28,6 +28,9 @@
 
 #include <elog.h>
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
 
 /**
  * another copy string function
@@ -101,3 +104,110 @@ void *elog_memcpy(void *dst, const void *src, size_t count) {
 
     return dst;
 }
+
+/**
+ * convert unsigned integer to decimal string
+ *
+ * @param value unsigned integer
+ * @param buf the buffer to save string, its size must be greater than 20
+ *
+ * @return string length
+ */
+static size_t u64_to_str(uint64_t value, char *buf) {
+    char tmp[20];
+    size_t len = 0, i;
+
+    do {
+        tmp[len++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value);
+    for (i = 0; i < len; i++) {
+        buf[i] = tmp[len - 1 - i];
+    }
+
+    return len;
+}
+
+/**
+ * convert the typed value of key/value pair to string, the string type isn't supported.
+ * Infinite and NaN double will be converted to "inf", "-inf" and "nan".
+ *
+ * @param kv key/value pair
+ * @param buf the buffer to save string, the string isn't end with '\0'
+ * @param size buffer size
+ *
+ * @return string length, it will be 0 when buffer has no enough space
+ */
+size_t elog_kv_value_to_str(const ElogKv *kv, char *buf, size_t size) {
+    char tmp[32];
+    size_t len = 0;
+    int result, precision;
+
+    assert(kv);
+    assert(buf);
+
+    switch (kv->type) {
+    case ELOG_KV_I64:
+        if (kv->value.i64 < 0) {
+            tmp[len++] = '-';
+            len += u64_to_str(0 - (uint64_t) kv->value.i64, tmp + len);
+        } else {
+            len = u64_to_str((uint64_t) kv->value.i64, tmp);
+        }
+        break;
+    case ELOG_KV_U64:
+        len = u64_to_str(kv->value.u64, tmp);
+        break;
+    case ELOG_KV_F64:
+        /* using the shortest precision which can be parsed back to the same value */
+        for (precision = 15; precision <= 17; precision++) {
+            result = snprintf(tmp, sizeof(tmp), "%.*g", precision, kv->value.f64);
+            if (result <= 0 || strtod(tmp, NULL) == kv->value.f64 || kv->value.f64 != kv->value.f64) {
+                break;
+            }
+        }
+        len = result > 0 ? (size_t) result : 0;
+        break;
+    case ELOG_KV_BOOL:
+        len = kv->value.b ? 4 : 5;
+        memcpy(tmp, kv->value.b ? "true" : "false", len);
+        break;
+    default:
+        break;
+    }
+
+    if (len > size) {
+        return 0;
+    }
+    memcpy(buf, tmp, len);
+
+    return len;
+}
+
+/**
+ * Parse the level from string, it can be the first letter (A/E/W/I/D/V),
+ * full name (assert, error, warn, info, debug, verbose) or number. The letter case is ignored.
+ *
+ * @param str level string
+ *
+ * @return level, -1: invalid level
+ */
+int8_t elog_lvl_from_str(const char *str) {
+    static const char *name[] = { "assert", "error", "warn", "info", "debug", "verbose" };
+    size_t i, j;
+
+    assert(str);
+
+    for (i = 0; i < ELOG_LVL_TOTAL_NUM; i++) {
+        if (str[0] && !str[1] && (toupper((unsigned char) str[0]) == toupper((unsigned char) name[i][0])
+                || str[0] == '0' + (char) i)) {
+            return (int8_t) i;
+        }
+        for (j = 0; name[i][j] && tolower((unsigned char) str[j]) == name[i][j]; j++);
+        if (name[i][j] == '\0' && str[j] == '\0') {
+            return (int8_t) i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Minimal check macros for the unit tests, the failed check is reported and the test goes on.
+ * Created on: 2026-10-19
+ */
+
+#ifndef __ELOG_TEST_H__
+#define __ELOG_TEST_H__
+
+#include <stdio.h>
+#include <string.h>
+
+/* failed check number, the test's exit code is non-zero when it's not 0 */
+static int elog_test_failed = 0;
+
+#define ELOG_TEST_CHECK(expr)                                                              \
+    do {                                                                                   \
+        if (!(expr)) {                                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr);       \
+            elog_test_failed++;                                                            \
+        }                                                                                  \
+    } while (0)
+
+/* check the buffer with size is same as the expected string */
+#define ELOG_TEST_CHECK_STRN(buf, size, expected)                                          \
+    do {                                                                                   \
+        const char *elog_test_exp_ = (expected);                                           \
+        size_t elog_test_size_ = (size);                                                   \
+        if (elog_test_size_ != strlen(elog_test_exp_)                                      \
+                || memcmp((buf), elog_test_exp_, elog_test_size_)) {                       \
+            fprintf(stderr, "%s:%d: check failed:\n  actual  : %.*s\n  expected: %s\n",    \
+                    __FILE__, __LINE__, (int) elog_test_size_, (const char *) (buf),       \
+                    elog_test_exp_);                                                       \
+            elog_test_failed++;                                                            \
+        }                                                                                  \
+    } while (0)
+
+#define ELOG_TEST_CHECK_STR(str, expected)                                                 \
+    do {                                                                                   \
+        const char *elog_test_str_ = (str);                                                \
+        ELOG_TEST_CHECK(elog_test_str_ != NULL);                                           \
+        if (elog_test_str_) {                                                              \
+            ELOG_TEST_CHECK_STRN(elog_test_str_, strlen(elog_test_str_), expected);        \
+        }                                                                                  \
+    } while (0)
+
+#define ELOG_TEST_RESULT()       (elog_test_failed ? (fprintf(stderr, "%d check(s) failed\n", elog_test_failed), 1) : 0)
+
+#endif /* __ELOG_TEST_H__ */
@@ -0,0 +1,179 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Binary record encoder test. The rendered record is decoded back to the same record.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include "elog_test.h"
+
+static ElogSink sink;
+
+static void sink_output(const char *log, size_t size) {
+    (void) log;
+    (void) size;
+}
+
+static void set_sink_fmt(size_t fmt) {
+    uint8_t level;
+
+    for (level = 0; level < ELOG_LVL_TOTAL_NUM; level++) {
+        elog_sink_set_fmt(&sink, level, fmt);
+    }
+}
+
+static void record_init(ElogRecord *rec, const char *msg, const ElogKv *kv, size_t kv_num) {
+    memset(rec, 0, sizeof(ElogRecord));
+    rec->level = ELOG_LVL_INFO;
+    rec->tag = "net";
+    rec->file = "src/net.c";
+    rec->func = "net_recv";
+    rec->line = 42;
+    rec->time = "10:00:00.000";
+    rec->p_info = "pid:1";
+    rec->t_info = "tid:2";
+    rec->msg = msg;
+    rec->msg_len = strlen(msg);
+    rec->kv = kv;
+    rec->kv_num = kv_num;
+}
+
+static void check_record_equal(const ElogRecord *actual, const ElogRecord *expected) {
+    size_t i;
+
+    ELOG_TEST_CHECK(actual->level == expected->level);
+    ELOG_TEST_CHECK_STR(actual->tag, expected->tag);
+    ELOG_TEST_CHECK_STR(actual->file, expected->file);
+    ELOG_TEST_CHECK_STR(actual->func, expected->func);
+    ELOG_TEST_CHECK(actual->line == expected->line);
+    ELOG_TEST_CHECK_STR(actual->time, expected->time);
+    ELOG_TEST_CHECK_STR(actual->p_info, expected->p_info);
+    ELOG_TEST_CHECK_STR(actual->t_info, expected->t_info);
+    ELOG_TEST_CHECK(actual->msg_len == expected->msg_len);
+    ELOG_TEST_CHECK(!memcmp(actual->msg, expected->msg, expected->msg_len));
+    ELOG_TEST_CHECK(actual->kv_num == expected->kv_num);
+    for (i = 0; i < actual->kv_num && i < expected->kv_num; i++) {
+        ELOG_TEST_CHECK_STR(actual->kv[i].key, expected->kv[i].key);
+        ELOG_TEST_CHECK(actual->kv[i].type == expected->kv[i].type);
+        switch (expected->kv[i].type) {
+        case ELOG_KV_STR:
+            ELOG_TEST_CHECK_STR(actual->kv[i].value.str, expected->kv[i].value.str);
+            break;
+        case ELOG_KV_I64:
+            ELOG_TEST_CHECK(actual->kv[i].value.i64 == expected->kv[i].value.i64);
+            break;
+        case ELOG_KV_U64:
+            ELOG_TEST_CHECK(actual->kv[i].value.u64 == expected->kv[i].value.u64);
+            break;
+        case ELOG_KV_F64:
+            ELOG_TEST_CHECK(!memcmp(&actual->kv[i].value.f64, &expected->kv[i].value.f64, sizeof(double)));
+            break;
+        case ELOG_KV_BOOL:
+            ELOG_TEST_CHECK(actual->kv[i].value.b == expected->kv[i].value.b);
+            break;
+        }
+    }
+}
+
+static void test_binary(void) {
+    const ElogKv kv[] = {
+        ELOG_STR("path", "/var/log"),
+        ELOG_I64("min", INT64_MIN),
+        ELOG_I64("neg", -300),
+        ELOG_U64("max", UINT64_MAX),
+        ELOG_F64("pi", 3.141592653589793),
+        ELOG_BOOL("ok", true),
+    };
+    char log[512], msg[300];
+    ElogRecord rec, decoded;
+    ElogKv decoded_kv[8];
+    size_t len, len2;
+
+    /* round trip with all fields */
+    set_sink_fmt(ELOG_FMT_ALL);
+    record_init(&rec, "binary \"record\"\n", kv, sizeof(kv) / sizeof(kv[0]));
+    rec.level = ELOG_LVL_VERBOSE;
+    rec.line = 300000;
+    len = elog_binary_render(&sink, &rec, log, sizeof(log));
+    ELOG_TEST_CHECK(len > 0);
+    ELOG_TEST_CHECK(elog_binary_decode(log, len, &decoded, decoded_kv, 8) == len);
+    check_record_equal(&decoded, &rec);
+
+    /* the fields which are not in format are empty */
+    set_sink_fmt(ELOG_FMT_LVL | ELOG_FMT_TAG);
+    record_init(&rec, "short", NULL, 0);
+    len2 = elog_binary_render(&sink, &rec, log + len, sizeof(log) - len);
+    ELOG_TEST_CHECK(len2 > 0);
+    /* the records are decoded one by one from the stream */
+    ELOG_TEST_CHECK(elog_binary_decode(log, len + len2, &decoded, decoded_kv, 8) == len);
+    ELOG_TEST_CHECK(elog_binary_decode(log + len, len2, &decoded, decoded_kv, 8) == len2);
+    ELOG_TEST_CHECK(decoded.file == NULL && decoded.func == NULL && decoded.line == 0);
+    ELOG_TEST_CHECK_STR(decoded.time, "");
+    ELOG_TEST_CHECK_STRN(decoded.msg, decoded.msg_len, "short");
+
+    /* the decoded key/value pairs are limited by the buffer */
+    set_sink_fmt(ELOG_FMT_ALL);
+    record_init(&rec, "kv", kv, sizeof(kv) / sizeof(kv[0]));
+    len = elog_binary_render(&sink, &rec, log, sizeof(log));
+    ELOG_TEST_CHECK(elog_binary_decode(log, len, &decoded, decoded_kv, 2) == len);
+    ELOG_TEST_CHECK(decoded.kv_num == 2);
+    ELOG_TEST_CHECK_STR(decoded_kv[1].key, "min");
+
+    /* the message is truncated and the pairs which have no space are dropped */
+    memset(msg, 'm', sizeof(msg) - 1);
+    msg[sizeof(msg) - 1] = '\0';
+    set_sink_fmt(ELOG_FMT_LVL | ELOG_FMT_TAG);
+    record_init(&rec, msg, kv, sizeof(kv) / sizeof(kv[0]));
+    len = elog_binary_render(&sink, &rec, log, 40);
+    ELOG_TEST_CHECK(len == 40);
+    ELOG_TEST_CHECK(elog_binary_decode(log, len, &decoded, decoded_kv, 8) == len);
+    ELOG_TEST_CHECK(decoded.msg_len > 0 && decoded.msg_len < rec.msg_len);
+    ELOG_TEST_CHECK(!memcmp(decoded.msg, msg, decoded.msg_len));
+    ELOG_TEST_CHECK(decoded.kv_num < rec.kv_num);
+
+    /* the incomplete or broken record is rejected */
+    ELOG_TEST_CHECK(elog_binary_decode(log, len - 1, &decoded, decoded_kv, 8) == 0);
+    ELOG_TEST_CHECK(elog_binary_decode(log, 4, &decoded, decoded_kv, 8) == 0);
+    log[0] ^= 0xFF;
+    ELOG_TEST_CHECK(elog_binary_decode(log, len, &decoded, decoded_kv, 8) == 0);
+    log[0] ^= 0xFF;
+    log[3] = ELOG_LVL_VERBOSE + 1;
+    ELOG_TEST_CHECK(elog_binary_decode(log, len, &decoded, decoded_kv, 8) == 0);
+
+    /* the buffer can't hold the header */
+    ELOG_TEST_CHECK(elog_binary_render(&sink, &rec, log, 4) == 0);
+}
+
+int main(void) {
+    elog_init();
+    elog_sink_init(&sink, "test", sink_output);
+    elog_sink_register(&sink);
+
+    test_binary();
+
+    elog_deinit();
+
+    return ELOG_TEST_RESULT();
+}
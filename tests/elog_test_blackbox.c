@@ -0,0 +1,160 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Black box extraction test. The synthetic image is made of the header, ring buffer and
+ *           buffered output mode buffer, and it's placed after the other data like the core dump.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include "elog_test.h"
+
+/* the header is placed after this prefix in image */
+#define IMAGE_PREFIX_SIZE              12
+#define RING_SIZE                      64
+#define BUF_SIZE                       32
+
+static char extracted[512];
+static size_t extracted_len;
+
+static void extract_output(const char *log, size_t size) {
+    if (extracted_len + size <= sizeof(extracted)) {
+        memcpy(extracted + extracted_len, log, size);
+    }
+    extracted_len += size;
+}
+
+static size_t extract(const char *image, size_t size) {
+    extracted_len = 0;
+
+    return elog_blackbox_extract(image, size, extract_output);
+}
+
+/**
+ * make the image, the ring buffer is filled with the text from the beginning
+ *
+ * @return image size
+ */
+static size_t image_init(char *image, ElogBlackbox **bb, char **ring, char **buf) {
+    size_t size = IMAGE_PREFIX_SIZE + sizeof(ElogBlackbox) + RING_SIZE + BUF_SIZE;
+
+    memset(image, 'z', size);
+    *bb = (ElogBlackbox *) (image + IMAGE_PREFIX_SIZE);
+    memset(*bb, 0, sizeof(ElogBlackbox));
+    (*bb)->magic = ELOG_BLACKBOX_MAGIC;
+    (*bb)->version = ELOG_BLACKBOX_VERSION;
+    (*bb)->async_offset = sizeof(ElogBlackbox);
+    (*bb)->async_size = RING_SIZE;
+    (*bb)->buf_offset = sizeof(ElogBlackbox) + RING_SIZE;
+    (*bb)->buf_size = BUF_SIZE;
+    *ring = (char *) *bb + (*bb)->async_offset;
+    *buf = (char *) *bb + (*bb)->buf_offset;
+    /* 8 lines, 8 bytes for every line */
+    memcpy(*ring, "line 00\nline 01\nline 02\nline 03\nline 04\nline 05\nline 06\nline 07\n", RING_SIZE);
+
+    return size;
+}
+
+static void test_extract(void) {
+    uint32_t aligned[(IMAGE_PREFIX_SIZE + sizeof(ElogBlackbox) + RING_SIZE + BUF_SIZE) / sizeof(uint32_t) + 1];
+    char *image = (char *) aligned, *ring, *buf;
+    ElogBlackbox *bb;
+    size_t size;
+
+    /* the unflushed log is before the write index */
+    size = image_init(image, &bb, &ring, &buf);
+    bb->async_write = 24;
+    bb->async_unflushed = 16;
+    ELOG_TEST_CHECK(extract(image, size) == 16);
+    ELOG_TEST_CHECK_STRN(extracted, extracted_len, "line 01\nline 02\n");
+
+    /* the buffered output mode buffer is output before the ring buffer */
+    memcpy(buf, "buffered\n", 9);
+    bb->buf_used = 9;
+    ELOG_TEST_CHECK(extract(image, size) == 25);
+    ELOG_TEST_CHECK_STRN(extracted, extracted_len, "buffered\nline 01\nline 02\n");
+    bb->buf_used = 0;
+
+    /* the unflushed log is wrapped */
+    bb->async_write = 16;
+    bb->async_unflushed = 32;
+    ELOG_TEST_CHECK(extract(image, size) == 32);
+    ELOG_TEST_CHECK_STRN(extracted, extracted_len, "line 06\nline 07\nline 00\nline 01\n");
+
+    /* the oldest log is overwritten, its remaining part is skipped */
+    bb->async_write = 20;
+    bb->async_unflushed = RING_SIZE + 100;
+    ELOG_TEST_CHECK(extract(image, size) == RING_SIZE - 4);
+    ELOG_TEST_CHECK_STRN(extracted, extracted_len,
+            "line 03\nline 04\nline 05\nline 06\nline 07\nline 00\nline 01\nline");
+
+    /* nothing is unflushed */
+    bb->async_unflushed = 0;
+    ELOG_TEST_CHECK(extract(image, size) == 0);
+    ELOG_TEST_CHECK(extracted_len == 0);
+}
+
+static void test_invalid(void) {
+    uint32_t aligned[(IMAGE_PREFIX_SIZE + sizeof(ElogBlackbox) + RING_SIZE + BUF_SIZE) / sizeof(uint32_t) + 1];
+    char *image = (char *) aligned, *ring, *buf;
+    ElogBlackbox *bb;
+    size_t size;
+
+    size = image_init(image, &bb, &ring, &buf);
+    bb->async_write = 8;
+    bb->async_unflushed = 8;
+    ELOG_TEST_CHECK(extract(image, size) == 8);
+
+    /* the image is truncated before the buffers */
+    ELOG_TEST_CHECK(extract(image, IMAGE_PREFIX_SIZE + sizeof(ElogBlackbox)) == 0);
+    ELOG_TEST_CHECK(extract(image, IMAGE_PREFIX_SIZE) == 0);
+
+    bb->version = ELOG_BLACKBOX_VERSION + 1;
+    ELOG_TEST_CHECK(extract(image, size) == 0);
+    bb->version = ELOG_BLACKBOX_VERSION;
+
+    bb->magic = (uint32_t) ~ELOG_BLACKBOX_MAGIC;
+    ELOG_TEST_CHECK(extract(image, size) == 0);
+    bb->magic = ELOG_BLACKBOX_MAGIC;
+
+    bb->async_write = RING_SIZE;
+    ELOG_TEST_CHECK(extract(image, size) == 0);
+    bb->async_write = 8;
+
+    bb->async_offset = 4;
+    ELOG_TEST_CHECK(extract(image, size) == 0);
+    bb->async_offset = sizeof(ElogBlackbox);
+
+    bb->buf_used = BUF_SIZE + 1;
+    ELOG_TEST_CHECK(extract(image, size) == 0);
+
+    ELOG_TEST_CHECK(extracted_len == 0);
+}
+
+int main(void) {
+    test_extract();
+    test_invalid();
+
+    return ELOG_TEST_RESULT();
+}
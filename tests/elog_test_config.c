@@ -0,0 +1,179 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Configuration file test. The valid file is applied, and the file which has any error
+ *           is rejected without changing the settings.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+static ElogSink sink;
+static char path[] = "/tmp/elog_test_config.XXXXXX";
+
+static void sink_output(const char *log, size_t size) {
+    (void) log;
+    (void) size;
+}
+
+/**
+ * write the configuration file then load it
+ */
+static bool load(const char *content) {
+    FILE *fp = fopen(path, "w");
+
+    if (fp == NULL) {
+        return false;
+    }
+    fputs(content, fp);
+    fclose(fp);
+
+    return elog_inst_config_load(elog_get_default(), path);
+}
+
+static void check_applied(void) {
+    ElogFilter filter;
+
+    elog_get_filter(&filter);
+    ELOG_TEST_CHECK(filter.level == ELOG_LVL_WARN);
+    ELOG_TEST_CHECK_STR(filter.tag, "net");
+    ELOG_TEST_CHECK_STR(filter.keyword, "timeout");
+    ELOG_TEST_CHECK(elog_get_filter_tag_lvl("can.disp") == ELOG_LVL_ERROR);
+    ELOG_TEST_CHECK(elog_get_filter_tag_lvl("wifi") == ELOG_LVL_INFO);
+    ELOG_TEST_CHECK(elog_get_filter_tag_lvl("other") == ELOG_FILTER_LVL_ALL);
+    ELOG_TEST_CHECK(sink.level == ELOG_LVL_INFO);
+    ELOG_TEST_CHECK(elog_sink_get_fmt(&sink, ELOG_LVL_WARN) == ELOG_FMT_ALL);
+    /* the sink which has no format setting is using the object's format */
+    ELOG_TEST_CHECK(elog_sink_get_fmt(&sink, ELOG_LVL_INFO) == (ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME));
+}
+
+static void test_accept(void) {
+    ElogFilter filter;
+
+    ELOG_TEST_CHECK(load(
+            "# comment line\n"
+            "\n"
+            "level = W\n"
+            "tag = net\n"
+            "keyword = timeout\n"
+            "  tag_level.can.disp = error  \n"
+            "tag_level.wifi = 3\n"
+            "fmt.I = lvl | tag|time\n"
+            "sink.test.level = I\n"
+            "sink.test.fmt.W = all\n"));
+    check_applied();
+
+    /* the filter is replaced as a whole, the other settings are kept */
+    ELOG_TEST_CHECK(load("level = D\n"));
+    elog_get_filter(&filter);
+    ELOG_TEST_CHECK(filter.level == ELOG_LVL_DEBUG);
+    ELOG_TEST_CHECK_STR(filter.tag, "");
+    ELOG_TEST_CHECK_STR(filter.keyword, "");
+    ELOG_TEST_CHECK(elog_get_filter_tag_lvl("can.disp") == ELOG_FILTER_LVL_ALL);
+    ELOG_TEST_CHECK(sink.level == ELOG_LVL_INFO);
+    ELOG_TEST_CHECK(elog_sink_get_fmt(&sink, ELOG_LVL_WARN) == ELOG_FMT_ALL);
+
+    /* the unknown sink is ignored */
+    ELOG_TEST_CHECK(load("sink.none.level = E\nfmt.E = none\n"));
+    ELOG_TEST_CHECK(elog_sink_get_fmt(&sink, ELOG_LVL_ERROR) == 0);
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    ELOG_TEST_CHECK(load("rate_limit.W.net = 10/20 callsite\nsampling.V = 100 random\n"));
+#endif
+}
+
+static void test_reject(void) {
+    static const char *invalid[] = {
+        "level W\n",
+        "unknown = 1\n",
+        "level = X\n",
+        "tag_level.net = bad\n",
+        "fmt.I = lvl|bogus\n",
+        "fmt.Z = lvl\n",
+        "sink.level = I\n",
+        "sink.test.color = on\n",
+        "sink.test.fmt.W = lvl|tagg\n",
+        "sink.0123456789012345678901234567890123456789.level = I\n",
+#ifdef ELOG_RATE_LIMIT_ENABLE
+        "rate_limit.W.net = 10/20 all\n",
+        "sampling.V = 100 always\n",
+#else
+        "rate_limit.W.net = 10/20\n",
+        "sampling.V = 100\n",
+#endif
+    };
+    char content[512];
+    size_t i;
+    int len;
+
+    for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        ELOG_TEST_CHECK(load(
+                "level = W\ntag = net\nkeyword = timeout\ntag_level.can.disp = E\ntag_level.wifi = I\n"
+                "fmt.I = lvl|tag|time\nsink.test.level = I\nsink.test.fmt.W = all\n"));
+        /* the error is after the valid lines, nothing is applied */
+        snprintf(content, sizeof(content), "level = V\ntag = other\nfmt.I = none\nsink.test.level = V\n%s",
+                invalid[i]);
+        if (load(content)) {
+            fprintf(stderr, "the invalid line is accepted: %s", invalid[i]);
+            elog_test_failed++;
+        }
+        check_applied();
+    }
+
+    /* too many tag levels */
+    for (i = 0, len = 0; i <= ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        len += snprintf(content + len, sizeof(content) - len, "tag_level.t%lu = E\n", (unsigned long) i);
+    }
+    ELOG_TEST_CHECK(!load(content));
+    check_applied();
+
+    /* the file can't be opened */
+    ELOG_TEST_CHECK(!elog_inst_config_load(elog_get_default(), "/nonexistent/elog.conf"));
+    check_applied();
+}
+
+int main(void) {
+    int fd = mkstemp(path);
+
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+
+    elog_init();
+    elog_sink_init(&sink, "test", sink_output);
+    elog_sink_register(&sink);
+
+    test_accept();
+    test_reject();
+
+    elog_deinit();
+    unlink(path);
+
+    return ELOG_TEST_RESULT();
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Local control server test. The command is sent on the temporary socket, then the reply
+ *           and the changed filter are checked.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "elog_test.h"
+
+static char path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+
+/**
+ * send one command line and receive the whole reply until the connection is closed
+ *
+ * @return reply length, -1: connect failed
+ */
+static int request(const char *cmd, char *reply, size_t size) {
+    struct sockaddr_un addr;
+    int fd, len = 0, n;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        return -1;
+    }
+    if (connect(fd, (const struct sockaddr *) &addr, sizeof(addr)) < 0
+            || write(fd, cmd, strlen(cmd)) != (ssize_t) strlen(cmd)) {
+        close(fd);
+        return -1;
+    }
+    while ((size_t) len < size - 1 && (n = read(fd, reply + len, size - 1 - len)) > 0) {
+        len += n;
+    }
+    reply[len] = '\0';
+    close(fd);
+
+    return len;
+}
+
+static bool cmd_echo(EasyLogger_t elog, char *arg) {
+    (void) elog;
+
+    elog_ctl_reply("echo: %s", arg);
+
+    return strcmp(arg, "fail") != 0;
+}
+
+static void test_filter(void) {
+    char reply[1024];
+    ElogFilter filter;
+
+    ELOG_TEST_CHECK(request("level W\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "ok\n");
+    ELOG_TEST_CHECK(request("tag net\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "ok\n");
+    ELOG_TEST_CHECK(request("keyword timeout\r\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "ok\n");
+    ELOG_TEST_CHECK(request("tag_level can.disp E\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "ok\n");
+
+    elog_get_filter(&filter);
+    ELOG_TEST_CHECK(filter.level == ELOG_LVL_WARN);
+    ELOG_TEST_CHECK_STR(filter.tag, "net");
+    ELOG_TEST_CHECK_STR(filter.keyword, "timeout");
+    ELOG_TEST_CHECK(elog_get_filter_tag_lvl("can.disp") == ELOG_LVL_ERROR);
+
+    ELOG_TEST_CHECK(request("filter\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "level    : W\ntag      : net\nkeyword  : timeout\ntag_level: can.disp E\nok\n");
+
+    /* remove the tag level */
+    ELOG_TEST_CHECK(request("tag_level can.disp V\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "ok\n");
+    ELOG_TEST_CHECK(elog_get_filter_tag_lvl("can.disp") == ELOG_FILTER_LVL_ALL);
+
+    /* the invalid command doesn't change the filter */
+    ELOG_TEST_CHECK(request("level X\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "invalid level 'X'\nerror\n");
+    ELOG_TEST_CHECK(request("tag_level can.disp\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "usage: tag_level <tag> <lvl>\nerror\n");
+    ELOG_TEST_CHECK(request("bogus\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "unknown command 'bogus', try 'help'\nerror\n");
+    elog_get_filter(&filter);
+    ELOG_TEST_CHECK(filter.level == ELOG_LVL_WARN);
+}
+
+static void test_user_cmd(void) {
+    char reply[2048];
+
+    ELOG_TEST_CHECK(elog_ctl_cmd_register("echo", "old help", cmd_echo));
+    /* the same name command is replaced */
+    ELOG_TEST_CHECK(elog_ctl_cmd_register("echo", "<text>: echo the text", cmd_echo));
+
+    ELOG_TEST_CHECK(request("echo hello world\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "echo: hello world\nok\n");
+    ELOG_TEST_CHECK(request("echo fail\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK_STR(reply, "echo: fail\nerror\n");
+
+    ELOG_TEST_CHECK(request("help\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK(strstr(reply, "stats") != NULL);
+    ELOG_TEST_CHECK(strstr(reply, "<text>: echo the text") != NULL);
+    ELOG_TEST_CHECK(strstr(reply, "old help") == NULL);
+    ELOG_TEST_CHECK(request("stats\n", reply, sizeof(reply)) >= 0);
+    ELOG_TEST_CHECK(strstr(reply, "filtered: ") != NULL);
+    ELOG_TEST_CHECK(strlen(reply) >= 3 && !strcmp(reply + strlen(reply) - 3, "ok\n"));
+}
+
+int main(void) {
+    struct stat st;
+
+    snprintf(path, sizeof(path), "/tmp/elog_test_ctl.%ld.sock", (long) getpid());
+
+    elog_init();
+    umask(S_IWGRP | S_IWOTH);
+    if (!elog_ctl_start(path)) {
+        fprintf(stderr, "control server start failed on %s\n", path);
+        return 1;
+    }
+    /* the socket is only accessible by owner, and the process's umask isn't changed */
+    ELOG_TEST_CHECK(stat(path, &st) == 0 && (st.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO)) == S_IRWXU);
+    ELOG_TEST_CHECK(umask(S_IWGRP | S_IWOTH) == (S_IWGRP | S_IWOTH));
+    /* the socket is in use */
+    ELOG_TEST_CHECK(!elog_ctl_start(path));
+
+    test_filter();
+    test_user_cmd();
+
+    elog_ctl_stop();
+    ELOG_TEST_CHECK(access(path, F_OK) != 0);
+    elog_deinit();
+
+    return ELOG_TEST_RESULT();
+}
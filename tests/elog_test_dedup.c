@@ -0,0 +1,164 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Duplicate log suppression test. The repeated log is collapsed in the window, and the
+ *           repeated number is output before the different log or after the window is expired.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+#define WINDOW    200
+
+static ElogSink sink;
+/* the repeated number may be output by the asynchronous output thread */
+static pthread_mutex_t sink_lock = PTHREAD_MUTEX_INITIALIZER;
+static char sink_log[4096];
+static size_t sink_len = 0;
+
+static void sink_output(const char *log, size_t size) {
+    pthread_mutex_lock(&sink_lock);
+    if (sink_len + size < sizeof(sink_log)) {
+        memcpy(sink_log + sink_len, log, size);
+        sink_len += size;
+        sink_log[sink_len] = '\0';
+    }
+    pthread_mutex_unlock(&sink_lock);
+}
+
+static void sink_clear(void) {
+    pthread_mutex_lock(&sink_lock);
+    sink_len = 0;
+    sink_log[0] = '\0';
+    pthread_mutex_unlock(&sink_lock);
+}
+
+/* count the output log which contains the string */
+static size_t sink_count(const char *str) {
+    const char *p;
+    size_t num = 0;
+
+    pthread_mutex_lock(&sink_lock);
+    for (p = sink_log; (p = strstr(p, str)) != NULL; p += strlen(str)) {
+        num++;
+    }
+    pthread_mutex_unlock(&sink_lock);
+
+    return num;
+}
+
+/* the position of the string in output log, -1: not found */
+static long sink_find(const char *str) {
+    const char *p;
+
+    pthread_mutex_lock(&sink_lock);
+    p = strstr(sink_log, str);
+    pthread_mutex_unlock(&sink_lock);
+
+    return p ? p - sink_log : -1;
+}
+
+static void test_msg(void) {
+    int i;
+
+    sink_clear();
+    elog_set_dedup(ELOG_DEDUP_MSG, WINDOW);
+    for (i = 0; i < 5; i++) {
+        elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, __LINE__, "same message");
+    }
+    ELOG_TEST_CHECK(sink_count("same message") == 1);
+    ELOG_TEST_CHECK(sink_count("repeated") == 0);
+    /* the repeated number is output before the different log */
+    elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, __LINE__, "other message");
+    ELOG_TEST_CHECK(sink_count("last message repeated 4 times") == 1);
+    ELOG_TEST_CHECK(sink_find("last message repeated 4 times") < sink_find("other message"));
+    /* the message which has different level isn't duplicate */
+    elog_output(ELOG_LVL_ERROR, "dedup", __FILE__, __func__, __LINE__, "other message");
+    ELOG_TEST_CHECK(sink_count("other message") == 2);
+}
+
+static void test_window(void) {
+    int i;
+
+    sink_clear();
+    elog_set_dedup(ELOG_DEDUP_MSG, WINDOW);
+    for (i = 0; i < 3; i++) {
+        elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, __LINE__, "window message");
+    }
+    elog_dedup_poll();
+    ELOG_TEST_CHECK(sink_count("repeated") == 0);
+    /* the repeated number is output after the window is expired without new log */
+    usleep((WINDOW + 100) * 1000);
+    elog_dedup_poll();
+    ELOG_TEST_CHECK(sink_count("last message repeated 2 times") == 1);
+    /* the same log is output as a new one after the window */
+    elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, __LINE__, "window message");
+    ELOG_TEST_CHECK(sink_count("window message") == 2);
+}
+
+static void test_callsite(void) {
+    int i;
+
+    sink_clear();
+    elog_set_dedup(ELOG_DEDUP_CALLSITE, 0);
+    /* the different message of same callsite is duplicate */
+    for (i = 0; i < 3; i++) {
+        elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, 100, "callsite message %d", i);
+    }
+    elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, 101, "callsite message %d", i);
+    ELOG_TEST_CHECK(sink_count("callsite message 0") == 1);
+    ELOG_TEST_CHECK(sink_count("last message repeated 2 times") == 1);
+    ELOG_TEST_CHECK(sink_count("callsite message 3") == 1);
+
+    /* the repeated number is output when the suppression is disabled */
+    sink_clear();
+    elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, 101, "callsite message");
+    elog_set_dedup(ELOG_DEDUP_NONE, 0);
+    ELOG_TEST_CHECK(sink_count("last message repeated 1 times") == 1);
+    for (i = 0; i < 3; i++) {
+        elog_output(ELOG_LVL_WARN, "dedup", __FILE__, __func__, 101, "callsite message");
+    }
+    ELOG_TEST_CHECK(sink_count("callsite message") == 3);
+}
+
+int main(void) {
+    elog_init();
+    elog_set_fmt(ELOG_LVL_ERROR, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    elog_sink_init(&sink, "dedup", sink_output);
+    elog_sink_register(&sink);
+    elog_start();
+
+    test_msg();
+    test_window();
+    test_callsite();
+
+    elog_sink_unregister(&sink);
+    elog_deinit();
+
+    return ELOG_TEST_RESULT();
+}
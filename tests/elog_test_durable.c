@@ -0,0 +1,127 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: File plugin durability ticket test. The ticket which is got after log_x covers the log
+ *           which is queued in the slow asynchronous file sink, and it's synced by the group commit.
+ * Created on: 2026-10-19
+ */
+
+#define LOG_TAG    "durable"
+
+#include <elog.h>
+#include <elog_file.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+#define LOG_NUM    20
+
+static ElogSink sink;
+static char sink_buf[4096];
+static char path[] = "/tmp/elog_test_durable.XXXXXX";
+/* they are written by sink thread, and read after the sink is flushed */
+static size_t sink_written = 0;
+static size_t sink_lines = 0;
+
+static void sink_output(const char *log, size_t size) {
+    size_t i;
+
+    /* the slow output keeps the log in ring buffer */
+    usleep(2000);
+    elog_file_write(log, size);
+    for (i = 0; i < size; i++) {
+        if (log[i] == '\n') {
+            sink_lines++;
+        }
+    }
+    sink_written += size;
+}
+
+static bool file_contains(const char *str) {
+    char buf[4096];
+    size_t len;
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL) {
+        return false;
+    }
+    len = fread(buf, 1, sizeof(buf) - 1, fp);
+    fclose(fp);
+    buf[len] = '\0';
+
+    return strstr(buf, str) != NULL;
+}
+
+int main(void) {
+    ElogFileCfg cfg = {path, 0, 0, ELOG_FILE_PERIOD_NONE, ELOG_FILE_SUFFIX_INDEX, 0, false};
+    uint64_t ticket0, ticket, ticket2;
+    int fd, i;
+
+    fd = mkstemp(path);
+    if (fd < 0) {
+        return 1;
+    }
+    close(fd);
+
+    elog_init();
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    elog_sink_init(&sink, "durable", sink_output);
+    elog_sink_set_async(&sink, sink_buf, sizeof(sink_buf), NULL);
+    elog_sink_register(&sink);
+    elog_file_config(&cfg);
+    /* the ticket covers the log which is queued in the test sink instead of the port's file sink */
+    elog_file_set_durable_sink(&sink);
+    elog_start();
+
+    /* the log before is written when the ticket is got */
+    ticket0 = elog_file_get_ticket();
+    sink_lines = 0;
+    sink_written = 0;
+    for (i = 0; i < LOG_NUM; i++) {
+        log_d("durable line %d", i);
+    }
+    ticket = elog_file_get_ticket();
+    /* all queued log has been written to file */
+    ELOG_TEST_CHECK(sink_lines == LOG_NUM);
+    ELOG_TEST_CHECK(ticket >= ticket0 + sink_written);
+    ELOG_TEST_CHECK(file_contains("durable line 19\n"));
+    /* the group commit syncs it */
+    ELOG_TEST_CHECK(elog_file_wait_durable(ticket, 1000));
+
+    /* the raw log is written directly */
+    ticket2 = elog_file_write_durable("raw durable\n", 12);
+    ELOG_TEST_CHECK(ticket2 >= ticket + 12);
+    ELOG_TEST_CHECK(elog_file_get_ticket() >= ticket2);
+    ELOG_TEST_CHECK(file_contains("raw durable\n"));
+    ELOG_TEST_CHECK(elog_file_wait_durable(ticket2, 1000));
+    /* the log which is never written times out */
+    ELOG_TEST_CHECK(!elog_file_wait_durable(ticket2 + 1024 * 1024, 50));
+
+    elog_file_set_durable_sink(NULL);
+    elog_sink_unregister(&sink);
+    elog_deinit();
+    unlink(path);
+
+    return ELOG_TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: JSON lines and logfmt encoders test. The rendered line is compared with the golden output.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <math.h>
+#include "elog_test.h"
+
+static ElogSink sink;
+
+static void sink_output(const char *log, size_t size) {
+    (void) log;
+    (void) size;
+}
+
+static void set_sink_fmt(size_t fmt) {
+    uint8_t level;
+
+    for (level = 0; level < ELOG_LVL_TOTAL_NUM; level++) {
+        elog_sink_set_fmt(&sink, level, fmt);
+    }
+}
+
+static void record_init(ElogRecord *rec, const char *msg, const ElogKv *kv, size_t kv_num) {
+    memset(rec, 0, sizeof(ElogRecord));
+    rec->level = ELOG_LVL_INFO;
+    rec->tag = "net";
+    rec->file = "src/net.c";
+    rec->func = "net_recv";
+    rec->line = 42;
+    rec->time = "10:00:00.000";
+    rec->p_info = "pid:1";
+    rec->t_info = "tid:2";
+    rec->msg = msg;
+    rec->msg_len = strlen(msg);
+    rec->kv = kv;
+    rec->kv_num = kv_num;
+}
+
+static void test_json(void) {
+    const ElogKv kv[] = {
+        ELOG_STR("path", "a\"b"),
+        ELOG_I64("n", -5),
+        ELOG_U64("u", 18446744073709551615ULL),
+        ELOG_F64("f", 0.1),
+        ELOG_F64("inf", INFINITY),
+        ELOG_BOOL("ok", true),
+    };
+    char log[256];
+    ElogRecord rec;
+    size_t len;
+
+    /* escaping */
+    set_sink_fmt(ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_LINE | ELOG_FMT_FUNC);
+    record_init(&rec, "say \"hi\"\\\n\t\x01 \xC3\xA9", kv, sizeof(kv) / sizeof(kv[0]));
+    len = elog_json_render(&sink, &rec, log, sizeof(log));
+    ELOG_TEST_CHECK_STRN(log, len, "{\"level\":\"info\",\"tag\":\"net\",\"line\":42,\"func\":\"net_recv\","
+            "\"msg\":\"say \\\"hi\\\"\\\\\\n\\t\\u0001 \xC3\xA9\",\"path\":\"a\\\"b\",\"n\":-5,"
+            "\"u\":18446744073709551615,\"f\":0.1,\"inf\":null,\"ok\":true}\n");
+
+    /* all format fields, the message is longer than one SIMD scanning */
+    set_sink_fmt(ELOG_FMT_ALL);
+    record_init(&rec, "0123456789abcdefghijklmnopqrstuvwxyz\"", NULL, 0);
+    len = elog_json_render(&sink, &rec, log, sizeof(log));
+    ELOG_TEST_CHECK_STRN(log, len, "{\"time\":\"10:00:00.000\",\"level\":\"info\",\"tag\":\"net\",\"process\":\"pid:1\","
+            "\"thread\":\"tid:2\",\"file\":\"src/net.c\",\"line\":42,\"func\":\"net_recv\","
+            "\"msg\":\"0123456789abcdefghijklmnopqrstuvwxyz\\\"\"}\n");
+
+    /* the message is truncated before the UTF-8 character which can't be written completely */
+    set_sink_fmt(ELOG_FMT_LVL | ELOG_FMT_TAG);
+    record_init(&rec, "ab\xC3\xA9", kv, 1);
+    len = elog_json_render(&sink, &rec, log, strlen("{\"level\":\"info\",\"tag\":\"net\",\"msg\":\"") + 3 + 3);
+    ELOG_TEST_CHECK_STRN(log, len, "{\"level\":\"info\",\"tag\":\"net\",\"msg\":\"ab\"}\n");
+
+    /* the escape sequence is never split */
+    record_init(&rec, "a\"b", NULL, 0);
+    len = elog_json_render(&sink, &rec, log, strlen("{\"level\":\"info\",\"tag\":\"net\",\"msg\":\"") + 2 + 3);
+    ELOG_TEST_CHECK_STRN(log, len, "{\"level\":\"info\",\"tag\":\"net\",\"msg\":\"a\"}\n");
+
+    /* the key/value pair which has no space is dropped as a whole */
+    record_init(&rec, "hi", kv + 1, 1);
+    len = elog_json_render(&sink, &rec, log, strlen("{\"level\":\"info\",\"tag\":\"net\",\"msg\":\"hi\",\"n\":-") + 2);
+    ELOG_TEST_CHECK_STRN(log, len, "{\"level\":\"info\",\"tag\":\"net\",\"msg\":\"hi\"}\n");
+
+    /* the buffer can't hold the line end */
+    ELOG_TEST_CHECK(elog_json_render(&sink, &rec, log, 2) == 0);
+}
+
+static void test_logfmt(void) {
+    const ElogKv kv[] = {
+        ELOG_STR("path", "a\"b"),
+        ELOG_STR("name", "a b"),
+        ELOG_STR("empty", ""),
+        ELOG_STR("plain", "x=1"),
+        ELOG_I64("n", -5),
+        ELOG_F64("f", 2.5),
+        ELOG_BOOL("ok", false),
+    };
+    char log[256];
+    ElogRecord rec;
+    size_t len;
+
+    /* quoting and escaping */
+    set_sink_fmt(ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_LINE);
+    record_init(&rec, "say \"hi\"\n", kv, sizeof(kv) / sizeof(kv[0]));
+    len = elog_logfmt_render(&sink, &rec, log, sizeof(log));
+    ELOG_TEST_CHECK_STRN(log, len, "time=\"10:00:00.000\" level=info tag=net line=42 msg=\"say \\\"hi\\\"\\n\" "
+            "path=\"a\\\"b\" name=\"a b\" empty=\"\" plain=\"x=1\" n=-5 f=2.5 ok=false\n");
+
+    /* the unquoted value is truncated directly */
+    set_sink_fmt(ELOG_FMT_LVL | ELOG_FMT_TAG);
+    record_init(&rec, "hi", NULL, 0);
+    rec.tag = "network";
+    len = elog_logfmt_render(&sink, &rec, log, strlen("level=info tag=net") + 1);
+    ELOG_TEST_CHECK_STRN(log, len, "level=info tag=net\n");
+
+    /* the quoted message is truncated and closed */
+    record_init(&rec, "hello world", NULL, 0);
+    len = elog_logfmt_render(&sink, &rec, log, strlen("level=info tag=net msg=\"hello\"") + 1);
+    ELOG_TEST_CHECK_STRN(log, len, "level=info tag=net msg=\"hello\"\n");
+
+    /* the number is never truncated, it's dropped */
+    record_init(&rec, "hi", kv + 4, 1);
+    len = elog_logfmt_render(&sink, &rec, log, strlen("level=info tag=net msg=\"hi\" n=-") + 1);
+    ELOG_TEST_CHECK_STRN(log, len, "level=info tag=net msg=\"hi\"\n");
+}
+
+int main(void) {
+    elog_init();
+    elog_sink_init(&sink, "test", sink_output);
+    elog_sink_register(&sink);
+
+    test_json();
+    test_logfmt();
+
+    elog_deinit();
+
+    return ELOG_TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Filter snapshot test. The reader always gets a consistent filter while the setter is
+ *           publishing the snapshots, and the setter isn't blocked by the output lock.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+#define SET_NUM       200000
+#define READER_NUM    2
+
+static volatile bool setting = true;
+static size_t inconsistent[READER_NUM];
+static volatile bool set_done = false;
+
+/* the filter is set in two states, every field is changed */
+static void *setter(void *arg) {
+    int i;
+
+    (void) arg;
+    for (i = 0; i < SET_NUM; i++) {
+        if (i & 1) {
+            elog_set_filter(ELOG_LVL_WARN, "bb", "k");
+        } else {
+            elog_set_filter(ELOG_LVL_VERBOSE, "aaaaaaaa", "kkkkkkkk");
+        }
+    }
+    setting = false;
+
+    return NULL;
+}
+
+static void *reader(void *arg) {
+    size_t *num = arg;
+    ElogFilter filter;
+
+    while (setting) {
+        elog_get_filter(&filter);
+        if (!(filter.level == ELOG_LVL_WARN && !strcmp(filter.tag, "bb") && !strcmp(filter.keyword, "k"))
+                && !(filter.level == ELOG_LVL_VERBOSE && !strcmp(filter.tag, "aaaaaaaa")
+                && !strcmp(filter.keyword, "kkkkkkkk"))) {
+            (*num)++;
+        }
+    }
+
+    return NULL;
+}
+
+static void test_consistent(void) {
+    pthread_t set_thread, read_thread[READER_NUM];
+    int i;
+
+    elog_set_filter(ELOG_LVL_WARN, "bb", "k");
+    for (i = 0; i < READER_NUM; i++) {
+        pthread_create(&read_thread[i], NULL, reader, &inconsistent[i]);
+    }
+    pthread_create(&set_thread, NULL, setter, NULL);
+    pthread_join(set_thread, NULL);
+    for (i = 0; i < READER_NUM; i++) {
+        pthread_join(read_thread[i], NULL);
+        ELOG_TEST_CHECK(inconsistent[i] == 0);
+    }
+}
+
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+static void *set_level(void *arg) {
+    (void) arg;
+    elog_set_filter_lvl(ELOG_LVL_INFO);
+    set_done = true;
+
+    return NULL;
+}
+
+static void test_not_blocked(void) {
+    extern void elog_output_lock(void);
+    extern void elog_output_unlock(void);
+    ElogFilter filter;
+    pthread_t thread;
+    int i;
+
+    /* the output lock is held by the thread which is outputting log */
+    elog_output_lock();
+    pthread_create(&thread, NULL, set_level, NULL);
+    for (i = 0; i < 100 && !set_done; i++) {
+        usleep(10 * 1000);
+    }
+    ELOG_TEST_CHECK(set_done);
+    elog_get_filter(&filter);
+    ELOG_TEST_CHECK(filter.level == ELOG_LVL_INFO);
+    elog_output_unlock();
+    pthread_join(thread, NULL);
+}
+#endif
+
+int main(void) {
+    elog_init();
+    elog_start();
+
+    test_consistent();
+#ifdef ELOG_FILTER_LOCK_USING_PTHREAD
+    test_not_blocked();
+#endif
+
+    elog_deinit();
+
+    return ELOG_TEST_RESULT();
+}
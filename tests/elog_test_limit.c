@@ -0,0 +1,164 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Rate limit and sampling test. The token bucket's burst, the colliding callsites, the
+ *           periodic suppressed log report and the sampling are checked.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+/* the distinct callsites are more than the callsite buckets */
+#define CALLSITE_NUM    (ELOG_RATE_LIMIT_CALLSITE_MAX_NUM * 3)
+
+static ElogSink sink;
+/* the summary may be output by the asynchronous output thread */
+static pthread_mutex_t sink_lock = PTHREAD_MUTEX_INITIALIZER;
+static char sink_log[4096];
+static size_t sink_len = 0;
+
+static void sink_output(const char *log, size_t size) {
+    pthread_mutex_lock(&sink_lock);
+    if (sink_len + size < sizeof(sink_log)) {
+        memcpy(sink_log + sink_len, log, size);
+        sink_len += size;
+        sink_log[sink_len] = '\0';
+    }
+    pthread_mutex_unlock(&sink_lock);
+}
+
+static void sink_clear(void) {
+    pthread_mutex_lock(&sink_lock);
+    sink_len = 0;
+    sink_log[0] = '\0';
+    pthread_mutex_unlock(&sink_lock);
+}
+
+/* count the output log which contains the string */
+static size_t sink_count(const char *str) {
+    const char *p;
+    size_t num = 0;
+
+    pthread_mutex_lock(&sink_lock);
+    for (p = sink_log; (p = strstr(p, str)) != NULL; p += strlen(str)) {
+        num++;
+    }
+    pthread_mutex_unlock(&sink_lock);
+
+    return num;
+}
+
+static void test_burst(void) {
+    int i;
+
+    sink_clear();
+    elog_set_rate_limit("burst", ELOG_LVL_WARN, 1, 3, false);
+    for (i = 0; i < 10; i++) {
+        elog_output(ELOG_LVL_WARN, "burst", __FILE__, __func__, __LINE__, "burst log %d", i);
+    }
+    ELOG_TEST_CHECK(sink_count("burst log") == 3);
+    /* the other tag and level aren't limited */
+    for (i = 0; i < 10; i++) {
+        elog_output(ELOG_LVL_ERROR, "burst", __FILE__, __func__, __LINE__, "error log %d", i);
+    }
+    ELOG_TEST_CHECK(sink_count("error log") == 10);
+    elog_set_rate_limit("burst", ELOG_LVL_WARN, 0, 0, false);
+}
+
+static void test_callsite(void) {
+    size_t first;
+    int i;
+
+    sink_clear();
+    elog_set_rate_limit("site", ELOG_LVL_INFO, 1, 1, true);
+    /* every callsite outputs one log at most, the colliding callsites never get a new burst */
+    for (i = 0; i < CALLSITE_NUM; i++) {
+        elog_output(ELOG_LVL_INFO, "site", __FILE__, __func__, i + 1, "site log %d", i);
+    }
+    first = sink_count("site log");
+    ELOG_TEST_CHECK(first >= 1 && first <= ELOG_RATE_LIMIT_CALLSITE_MAX_NUM + 1);
+    for (i = 0; i < CALLSITE_NUM; i++) {
+        elog_output(ELOG_LVL_INFO, "site", __FILE__, __func__, i + 1, "site log %d", i);
+    }
+    ELOG_TEST_CHECK(sink_count("site log") == first);
+    elog_set_rate_limit("site", ELOG_LVL_INFO, 0, 0, true);
+}
+
+static void test_report(void) {
+    int i;
+
+    sink_clear();
+    elog_set_rate_limit("report", ELOG_LVL_WARN, 1, 1, false);
+    for (i = 0; i < 5; i++) {
+        elog_output(ELOG_LVL_WARN, "report", __FILE__, __func__, __LINE__, "report log %d", i);
+    }
+    ELOG_TEST_CHECK(sink_count("report log") == 1);
+    /* it's reported after the report interval */
+    elog_rate_limit_poll();
+    ELOG_TEST_CHECK(sink_count("suppressed") == 0);
+
+    /* the same log never arrives again, the report is output by the output thread or poll */
+    usleep((ELOG_RATE_LIMIT_REPORT_INTERVAL + 200) * 1000);
+#if !defined(ELOG_ASYNC_OUTPUT_ENABLE) || !defined(ELOG_ASYNC_OUTPUT_USING_PTHREAD)
+    elog_rate_limit_poll();
+#endif
+    ELOG_TEST_CHECK(sink_count("suppressed 4 messages") == 1);
+    elog_set_rate_limit("report", ELOG_LVL_WARN, 0, 0, false);
+}
+
+static void test_sampling(void) {
+    int i;
+
+    sink_clear();
+    elog_set_sampling(ELOG_LVL_INFO, 4, false);
+    for (i = 0; i < 100; i++) {
+        elog_output(ELOG_LVL_INFO, "sample", __FILE__, __func__, __LINE__, "sample log %d", i);
+    }
+    ELOG_TEST_CHECK(sink_count("sample log") == 25);
+    elog_set_sampling(ELOG_LVL_INFO, 0, false);
+}
+
+int main(void) {
+    elog_init();
+    elog_set_fmt(ELOG_LVL_ERROR, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    elog_sink_init(&sink, "limit", sink_output);
+    elog_sink_register(&sink);
+    elog_start();
+
+    test_burst();
+    test_callsite();
+    test_sampling();
+    test_report();
+
+    elog_sink_unregister(&sink);
+    elog_deinit();
+
+    return ELOG_TEST_RESULT();
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Linux port file lock test. The lock segment which is left by a crashed creator is
+ *           initialized again, and the lock is changed to the runtime configured file's lock.
+ * Created on: 2026-10-19
+ */
+
+#include <elog_file.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+/* same as the Linux port */
+typedef struct {
+    volatile uint32_t magic;
+    pthread_mutex_t mutex;
+} FileLock;
+
+static char dir[] = "/tmp/elog_test_lock.XXXXXX";
+static char name[128];
+
+static void lock_path(char *path, size_t size) {
+    const char *p = name;
+    uint32_t hash = 2166136261U;
+
+    for (; *p; p++) {
+        hash = (hash ^ (uint8_t) *p) * 16777619U;
+    }
+    snprintf(path, size, "/dev/shm/elog_file_lock.%08x", hash);
+}
+
+/* the segment which is created by a crashed process before the mutex is initialized */
+static void make_stale_lock(size_t size) {
+    char path[64];
+    int fd;
+
+    lock_path(path, sizeof(path));
+    unlink(path);
+    fd = open(path, O_RDWR | O_CREAT, 0600);
+    if (fd >= 0) {
+        ELOG_TEST_CHECK(ftruncate(fd, size) == 0);
+        close(fd);
+    }
+}
+
+static FileLock *map_lock(void) {
+    char path[64];
+    FileLock *lock;
+    int fd;
+
+    lock_path(path, sizeof(path));
+    fd = open(path, O_RDWR);
+    if (fd < 0) {
+        return NULL;
+    }
+    lock = mmap(NULL, sizeof(FileLock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return lock == MAP_FAILED ? NULL : lock;
+}
+
+static void test_stale_lock(const char *base, size_t size) {
+    ElogFileCfg cfg = {name, 0, 0, ELOG_FILE_PERIOD_NONE, ELOG_FILE_SUFFIX_INDEX, 0, false};
+    FileLock *lock;
+    char path[64];
+
+    snprintf(name, sizeof(name), "%s/%s", dir, base);
+    make_stale_lock(size);
+
+    ELOG_TEST_CHECK(elog_file_init() == ELOG_NO_ERR);
+    ELOG_TEST_CHECK(elog_file_config(&cfg) == ELOG_NO_ERR);
+
+    lock = map_lock();
+    ELOG_TEST_CHECK(lock != NULL);
+    if (lock) {
+        ELOG_TEST_CHECK(lock->magic != 0);
+        /* the file plugin is using the runtime file's lock */
+        elog_file_port_lock();
+        ELOG_TEST_CHECK(pthread_mutex_trylock(&lock->mutex) == EBUSY);
+        elog_file_port_unlock();
+        ELOG_TEST_CHECK(pthread_mutex_trylock(&lock->mutex) == 0);
+        pthread_mutex_unlock(&lock->mutex);
+        munmap(lock, sizeof(FileLock));
+    }
+
+    elog_file_write("lock\n", 5);
+    elog_file_deinit();
+
+    lock_path(path, sizeof(path));
+    unlink(path);
+    unlink(name);
+}
+
+int main(void) {
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+
+    /* the creator is crashed before the segment is truncated */
+    test_stale_lock("empty.log", 0);
+    /* the creator is crashed before the mutex is initialized */
+    test_stale_lock("zero.log", sizeof(FileLock));
+
+    rmdir(dir);
+
+    return ELOG_TEST_RESULT();
+}
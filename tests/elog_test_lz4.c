@@ -0,0 +1,297 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Built-in LZ4 frame compressor and compressed log stream test. The frame is decompressed by
+ *           a reference decoder which follows the LZ4 block and frame format, and it must be same as the
+ *           source data.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <elog_file.h>
+#include "elog_test.h"
+
+#define LZ4_FRAME_MAGIC                0x184D2204UL
+#define LZ4_BLOCK_RAW_FLAG             0x80000000UL
+/* the last 5 bytes are always literals */
+#define LZ4_LAST_LITERALS              5
+#define DECODE_ERROR                   ((size_t) -1)
+
+static uint32_t read_u32(const uint8_t *p) {
+    return p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+/**
+ * read the extended length after token
+ */
+static bool read_length(const uint8_t **ip, const uint8_t *iend, size_t *len) {
+    uint8_t byte;
+
+    if (*len != 15) {
+        return true;
+    }
+    do {
+        if (*ip >= iend) {
+            return false;
+        }
+        byte = *(*ip)++;
+        *len += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+/**
+ * Decode one LZ4 block, the last match must end 5 bytes before the block end at least.
+ *
+ * @return decoded size, DECODE_ERROR: the block is broken
+ */
+static size_t lz4_block_decode(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size) {
+    const uint8_t *ip = src, *iend = src + size;
+    uint8_t *op = dst, *oend = dst + dst_size, *match_end = dst;
+    size_t literal_len, match_len, offset;
+    uint8_t token;
+
+    while (ip < iend) {
+        token = *ip++;
+        literal_len = token >> 4;
+        if (!read_length(&ip, iend, &literal_len) || literal_len > (size_t) (iend - ip)
+                || literal_len > (size_t) (oend - op)) {
+            return DECODE_ERROR;
+        }
+        memcpy(op, ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+        /* the last sequence has literals only */
+        if (ip == iend) {
+            break;
+        }
+        if (iend - ip < 2) {
+            return DECODE_ERROR;
+        }
+        offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        match_len = token & 0x0F;
+        if (offset == 0 || offset > (size_t) (op - dst) || !read_length(&ip, iend, &match_len)) {
+            return DECODE_ERROR;
+        }
+        match_len += 4;
+        if (match_len > (size_t) (oend - op)) {
+            return DECODE_ERROR;
+        }
+        /* the match may overlap the output */
+        for (; match_len; match_len--, op++) {
+            *op = *(op - offset);
+        }
+        match_end = op;
+    }
+    if (match_end != dst && op - match_end < LZ4_LAST_LITERALS) {
+        return DECODE_ERROR;
+    }
+
+    return op - dst;
+}
+
+/**
+ * decode the LZ4 frame which has independent blocks and no checksum
+ *
+ * @return decoded size, DECODE_ERROR: the frame is broken
+ */
+static size_t lz4_frame_decode(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size) {
+    const uint8_t *ip = src, *iend = src + size;
+    size_t out = 0, block_size, decoded;
+    uint32_t block;
+
+    if (size < ELOG_LZ4_FRAME_HEADER_SIZE || read_u32(ip) != LZ4_FRAME_MAGIC) {
+        return DECODE_ERROR;
+    }
+    ip += ELOG_LZ4_FRAME_HEADER_SIZE;
+    while (true) {
+        if (iend - ip < 4) {
+            return DECODE_ERROR;
+        }
+        block = read_u32(ip);
+        ip += 4;
+        if (block == 0) {
+            break;
+        }
+        block_size = block & ~LZ4_BLOCK_RAW_FLAG;
+        if (block_size > (size_t) (iend - ip) || block_size > ELOG_LZ4_BLOCK_SIZE) {
+            return DECODE_ERROR;
+        }
+        if (block & LZ4_BLOCK_RAW_FLAG) {
+            if (block_size > dst_size - out) {
+                return DECODE_ERROR;
+            }
+            memcpy(dst + out, ip, block_size);
+            decoded = block_size;
+        } else if ((decoded = lz4_block_decode(ip, block_size, dst + out, dst_size - out)) == DECODE_ERROR) {
+            return DECODE_ERROR;
+        }
+        ip += block_size;
+        out += decoded;
+    }
+
+    return ip == iend ? out : DECODE_ERROR;
+}
+
+/**
+ * compress the data to LZ4 frame by 64KB blocks, then decompress it
+ *
+ * @return true: the decompressed data is same as the source
+ */
+static bool frame_round_trip(const uint8_t *src, size_t size, size_t *frame_size) {
+    size_t max = ELOG_LZ4_FRAME_HEADER_SIZE + ELOG_LZ4_FRAME_END_SIZE
+            + (size / ELOG_LZ4_BLOCK_SIZE + 1) * ELOG_LZ4_BLOCK_BOUND(ELOG_LZ4_BLOCK_SIZE);
+    uint8_t *frame = malloc(max), *out = malloc(size + 1);
+    size_t len, pos, block, decoded;
+    bool result;
+
+    len = elog_lz4_frame_header(frame);
+    for (pos = 0; pos < size; pos += block) {
+        block = size - pos < ELOG_LZ4_BLOCK_SIZE ? size - pos : ELOG_LZ4_BLOCK_SIZE;
+        len += elog_lz4_frame_block(src + pos, block, frame + len);
+    }
+    len += elog_lz4_frame_end(frame + len);
+    decoded = lz4_frame_decode(frame, len, out, size + 1);
+    result = decoded == size && !memcmp(out, src, size);
+    if (frame_size) {
+        *frame_size = len;
+    }
+    free(frame);
+    free(out);
+
+    return result;
+}
+
+static void test_frame_header(void) {
+    /* the header checksum is the second byte of xxh32 on FLG and BD */
+    const uint8_t expected[] = { 0x04, 0x22, 0x4D, 0x18, 0x60, 0x40, 0x82 };
+    uint8_t header[ELOG_LZ4_FRAME_HEADER_SIZE], end[ELOG_LZ4_FRAME_END_SIZE];
+
+    ELOG_TEST_CHECK(elog_lz4_frame_header(header) == sizeof(expected));
+    ELOG_TEST_CHECK(!memcmp(header, expected, sizeof(expected)));
+    ELOG_TEST_CHECK(elog_lz4_frame_end(end) == 4);
+    ELOG_TEST_CHECK(read_u32(end) == 0);
+}
+
+static void test_round_trip(void) {
+    size_t size = 3 * ELOG_LZ4_BLOCK_SIZE + 1000, pos, i, frame_size;
+    uint8_t *data = malloc(size), block[ELOG_LZ4_BLOCK_BOUND(ELOG_LZ4_BLOCK_SIZE + 1)];
+    uint32_t seed = 1;
+    int len;
+
+    /* the log text is compressible */
+    for (pos = 0, i = 0; pos < size; pos += len, i++) {
+        len = snprintf((char *) data + pos, size - pos, "I/net [10:00:%02lu] packet %lu received, len: %lu\n",
+                (unsigned long) (i % 60), (unsigned long) i, (unsigned long) (i * 7 % 1500));
+        if (len < 0 || (size_t) len >= size - pos) {
+            memset(data + pos, 'x', size - pos);
+            break;
+        }
+    }
+    ELOG_TEST_CHECK(frame_round_trip(data, size, &frame_size));
+    ELOG_TEST_CHECK(frame_size < size / 2);
+
+    /* the random data is stored uncompressed */
+    for (i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t) (seed >> 16);
+    }
+    ELOG_TEST_CHECK(frame_round_trip(data, size, &frame_size));
+    ELOG_TEST_CHECK(frame_size <= size + ELOG_LZ4_FRAME_HEADER_SIZE + ELOG_LZ4_FRAME_END_SIZE + 4 * 4);
+
+    /* the short data and the long run are around the limits of match finding */
+    memset(data, 'a', ELOG_LZ4_BLOCK_SIZE);
+    for (i = 1; i <= 32; i++) {
+        ELOG_TEST_CHECK(frame_round_trip(data, i, NULL));
+    }
+    ELOG_TEST_CHECK(frame_round_trip(data, ELOG_LZ4_BLOCK_SIZE, &frame_size));
+    ELOG_TEST_CHECK(frame_size < 1024);
+
+    /* the empty and oversize block is rejected */
+    ELOG_TEST_CHECK(elog_lz4_frame_block(data, 0, block) == 0);
+    ELOG_TEST_CHECK(elog_lz4_frame_block(data, ELOG_LZ4_BLOCK_SIZE + 1, block) == 0);
+    ELOG_TEST_CHECK(elog_lz4_compress(data, ELOG_LZ4_BLOCK_SIZE, block, 4) == 0);
+
+    free(data);
+}
+
+static void test_stream_file(void) {
+    char path[] = "/tmp/elog_test_lz4.XXXXXX";
+    ElogFileCfg cfg = {path, 0, 0, ELOG_FILE_PERIOD_NONE, ELOG_FILE_SUFFIX_INDEX, 0, true};
+    size_t size = 2 * ELOG_LZ4_BLOCK_SIZE + 1000, pos = 0, file_size, max;
+    char *data = malloc(size), line[64];
+    uint8_t *frame, *out;
+    FILE *fp;
+    int fd, len, i;
+
+    if ((fd = mkstemp(path)) < 0) {
+        ELOG_TEST_CHECK(fd >= 0);
+        free(data);
+        return;
+    }
+    close(fd);
+
+    /* the log is written by the file plugin as one LZ4 frame, it's ended when the file is closed */
+    elog_file_init();
+    elog_file_config(&cfg);
+    for (i = 0; pos < size; i++) {
+        len = snprintf(line, sizeof(line), "I/net [10:00:%02d] packet %d received\n", i % 60, i);
+        if ((size_t) len > size - pos) {
+            len = (int) (size - pos);
+        }
+        memcpy(data + pos, line, len);
+        elog_file_write(line, len);
+        pos += len;
+    }
+    elog_file_deinit();
+
+    max = ELOG_LZ4_FRAME_HEADER_SIZE + ELOG_LZ4_FRAME_END_SIZE + 4 * ELOG_LZ4_BLOCK_BOUND(ELOG_LZ4_BLOCK_SIZE);
+    frame = malloc(max);
+    out = malloc(size + 1);
+    file_size = 0;
+    if ((fp = fopen(path, "rb")) != NULL) {
+        file_size = fread(frame, 1, max, fp);
+        fclose(fp);
+    }
+    ELOG_TEST_CHECK(file_size > 0 && file_size < size / 2);
+    ELOG_TEST_CHECK(lz4_frame_decode(frame, file_size, out, size + 1) == size);
+    ELOG_TEST_CHECK(!memcmp(out, data, size));
+
+    unlink(path);
+    free(frame);
+    free(out);
+    free(data);
+}
+
+int main(void) {
+    test_frame_header();
+    test_round_trip();
+    test_stream_file();
+
+    return ELOG_TEST_RESULT();
+}
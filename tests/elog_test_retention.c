@@ -0,0 +1,230 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: File plugin rotated file suffix and retention test. The files are checked after the file
+ *           plugin is deinitialized, the background rotation and retention are finished before it returns.
+ * Created on: 2026-10-19
+ */
+
+#include <elog_file.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+/* every line is 60 bytes, the file is rotated after every 2 lines when the max size is 100 */
+#define LINE_SIZE  60
+
+static char dir[] = "/tmp/elog_test_retention.XXXXXX";
+static char name[128];
+
+static void start(const char *base, size_t max_size, int max_rotate, ElogFileSuffix suffix, size_t max_total_size) {
+    ElogFileCfg cfg = {name, max_size, max_rotate, ELOG_FILE_PERIOD_NONE, suffix, max_total_size, false};
+
+    snprintf(name, sizeof(name), "%s/%s", dir, base);
+    elog_file_init();
+    elog_file_config(&cfg);
+}
+
+static void write_lines(int first, int num) {
+    char line[LINE_SIZE + 1];
+    int i;
+
+    for (i = first; i < first + num; i++) {
+        memset(line, '-', LINE_SIZE - 1);
+        memcpy(line, "line ", 5);
+        line[5] = '0' + i / 10;
+        line[6] = '0' + i % 10;
+        line[LINE_SIZE - 1] = '\n';
+        elog_file_write(line, LINE_SIZE);
+    }
+}
+
+/* read the file which is named by name and suffix, it's empty when the file isn't exist */
+static size_t read_file(const char *suffix, char *buf, size_t size) {
+    char path[192];
+    size_t len = 0;
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "%s%s", name, suffix);
+    if ((fp = fopen(path, "r")) != NULL) {
+        len = fread(buf, 1, size - 1, fp);
+        fclose(fp);
+    }
+    buf[len] = '\0';
+
+    return len;
+}
+
+#define CHECK_FILE(suffix, first_line, lines)                                             \
+    do {                                                                                  \
+        char buf_[1024];                                                                  \
+        size_t len_ = read_file(suffix, buf_, sizeof(buf_));                              \
+        ELOG_TEST_CHECK(len_ == (size_t) (lines) * LINE_SIZE);                            \
+        ELOG_TEST_CHECK(!strncmp(buf_, first_line, strlen(first_line)));                  \
+    } while (0)
+
+static bool file_exists(const char *suffix) {
+    char path[192];
+
+    snprintf(path, sizeof(path), "%s%s", name, suffix);
+
+    return access(path, F_OK) == 0;
+}
+
+static size_t count_files(const char *pattern) {
+    struct dirent *ent;
+    size_t num = 0;
+    DIR *d = opendir(dir);
+
+    while (d && (ent = readdir(d)) != NULL) {
+        if (strstr(ent->d_name, pattern)) {
+            num++;
+        }
+    }
+    if (d) {
+        closedir(d);
+    }
+
+    return num;
+}
+
+static void remove_all(void) {
+    char path[512];
+    struct dirent *ent;
+    DIR *d = opendir(dir);
+
+    while (d && (ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] != '.') {
+            snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+            remove(path);
+        }
+    }
+    if (d) {
+        closedir(d);
+    }
+}
+
+/* the time suffix is "YYYYmmdd-HHMMSS", and "-n" is appended when it's rotated more than once in one second */
+static bool is_time_suffix(const char *suffix) {
+    int i;
+
+    for (i = 0; i < 15; i++) {
+        if (i == 8 ? suffix[i] != '-' : !isdigit((unsigned char) suffix[i])) {
+            return false;
+        }
+    }
+    if (suffix[15] == '\0') {
+        return true;
+    }
+    if (suffix[15] != '-' || !isdigit((unsigned char) suffix[16])) {
+        return false;
+    }
+    for (i = 16; isdigit((unsigned char) suffix[i]); i++);
+
+    return suffix[i] == '\0';
+}
+
+static void test_seq_suffix(void) {
+    start("seq.log", 100, 2, ELOG_FILE_SUFFIX_SEQ, 0);
+    /* the files 0 to 4 are opened, only 2 rotated files are kept */
+    write_lines(1, 10);
+    elog_file_deinit();
+
+    ELOG_TEST_CHECK(count_files("seq.log.") == 3);
+    ELOG_TEST_CHECK(!file_exists(".0000000000"));
+    ELOG_TEST_CHECK(!file_exists(".0000000001"));
+    CHECK_FILE(".0000000002", "line 05", 2);
+    CHECK_FILE(".0000000003", "line 07", 2);
+    CHECK_FILE(".0000000004", "line 09", 2);
+    ELOG_TEST_CHECK(!file_exists(""));
+
+    /* the sequence is still increasing after restart */
+    start("seq.log", 100, 2, ELOG_FILE_SUFFIX_SEQ, 0);
+    write_lines(20, 1);
+    elog_file_deinit();
+    CHECK_FILE(".0000000005", "line 20", 1);
+}
+
+static void test_time_suffix(void) {
+    struct dirent *ent;
+    size_t num = 0;
+    DIR *d;
+
+    start("time.log", 0, 5, ELOG_FILE_SUFFIX_TIME, 0);
+    write_lines(1, 1);
+    ELOG_TEST_CHECK(elog_file_rotate());
+    write_lines(2, 1);
+    ELOG_TEST_CHECK(elog_file_rotate());
+    write_lines(3, 1);
+    elog_file_deinit();
+
+    /* every file is a new file named by its open time */
+    d = opendir(dir);
+    while (d && (ent = readdir(d)) != NULL) {
+        if (strncmp(ent->d_name, "time.log.", 9)) {
+            continue;
+        }
+        ELOG_TEST_CHECK(is_time_suffix(ent->d_name + 9));
+        num++;
+    }
+    if (d) {
+        closedir(d);
+    }
+    ELOG_TEST_CHECK(num == 3);
+    ELOG_TEST_CHECK(!file_exists(""));
+}
+
+static void test_total_size(void) {
+    char buf[1024];
+    size_t total;
+
+    start("total.log", 100, 10, ELOG_FILE_SUFFIX_INDEX, 250);
+    write_lines(1, 10);
+    elog_file_deinit();
+
+    /* the oldest files are deleted until the total size is not more than the max total size */
+    CHECK_FILE(".0", "line 07", 2);
+    ELOG_TEST_CHECK(!file_exists(".2"));
+    ELOG_TEST_CHECK(!file_exists(".3"));
+    /* the retention may run before the opening file is written */
+    total = read_file(".0", buf, sizeof(buf)) + read_file(".1", buf, sizeof(buf));
+    ELOG_TEST_CHECK(total <= 250);
+}
+
+int main(void) {
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+
+    test_seq_suffix();
+    test_time_suffix();
+    test_total_size();
+
+    remove_all();
+    rmdir(dir);
+
+    return ELOG_TEST_RESULT();
+}
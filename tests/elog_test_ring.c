@@ -0,0 +1,162 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: File plugin shared ring test. The log which is put to ring is drained by the writer in
+ *           order, and the ring segment which is left by a crashed creator or created with other size
+ *           is initialized again.
+ * Created on: 2026-10-19
+ */
+
+#include <elog_file.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+#define LOG_NUM    100
+
+static char dir[] = "/tmp/elog_test_ring.XXXXXX";
+static char name[128];
+static char ring_path[64];
+/* it's written by ring writer thread, and read after the ring is deinitialized */
+static char drained[4096];
+static size_t drained_len = 0;
+
+static bool ring_output(const char *log, size_t size) {
+    if (drained_len + size <= sizeof(drained)) {
+        memcpy(drained + drained_len, log, size);
+        drained_len += size;
+    }
+
+    return true;
+}
+
+static void set_name(const char *base) {
+    const char *p;
+    uint32_t hash = 2166136261U;
+
+    snprintf(name, sizeof(name), "%s/%s", dir, base);
+    for (p = name; *p; p++) {
+        hash = (hash ^ (uint8_t) *p) * 16777619U;
+    }
+    snprintf(ring_path, sizeof(ring_path), "/dev/shm/elog_file_ring.%08x", hash);
+    unlink(ring_path);
+}
+
+/* the header is left by the other process, the magic, ready flag and ring size are at the beginning */
+static void make_ring(size_t file_size, uint32_t ready, uint64_t ring_size) {
+    uint32_t id[4] = { 0x324E5252UL, ready, 0, 0 };
+    int fd = open(ring_path, O_RDWR | O_CREAT, 0600);
+
+    memcpy(&id[2], &ring_size, sizeof(ring_size));
+    if (fd >= 0) {
+        ELOG_TEST_CHECK(ftruncate(fd, file_size) == 0);
+        if (file_size >= sizeof(id)) {
+            ELOG_TEST_CHECK(pwrite(fd, id, sizeof(id), 0) == sizeof(id));
+        }
+        close(fd);
+    }
+}
+
+/* put the log to ring, all log is drained before the ring is deinitialized */
+static void check_put_drain(void) {
+    char expected[4096], line[32];
+    size_t len = 0;
+    int i, n;
+
+    drained_len = 0;
+    ELOG_TEST_CHECK(elog_file_ring_init(name, ring_output));
+    for (i = 0; i < LOG_NUM; i++) {
+        n = snprintf(line, sizeof(line), "ring line %d\n", i);
+        ELOG_TEST_CHECK(elog_file_ring_put(line, n));
+        memcpy(expected + len, line, n);
+        len += n;
+    }
+    elog_file_ring_deinit();
+    expected[len] = '\0';
+
+    ELOG_TEST_CHECK_STRN(drained, drained_len, expected);
+}
+
+static mode_t ring_mode(void) {
+    struct stat st;
+
+    return stat(ring_path, &st) == 0 ? st.st_mode & 0777 : 0;
+}
+
+static void test_mode(void) {
+    int fd;
+
+    /* the ring isn't accessed by other users */
+    set_name("new.log");
+    check_put_drain();
+    ELOG_TEST_CHECK(ring_mode() == 0600);
+    unlink(ring_path);
+
+    /* the ring can be accessed by the users who can access the log file */
+    set_name("exist.log");
+    fd = open(name, O_RDWR | O_CREAT, 0600);
+    if (fd >= 0) {
+        fchmod(fd, 0640);
+        close(fd);
+    }
+    check_put_drain();
+    ELOG_TEST_CHECK(ring_mode() == 0640);
+    unlink(ring_path);
+    unlink(name);
+}
+
+static void test_stale(void) {
+    set_name("stale.log");
+
+    /* the creator is crashed before it's truncated */
+    make_ring(0, 0, 0);
+    check_put_drain();
+
+    /* the creator is crashed before it's initialized */
+    make_ring(64 * 1024, 0, ELOG_FILE_SHARED_RING_SIZE);
+    check_put_drain();
+
+    /* it's created with other size by other version */
+    unlink(ring_path);
+    make_ring(64 * 1024, 1, 32 * 1024);
+    check_put_drain();
+
+    unlink(ring_path);
+}
+
+int main(void) {
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+
+    test_mode();
+    test_stale();
+
+    rmdir(dir);
+
+    return ELOG_TEST_RESULT();
+}
@@ -0,0 +1,184 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: File plugin size based rotation test. The generations are checked after the file plugin
+ *           is deinitialized, the background rotation is finished before it returns.
+ * Created on: 2026-10-19
+ */
+
+#include <elog_file.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "elog_test.h"
+
+/* every line is 60 bytes, the file is rotated after every 2 lines when the max size is 100 */
+#define LINE_SIZE  60
+
+static char dir[] = "/tmp/elog_test_rotate.XXXXXX";
+static char name[128];
+
+static void start(const char *base, size_t max_size, int max_rotate) {
+    ElogFileCfg cfg = {name, max_size, max_rotate, ELOG_FILE_PERIOD_NONE, ELOG_FILE_SUFFIX_INDEX, 0, false};
+
+    snprintf(name, sizeof(name), "%s/%s", dir, base);
+    elog_file_init();
+    elog_file_config(&cfg);
+}
+
+static void write_lines(int first, int num) {
+    char line[LINE_SIZE + 1];
+    int i;
+
+    for (i = first; i < first + num; i++) {
+        memset(line, '-', LINE_SIZE - 1);
+        memcpy(line, "line ", 5);
+        line[5] = '0' + i / 10;
+        line[6] = '0' + i % 10;
+        line[LINE_SIZE - 1] = '\n';
+        elog_file_write(line, LINE_SIZE);
+    }
+}
+
+/* read the file which is named by name and suffix, it's empty when the file isn't exist */
+static size_t read_file(const char *suffix, char *buf, size_t size) {
+    char path[192];
+    size_t len = 0;
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "%s%s", name, suffix);
+    if ((fp = fopen(path, "r")) != NULL) {
+        len = fread(buf, 1, size - 1, fp);
+        fclose(fp);
+    }
+    buf[len] = '\0';
+
+    return len;
+}
+
+#define CHECK_FILE(suffix, first_line, lines)                                             \
+    do {                                                                                  \
+        char buf_[1024];                                                                  \
+        size_t len_ = read_file(suffix, buf_, sizeof(buf_));                              \
+        ELOG_TEST_CHECK(len_ == (size_t) (lines) * LINE_SIZE);                            \
+        ELOG_TEST_CHECK(!strncmp(buf_, first_line, strlen(first_line)));                  \
+    } while (0)
+
+static bool file_exists(const char *suffix) {
+    char path[192];
+
+    snprintf(path, sizeof(path), "%s%s", name, suffix);
+
+    return access(path, F_OK) == 0;
+}
+
+static size_t count_files(const char *pattern) {
+    struct dirent *ent;
+    size_t num = 0;
+    DIR *d = opendir(dir);
+
+    while (d && (ent = readdir(d)) != NULL) {
+        if (strstr(ent->d_name, pattern)) {
+            num++;
+        }
+    }
+    if (d) {
+        closedir(d);
+    }
+
+    return num;
+}
+
+static void remove_all(void) {
+    char path[512];
+    struct dirent *ent;
+    DIR *d = opendir(dir);
+
+    while (d && (ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] != '.') {
+            snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+            remove(path);
+        }
+    }
+    if (d) {
+        closedir(d);
+    }
+}
+
+static void test_size_rotate(void) {
+    start("size.log", 100, 3);
+    /* it's rotated before the 3rd, 5th, 7th and 9th line */
+    write_lines(1, 10);
+    elog_file_deinit();
+
+    CHECK_FILE("", "line 09", 2);
+    CHECK_FILE(".0", "line 07", 2);
+    CHECK_FILE(".1", "line 05", 2);
+    CHECK_FILE(".2", "line 03", 2);
+    /* the oldest generation is replaced */
+    ELOG_TEST_CHECK(!file_exists(".3"));
+    /* the pending files are all renamed by the worker */
+    ELOG_TEST_CHECK(count_files(".pending.") == 0);
+}
+
+static void test_manual_rotate(void) {
+#ifndef ELOG_FILE_SHARED_RING_ENABLE
+    /* the log in shared ring may be written after the manual rotation */
+    start("manual.log", 0, 2);
+    write_lines(1, 1);
+    ELOG_TEST_CHECK(elog_file_rotate());
+    write_lines(2, 1);
+    ELOG_TEST_CHECK(elog_file_rotate());
+    write_lines(3, 1);
+    elog_file_deinit();
+
+    CHECK_FILE("", "line 03", 1);
+    CHECK_FILE(".0", "line 02", 1);
+    CHECK_FILE(".1", "line 01", 1);
+    ELOG_TEST_CHECK(!file_exists(".2"));
+#endif
+
+    /* the index suffix file can't be rotated without rotate file */
+    start("none.log", 100, 0);
+    ELOG_TEST_CHECK(!elog_file_rotate());
+    /* the log is dropped after the file is full */
+    write_lines(1, 4);
+    elog_file_deinit();
+    CHECK_FILE("", "line 01", 2);
+    ELOG_TEST_CHECK(!file_exists(".0"));
+}
+
+int main(void) {
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+
+    test_size_rotate();
+    test_manual_rotate();
+
+    remove_all();
+    rmdir(dir);
+
+    return ELOG_TEST_RESULT();
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Extract the unflushed log from black box shared memory file or core dump file.
+ * Created on: 2026-10-19
+ */
+
+#include <elog.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s file\n"
+            "  file  black box shared memory file which is named by program, such as %s.<program>,\n"
+            "        or core dump file\n"
+            "  The black box is only in core dump file when the file-backed shared mapping is dumped,\n"
+            "  such as `echo 0x3b > /proc/<pid>/coredump_filter`.\n", name, ELOG_BLACKBOX_PATH);
+}
+
+static void extract_output(const char *log, size_t size) {
+    fwrite(log, 1, size, stdout);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path;
+    struct stat st;
+    void *image;
+    size_t size;
+    int fd;
+
+    if (argc != 2 || argv[1][0] == '-') {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    path = argv[1];
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    if (st.st_size == 0) {
+        fprintf(stderr, "%s: no black box found\n", path);
+        return EXIT_FAILURE;
+    }
+    image = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    size = elog_blackbox_extract(image, st.st_size, extract_output);
+    fprintf(stderr, "%s: %zu bytes unflushed log\n", path, size);
+    munmap(image, st.st_size);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2026, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Local control client for the control server on Unix domain socket.
+ * Created on: 2026-10-19
+ */
+
+#include <elog_cfg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-s socket] <command> [args...]\n"
+            "  -s  control server socket path, default is %s\n"
+            "  The command 'help' will show all commands which are supported by the server.\n",
+            name, ELOG_CTL_PATH);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = ELOG_CTL_PATH;
+    struct sockaddr_un addr;
+    char line[256], buf[4096], *status;
+    size_t len = 0, used = 0;
+    ssize_t result;
+    int opt, fd, i;
+
+    while ((opt = getopt(argc, argv, "s:h")) != -1) {
+        switch (opt) {
+        case 's': path = optarg; break;
+        default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (optind >= argc || strlen(path) >= sizeof(addr.sun_path)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    /* the command and its arguments are sent in one line */
+    for (i = optind; i < argc; i++) {
+        result = snprintf(line + len, sizeof(line) - len, "%s%s", i > optind ? " " : "", argv[i]);
+        if (result < 0 || (size_t) result >= sizeof(line) - len - 1) {
+            fprintf(stderr, "command is too long\n");
+            return EXIT_FAILURE;
+        }
+        len += result;
+    }
+    line[len++] = '\n';
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (const struct sockaddr *) &addr, sizeof(addr)) < 0) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    if (write(fd, line, len) != (ssize_t) len) {
+        perror(path);
+        close(fd);
+        return EXIT_FAILURE;
+    }
+
+    /* the last line is the status line, the output before it is printed as it is */
+    while ((result = read(fd, buf + used, sizeof(buf) - used)) > 0) {
+        used += result;
+        if (used == sizeof(buf)) {
+            /* keep the last line, it may be the status line */
+            for (len = used - 1; len > 0 && buf[len - 1] != '\n'; len--);
+            len = len ? len : used;
+            fwrite(buf, 1, len, stdout);
+            memmove(buf, buf + len, used - len);
+            used -= len;
+        }
+    }
+    close(fd);
+
+    if (used == 0 || buf[used - 1] != '\n') {
+        fprintf(stderr, "%s: connection is closed\n", path);
+        return EXIT_FAILURE;
+    }
+    buf[used - 1] = '\0';
+    status = strrchr(buf, '\n');
+    status = status ? status + 1 : buf;
+    fwrite(buf, 1, status - buf, stdout);
+
+    return strcmp(status, "ok") ? EXIT_FAILURE : EXIT_SUCCESS;
+}